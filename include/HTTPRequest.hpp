@@ -15,9 +15,59 @@
 #include "IURLRequest.hpp"
 #include <atomic>
 #include <functional>
+#include <future>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
 #include <unordered_set>
+#include <vector>
+
+/**
+ * @brief This class is a request whose handle is configured once (URL, headers, TLS, timeouts) and then performed
+ * many times, changing only the body or the query. The handle is owned by the request and keeps its options between
+ * executions, so they aren't set again on each one.
+ *
+ * A prepared request can be moved between threads, but must not be executed concurrently. It doesn't go through the
+ * response, redirect and download caches, and it's interrupted through the 'shouldRun' flag it was prepared with.
+ */
+class PreparedRequest final
+{
+public:
+    ~PreparedRequest();
+    PreparedRequest(PreparedRequest&& other) noexcept;
+    PreparedRequest& operator=(PreparedRequest&& other) noexcept;
+
+    /**
+     * @brief Performs the request with the prepared body and URL.
+     *
+     * @param postRequestParameters Parameters that define the behavior after the request is made. The output file
+     * isn't supported, the response is given to 'onSuccess'.
+     */
+    void execute(const PostRequestParameters& postRequestParameters = {});
+
+    /**
+     * @brief Performs the request with another body.
+     *
+     * @param data Body of the request. Ignored by the methods without body.
+     * @param postRequestParameters Parameters that define the behavior after the request is made.
+     */
+    void execute(const std::string& data, const PostRequestParameters& postRequestParameters = {});
+
+    /**
+     * @brief Performs the request appending a query to the prepared URL.
+     *
+     * @param query Query parameters.
+     * @param postRequestParameters Parameters that define the behavior after the request is made.
+     */
+    void execute(const QueryBuilder& query, const PostRequestParameters& postRequestParameters = {});
+
+private:
+    friend class HTTPRequest;
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+
+    explicit PreparedRequest(std::unique_ptr<Impl> impl);
+};
 
 /**
  * @brief This class is an implementation of IURLRequest.
@@ -100,6 +150,130 @@ public:
     void delete_(RequestParameters requestParameters,
                  PostRequestParameters postRequestParameters = {},
                  ConfigurationParameters configurationParameters = {});
+
+    /**
+     * @brief Prepares a HTTP GET request to be performed many times.
+     *
+     * @param requestParameters Parameters to be used in the request. Mandatory.
+     * @param shouldRun Flag that interrupts the executions with the MULTI and SHARED_MULTI handler types. The handle of
+     * the prepared request stays bound to it, so it must outlive the request; the one of 'configurationParameters' is
+     * ignored.
+     * @param configurationParameters Parameters to configure the behavior of the request.
+     * @return PreparedRequest Prepared request.
+     */
+    PreparedRequest prepareGet(RequestParameters requestParameters,
+                               const std::atomic<bool>& shouldRun,
+                               ConfigurationParameters configurationParameters = {});
+
+    /**
+     * @brief Prepares a HTTP POST request to be performed many times. The data of the request parameters is the
+     * default body.
+     *
+     * @param requestParameters Parameters to be used in the request. Mandatory.
+     * @param shouldRun Flag that interrupts the executions with the MULTI and SHARED_MULTI handler types. The handle of
+     * the prepared request stays bound to it, so it must outlive the request; the one of 'configurationParameters' is
+     * ignored.
+     * @param configurationParameters Parameters to configure the behavior of the request.
+     * @return PreparedRequest Prepared request.
+     */
+    PreparedRequest preparePost(RequestParameters requestParameters,
+                                const std::atomic<bool>& shouldRun,
+                                ConfigurationParameters configurationParameters = {});
+
+    /**
+     * @brief Prepares a HTTP PUT request to be performed many times. The data of the request parameters is the default
+     * body.
+     *
+     * @param requestParameters Parameters to be used in the request. Mandatory.
+     * @param shouldRun Flag that interrupts the executions with the MULTI and SHARED_MULTI handler types. The handle of
+     * the prepared request stays bound to it, so it must outlive the request; the one of 'configurationParameters' is
+     * ignored.
+     * @param configurationParameters Parameters to configure the behavior of the request.
+     * @return PreparedRequest Prepared request.
+     */
+    PreparedRequest preparePut(RequestParameters requestParameters,
+                               const std::atomic<bool>& shouldRun,
+                               ConfigurationParameters configurationParameters = {});
+
+    /**
+     * @brief Prepares a HTTP PATCH request to be performed many times. The data of the request parameters is the
+     * default body.
+     *
+     * @param requestParameters Parameters to be used in the request. Mandatory.
+     * @param shouldRun Flag that interrupts the executions with the MULTI and SHARED_MULTI handler types. The handle of
+     * the prepared request stays bound to it, so it must outlive the request; the one of 'configurationParameters' is
+     * ignored.
+     * @param configurationParameters Parameters to configure the behavior of the request.
+     * @return PreparedRequest Prepared request.
+     */
+    PreparedRequest preparePatch(RequestParameters requestParameters,
+                                 const std::atomic<bool>& shouldRun,
+                                 ConfigurationParameters configurationParameters = {});
+
+    /**
+     * @brief Prepares a HTTP DELETE request to be performed many times.
+     *
+     * @param requestParameters Parameters to be used in the request. Mandatory.
+     * @param shouldRun Flag that interrupts the executions with the MULTI and SHARED_MULTI handler types. The handle of
+     * the prepared request stays bound to it, so it must outlive the request; the one of 'configurationParameters' is
+     * ignored.
+     * @param configurationParameters Parameters to configure the behavior of the request.
+     * @return PreparedRequest Prepared request.
+     */
+    PreparedRequest prepareDelete(RequestParameters requestParameters,
+                                  const std::atomic<bool>& shouldRun,
+                                  ConfigurationParameters configurationParameters = {});
+
+    /**
+     * @brief Connects to the given hosts ahead of the first requests to them, so they don't pay for the name
+     * resolution, the connection and the TLS handshake. A HEAD request is made to each URL and its connection is kept
+     * in the pool of the handler: with 'SHARED_MULTI' it's shared by the requests of all threads, with the other types
+     * only by the requests of the calling thread. The hosts that can't be reached are skipped.
+     *
+     * @param urls URLs of the hosts.
+     * @param shouldRun Flag that interrupts the requests. A handler of the cache stays bound to it, so it must outlive
+     * the calling thread; the one of 'configurationParameters' is ignored.
+     * @param secureCommunication Secure communication object, used for the HTTPS hosts.
+     * @param configurationParameters Parameters to configure the behavior of the requests.
+     * @return size_t Number of hosts connected.
+     */
+    size_t preconnect(const std::vector<std::string>& urls,
+                      const std::atomic<bool>& shouldRun,
+                      const SecureCommunication& secureCommunication = {},
+                      ConfigurationParameters configurationParameters = {});
+
+    /**
+     * @brief Front-loads the work of the first request of the process in the background: the library and the handler
+     * cache are initialized and the given hosts are preconnected with the 'SHARED_MULTI' handler type. Meant to be
+     * called at the startup of a daemon, the requests made meanwhile aren't blocked.
+     *
+     * Only the requests made with the 'SHARED_MULTI' handler type, from any thread, use the preconnected connections.
+     * The connections of the other types belong to the thread that makes the requests, which has to call preconnect()
+     * itself.
+     *
+     * The warmup runs on a detached thread, so the future can be dropped without waiting for it. The process shouldn't
+     * exit while it runs: wait for the future first if it may.
+     *
+     * @param urls URLs of the hosts to preconnect.
+     * @param secureCommunication Secure communication object, used for the HTTPS hosts.
+     * @return std::future<size_t> Number of hosts connected, ready once the warmup is done.
+     */
+    std::future<size_t> warmup(std::vector<std::string> urls = {}, SecureCommunication secureCommunication = {});
+
+private:
+    /**
+     * @brief Configures a request of the given type on a handle owned by the prepared request.
+     *
+     * @tparam TRequest Request builder type.
+     * @param requestParameters Parameters to be used in the request.
+     * @param shouldRun Flag that interrupts the executions.
+     * @param configurationParameters Parameters to configure the behavior of the request.
+     * @return PreparedRequest Prepared request.
+     */
+    template<typename TRequest>
+    PreparedRequest prepare(const RequestParameters& requestParameters,
+                            const std::atomic<bool>& shouldRun,
+                            const ConfigurationParameters& configurationParameters);
 };
 
 #endif // _HTTP_REQUEST_HPP
@@ -13,12 +13,20 @@
 #define _URL_REQUEST_HPP
 
 #include "secureCommunication.hpp"
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <initializer_list>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <string_view>
 #include <unordered_set>
+#include <utility>
 #include <variant>
+#include <vector>
 
 enum SOCKET_TYPE
 {
@@ -29,13 +37,34 @@ enum SOCKET_TYPE
 enum class CurlHandlerTypeEnum
 {
     SINGLE,
-    MULTI
+    MULTI,
+    SHARED_MULTI
+};
+
+enum class HttpVersionEnum
+{
+    DEFAULT,               ///< libcurl default.
+    HTTP_1_1,              ///< HTTP/1.1 only.
+    HTTP_2_TLS,            ///< HTTP/2 negotiated over TLS, HTTP/1.1 for plain text URLs.
+    HTTP_2_PRIOR_KNOWLEDGE ///< HTTP/2 without upgrade (h2c), for services known to support it.
 };
 
 // HTTP headers used by default in queries.
 const std::unordered_set<std::string> DEFAULT_HEADERS {
     "Content-Type: application/json", "Accept: application/json", "Accept-Charset: utf-8"};
 
+// Memory-mapped file used by default to share GET responses between processes.
+const std::string DEFAULT_SHARED_CACHE_PATH {"/dev/shm/urlrequest_cache"};
+
+// Maximum size in bytes of the download store.
+constexpr uintmax_t DEFAULT_DOWNLOAD_STORE_MAX_SIZE {1024 * 1024 * 1024};
+
+// Initial capacity of the query string buffer.
+constexpr size_t DEFAULT_QUERY_CAPACITY {256};
+
+class ParsedURL;
+struct curl_slist;
+
 /**
  * @brief This class is an abstraction of URL.
  * It is a base class to store the type/configuration of the request to made.
@@ -71,6 +100,15 @@ public:
         return m_socketType;
     };
 
+    /**
+     * @brief Returns the URL parsed into its components.
+     * @return Parsed URL, or nullptr if the URL isn't parsed ahead of the request.
+     */
+    const std::shared_ptr<const ParsedURL>& parsedUrl() const
+    {
+        return m_parsedUrl;
+    }
+
 protected:
     /**
      * @brief Variable to store the socket type.
@@ -84,6 +122,102 @@ protected:
      * @brief Variable to store the socket path.
      */
     std::string m_sock;
+    /**
+     * @brief Variable to store the parsed URL, shared by the copies of the object.
+     */
+    std::shared_ptr<const ParsedURL> m_parsedUrl;
+};
+
+/**
+ * @brief This class builds a percent-encoded query string. Its buffer keeps its capacity when cleared, so a builder
+ * reused for many requests doesn't reallocate.
+ */
+class QueryBuilder final
+{
+private:
+    std::string m_query;
+
+    static bool unreserved(const unsigned char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '.' ||
+               c == '_' || c == '~';
+    }
+
+    static size_t encodedSize(std::string_view value)
+    {
+        return std::count_if(value.begin(), value.end(), [](const char c) { return !unreserved(c); }) * 2 +
+               value.size();
+    }
+
+    void appendEncoded(std::string_view value)
+    {
+        constexpr std::string_view HEX_DIGITS {"0123456789ABCDEF"};
+        for (const auto c : value)
+        {
+            const auto byte {static_cast<unsigned char>(c)};
+            if (unreserved(byte))
+            {
+                m_query.push_back(c);
+            }
+            else
+            {
+                m_query.push_back('%');
+                m_query.push_back(HEX_DIGITS[byte >> 4]);
+                m_query.push_back(HEX_DIGITS[byte & 0x0F]);
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor for QueryBuilder class.
+     * @param capacity Initial capacity of the query string.
+     */
+    explicit QueryBuilder(const size_t capacity = DEFAULT_QUERY_CAPACITY)
+    {
+        m_query.reserve(capacity);
+    }
+
+    /**
+     * @brief Appends a parameter. The key and the value are percent-encoded straight into the query string.
+     * @param key Parameter name.
+     * @param value Parameter value.
+     * @return A reference to the object.
+     */
+    QueryBuilder& add(std::string_view key, std::string_view value)
+    {
+        const auto size {m_query.size() + 2 + encodedSize(key) + encodedSize(value)};
+        if (size > m_query.capacity())
+        {
+            m_query.reserve(std::max(size, m_query.capacity() * 2));
+        }
+
+        if (!m_query.empty())
+        {
+            m_query.push_back('&');
+        }
+        appendEncoded(key);
+        m_query.push_back('=');
+        appendEncoded(value);
+        return *this;
+    }
+
+    /**
+     * @brief Removes all the parameters, keeping the capacity.
+     */
+    void clear()
+    {
+        m_query.clear();
+    }
+
+    /**
+     * @brief Returns the query string, without the leading '?'.
+     * @return Query string.
+     */
+    const std::string& str() const
+    {
+        return m_query;
+    }
 };
 
 /**
@@ -113,13 +247,413 @@ class HttpURL final : public URL
 {
 public:
     /**
-     * @brief Constructor for HttpURL class.
+     * @brief Constructor for HttpURL class. The URL isn't parsed, libcurl parses it on each request.
+     * @param url Socket URL.
+     */
+    HttpURL(const std::string& url);
+
+    /**
+     * @brief Constructor for HttpURL class, appends a query string to a URL. A parsed URL isn't parsed again.
+     * @param base Base URL.
+     * @param query Query parameters to append.
+     */
+    HttpURL(const HttpURL& base, const QueryBuilder& query);
+
+    /**
+     * @brief Creates an HttpURL parsed once ahead of the requests, so it can be reused for many requests without
+     * parsing it again. Invalid URLs are left unparsed, libcurl reports the error when the request is performed.
      * @param url Socket URL.
+     * @return Parsed URL.
+     */
+    static HttpURL parse(const std::string& url);
+};
+
+/**
+ * @brief This class holds an immutable set of HTTP headers, compiled once into the header list given to libcurl and an
+ * index by header name. Copies share the compiled set, so a set built once can be used by any number of requests and
+ * threads. The headers that vary between requests, like credentials or trace IDs, are appended to the request on top
+ * of the set: an appended header replaces the header of the set with the same name.
+ */
+class HeaderSet final
+{
+private:
+    class Data;
+    std::shared_ptr<const Data> m_data;
+
+public:
+    /**
+     * @brief Constructor for an empty HeaderSet.
+     */
+    HeaderSet() = default;
+
+    /**
+     * @brief Constructor for HeaderSet class. Repeated headers are only added once.
+     * @param headers Headers, as 'Name: value'.
+     */
+    HeaderSet(std::initializer_list<std::string> headers);
+
+    /**
+     * @brief Constructor for HeaderSet class, so that a set of headers can be given where a HeaderSet is expected.
+     * @param headers Headers, as 'Name: value'.
      */
-    HttpURL(const std::string& url)
+    HeaderSet(const std::unordered_set<std::string>& headers);
+
+    /**
+     * @brief Returns the set of the default headers, DEFAULT_HEADERS, compiled once.
+     * @return Default headers.
+     */
+    static const HeaderSet& defaults();
+
+    /**
+     * @brief Returns the name of a header.
+     * @param header Header, as 'Name: value' or 'Name;'.
+     * @return Header name.
+     */
+    static std::string_view name(std::string_view header);
+
+    /**
+     * @brief Returns whether the set has a header.
+     * @param name Header name, case insensitive.
+     * @return true if the set has the header.
+     */
+    bool contains(std::string_view name) const;
+
+    /**
+     * @brief Returns the value of a header.
+     * @param name Header name, case insensitive.
+     * @return Header value, empty if the set doesn't have the header.
+     */
+    std::string_view value(std::string_view name) const;
+
+    /**
+     * @brief Returns the number of headers.
+     * @return Number of headers.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Returns the headers sorted and joined, each one preceded by a newline, to identify the set regardless of
+     * the order of its headers.
+     * @return Key of the set.
+     */
+    const std::string& key() const;
+
+    /**
+     * @brief Returns the compiled header list. libcurl only reads it, so it must not be modified.
+     * @return Header list, nullptr if the set is empty.
+     */
+    const curl_slist* list() const;
+};
+
+/**
+ * @struct TransferMetrics
+ * @brief The structure groups the information that libcurl reports about a transfer. The times are measured from the
+ * start of the transfer and, as libcurl does, add up the hops of the redirects followed, so each phase takes the
+ * difference with the previous one: queueing (queueTime), DNS (nameLookupTime), TCP connect, TLS handshake
+ * (appConnectTime), request upload (postTransferTime - preTransferTime), server wait (startTransferTime -
+ * postTransferTime) and body transfer (totalTime - startTransferTime). The queue and post-transfer times need libcurl
+ * 8.6 and 8.10, and are 0 with older versions.
+ */
+struct TransferMetrics
+{
+    std::chrono::microseconds queueTime {0};         ///< Until the transfer left the queue of the multi handle.
+    std::chrono::microseconds nameLookupTime {0};    ///< Until the host name was resolved.
+    std::chrono::microseconds connectTime {0};       ///< Until the connection to the host was established.
+    std::chrono::microseconds appConnectTime {0};    ///< Until the TLS handshake was completed, 0 without TLS.
+    std::chrono::microseconds preTransferTime {0};   ///< Until the request was about to be sent.
+    std::chrono::microseconds postTransferTime {0};  ///< Until the request was sent.
+    std::chrono::microseconds startTransferTime {0}; ///< Until the first byte of the response was received.
+    std::chrono::microseconds totalTime {0};         ///< Time of the whole transfer, including the redirects.
+    uint64_t bytesReceived {0};                      ///< Bytes of the response bodies.
+    uint64_t bytesSent {0};                          ///< Bytes of the request body.
+    uint64_t headerBytesReceived {0};                ///< Bytes of the response headers.
+    long redirectCount {0};                          ///< Redirects followed.
+    long httpVersion {0};                            ///< HTTP version of the response: 10, 11, 20 or 30, 0 if unknown.
+    bool connectionReused {false};                   ///< The transfer didn't have to open a new connection.
+    long connections {0};                            ///< Connections opened by the transfer, 0 if it reused one.
+};
+
+/**
+ * @brief This class holds the observer that receives the metrics of every transfer performed by the library, whatever
+ * the request, the handler type or the thread, including the failed ones.
+ */
+class TransferObserver final
+{
+public:
+    /**
+     * @brief Callback called with the effective URL, the status code (0 if no response was received) and the metrics
+     * of a transfer.
+     */
+    using Callback = std::function<void(std::string_view url, long status, const TransferMetrics& metrics)>;
+
+    /**
+     * @brief Sets the observer. It's called from the thread that performed the transfer, so it must be thread safe.
+     * Exceptions thrown by it are ignored.
+     * @param callback Observer, an empty callback removes it.
+     */
+    static void set(Callback callback);
+
+    /**
+     * @brief Returns whether an observer is set. Checked by the handlers before gathering what the observer receives.
+     * @return true if an observer is set.
+     */
+    static bool enabled();
+
+    /**
+     * @brief Calls the observer, if it's set.
+     * @param url Effective URL of the transfer.
+     * @param status Status code.
+     * @param metrics Transfer metrics.
+     */
+    static void notify(std::string_view url, long status, const TransferMetrics& metrics);
+};
+
+/**
+ * @struct RequestEvent
+ * @brief The structure identifies the request and the moment of an event received by a request observer.
+ */
+struct RequestEvent
+{
+    uint64_t id {0};                       ///< Identifier of the request, unique in the process.
+    std::string_view method;               ///< Method of the request.
+    std::string_view url;                  ///< URL of the request.
+    std::chrono::microseconds elapsed {0}; ///< Time since the start of the request, as measured by libcurl.
+};
+
+/**
+ * @brief This class is an interface to follow the lifecycle of the requests, for example to trace them. The hooks are
+ * called once per request, in this order: onStart; onDnsDone, onConnected and onTlsDone when a new connection is
+ * opened (onTlsDone only with TLS); onFirstByte when a response is received; and either onComplete or onError. They're
+ * called from the thread that performs the request, except that with 'SHARED_MULTI' the phases may be notified from
+ * the thread that drives the transfers. The hooks do nothing by default, and the exceptions thrown by them are ignored.
+ *
+ * An observer can be given to a single request, through ConfigurationParameters::observer, or set globally for all
+ * the requests that don't have one.
+ */
+class IRequestObserver
+{
+public:
+    virtual ~IRequestObserver() = default;
+
+    /**
+     * @brief Called before the request is performed.
+     * @param event Request event.
+     */
+    virtual void onStart(const RequestEvent& event);
+
+    /**
+     * @brief Called once the host name is resolved.
+     * @param event Request event.
+     */
+    virtual void onDnsDone(const RequestEvent& event);
+
+    /**
+     * @brief Called once the connection to the host is established.
+     * @param event Request event.
+     */
+    virtual void onConnected(const RequestEvent& event);
+
+    /**
+     * @brief Called once the TLS handshake is completed.
+     * @param event Request event.
+     */
+    virtual void onTlsDone(const RequestEvent& event);
+
+    /**
+     * @brief Called once the first byte of the response is received.
+     * @param event Request event.
+     */
+    virtual void onFirstByte(const RequestEvent& event);
+
+    /**
+     * @brief Called when the request succeeds.
+     * @param event Request event.
+     * @param status Status code.
+     * @param metrics Transfer metrics.
+     */
+    virtual void onComplete(const RequestEvent& event, long status, const TransferMetrics& metrics);
+
+    /**
+     * @brief Called when the request fails.
+     * @param event Request event.
+     * @param message Error message.
+     * @param status Status code, 0 if no response was received.
+     */
+    virtual void onError(const RequestEvent& event, std::string_view message, long status);
+
+    /**
+     * @brief Sets the observer of the requests that don't have one. It's called from every thread, so it must be
+     * thread safe.
+     * @param observer Observer, nullptr removes it.
+     */
+    static void setGlobal(std::shared_ptr<IRequestObserver> observer);
+
+    /**
+     * @brief Returns the global observer.
+     * @return std::shared_ptr<IRequestObserver> Observer, nullptr if none is set.
+     */
+    static std::shared_ptr<IRequestObserver> global();
+};
+
+/**
+ * @brief This class holds the headers of a response. The names and values are views into a single buffer with the
+ * received header lines, indexed by name, case insensitive, so looking a header up doesn't copy it.
+ */
+class ResponseHeaders final
+{
+private:
+    std::vector<char> m_buffer; ///< Header lines as received. Its storage is kept when moved, so the views stay valid.
+    std::vector<std::pair<std::string_view, std::string_view>> m_entries; ///< Names and values, sorted by name.
+
+public:
+    using const_iterator = std::vector<std::pair<std::string_view, std::string_view>>::const_iterator;
+
+    /**
+     * @brief Constructor for an empty ResponseHeaders.
+     */
+    ResponseHeaders() = default;
+
+    /**
+     * @brief Constructor for ResponseHeaders class. The lines that aren't headers, like the status line, are skipped.
+     * @param buffer Header lines, each one ended by CRLF.
+     */
+    explicit ResponseHeaders(std::vector<char> buffer);
+
+    ResponseHeaders(const ResponseHeaders&) = delete;
+    ResponseHeaders& operator=(const ResponseHeaders&) = delete;
+    ResponseHeaders(ResponseHeaders&&) noexcept = default;
+    ResponseHeaders& operator=(ResponseHeaders&&) noexcept = default;
+
+    /**
+     * @brief Returns whether the response has a header.
+     * @param name Header name, case insensitive.
+     * @return true if the response has the header.
+     */
+    bool contains(std::string_view name) const;
+
+    /**
+     * @brief Returns the value of a header. If it was received more than once, the first value is returned.
+     * @param name Header name, case insensitive.
+     * @return Header value, empty if the response doesn't have the header.
+     */
+    std::string_view value(std::string_view name) const;
+
+    /**
+     * @brief Returns all the values of a header, in the order they were received.
+     * @param name Header name, case insensitive.
+     * @return Header values.
+     */
+    std::vector<std::string_view> values(std::string_view name) const;
+
+    /**
+     * @brief Returns the number of headers.
+     * @return Number of headers.
+     */
+    size_t size() const
     {
-        m_socketType = SOCKET_TCP;
-        m_url = url;
+        return m_entries.size();
+    }
+
+    /**
+     * @brief Returns an iterator to the first header, sorted by name.
+     * @return Iterator to the first header.
+     */
+    const_iterator begin() const
+    {
+        return m_entries.cbegin();
+    }
+
+    /**
+     * @brief Returns an iterator past the last header.
+     * @return Iterator past the last header.
+     */
+    const_iterator end() const
+    {
+        return m_entries.cend();
+    }
+};
+
+/**
+ * @brief This class holds a response: the status code, the headers, the body and the metrics of the transfer. It owns
+ * the buffers the transfer was received into, so it can be moved but not copied.
+ */
+class Response final
+{
+private:
+    long m_status {0};
+    ResponseHeaders m_headers;
+    std::string m_body;
+    TransferMetrics m_metrics;
+
+public:
+    /**
+     * @brief Constructor for an empty Response.
+     */
+    Response() = default;
+
+    /**
+     * @brief Constructor for Response class.
+     * @param status Status code.
+     * @param headers Headers.
+     * @param body Body.
+     * @param metrics Transfer metrics.
+     */
+    Response(const long status, ResponseHeaders headers, std::string body, const TransferMetrics& metrics)
+        : m_status {status}
+        , m_headers {std::move(headers)}
+        , m_body {std::move(body)}
+        , m_metrics {metrics}
+    {
+    }
+
+    Response(const Response&) = delete;
+    Response& operator=(const Response&) = delete;
+    Response(Response&&) noexcept = default;
+    Response& operator=(Response&&) noexcept = default;
+
+    /**
+     * @brief Returns the status code.
+     * @return Status code.
+     */
+    long status() const
+    {
+        return m_status;
+    }
+
+    /**
+     * @brief Returns the headers.
+     * @return Headers.
+     */
+    const ResponseHeaders& headers() const
+    {
+        return m_headers;
+    }
+
+    /**
+     * @brief Returns the body. Empty if it was written to a file.
+     * @return Body.
+     */
+    const std::string& body() const
+    {
+        return m_body;
+    }
+
+    /**
+     * @brief Moves the body out of the response.
+     * @return Body.
+     */
+    std::string takeBody()
+    {
+        return std::move(m_body);
+    }
+
+    /**
+     * @brief Returns the metrics of the transfer.
+     * @return Transfer metrics.
+     */
+    const TransferMetrics& metrics() const
+    {
+        return m_metrics;
     }
 };
 
@@ -150,10 +684,25 @@ struct RequestParameters
     const SecureCommunication& secureCommunication = {};
 
     /**
-     * @brief Headers to be added to the query.
+     * @brief Headers to be added to the query. A set of headers can also be given, but building a HeaderSet once and
+     * reusing it avoids compiling the headers on each request.
+     *
+     */
+    const HeaderSet& httpHeaders = HeaderSet::defaults();
+
+    /**
+     * @brief Validator of the downloaded content, like a version, an ETag or a digest. Together with the URL, it
+     * identifies the content in the download store.
+     *
+     */
+    const std::string& contentValidator = {};
+
+    /**
+     * @brief SHA-256 digest (hexadecimal) expected for the downloaded file. When set, a download whose content doesn't
+     * match it fails.
      *
      */
-    const std::unordered_set<std::string>& httpHeaders = DEFAULT_HEADERS;
+    const std::string& expectedDigest = {};
 };
 
 /**
@@ -171,13 +720,16 @@ struct ConfigurationParameters
     const long timeout = 0;
 
     /**
-     * @brief Type of the cURL handler. Default is 'SINGLE'.
+     * @brief Type of the cURL handler. Default is 'SINGLE'. With 'SHARED_MULTI', the requests of all threads share one
+     * connection pool and, over HTTP/2, are multiplexed over a single connection per host. Only these requests use the
+     * connections opened by HTTPRequest::warmup(); with the other types, the connections belong to the thread that
+     * makes the requests, and are opened ahead with HTTPRequest::preconnect() from that thread.
      *
      */
     const CurlHandlerTypeEnum& handlerType = CurlHandlerTypeEnum::SINGLE;
 
     /**
-     * @brief Flag used to interrupt the handler when the 'handlerType' is set to 'MULTI'.
+     * @brief Flag used to interrupt the handler when the 'handlerType' is set to 'MULTI' or 'SHARED_MULTI'.
      *
      */
     const std::atomic<bool>& shouldRun = true;
@@ -187,6 +739,85 @@ struct ConfigurationParameters
      *
      */
     const std::string& userAgent = {};
+
+    /**
+     * @brief Time in seconds that a GET response is kept in the cache shared by all the processes of the host. Zero
+     * disables the cache.
+     *
+     */
+    const long sharedCacheTTL = 0;
+
+    /**
+     * @brief Memory-mapped file that backs the shared cache. All the processes sharing responses must use the same
+     * file.
+     *
+     */
+    const std::string& sharedCachePath = DEFAULT_SHARED_CACHE_PATH;
+
+    /**
+     * @brief Directory of the content-addressed download store. When set, downloads with a 'contentValidator' are
+     * cloned from the store instead of transferred again. Empty disables the store.
+     *
+     */
+    const std::string& downloadStorePath = {};
+
+    /**
+     * @brief Maximum size in bytes of the download store. The least recently used entries are removed above it.
+     *
+     */
+    const uintmax_t downloadStoreMaxSize = DEFAULT_DOWNLOAD_STORE_MAX_SIZE;
+
+    /**
+     * @brief When the output file already exists, try to update it with the patch published next to the full file
+     * ('<url>.<sha256 of the output file>.patch.zst', created with 'zstd --patch-from'). Requires 'expectedDigest', the
+     * patched file must match it. The full file is downloaded if there is no digest, no patch, or the patch can't be
+     * applied; a missing patch isn't requested again until another digest is expected.
+     *
+     */
+    const bool deltaUpdate = false;
+
+    /**
+     * @brief Cache the targets of permanent redirects (301 and 308) of GET requests and downloads, so the following
+     * requests skip the redirect round-trip. A request to a target on another scheme, host or port is sent without the
+     * basic authentication, the Authorization and Cookie headers and the user information of the URL, as libcurl does
+     * when it follows the redirect. When the cached target can't be resolved or reached, or answers with an HTTP error,
+     * the entry is dropped and the request is retried against the original URL.
+     *
+     */
+    const bool cachePermanentRedirects = false;
+
+    /**
+     * @brief File where the permanent redirects cache is persisted across restarts. Requests with different files use
+     * separate caches. Empty keeps it in memory only.
+     *
+     */
+    const std::string& redirectCachePath = {};
+
+    /**
+     * @brief File that backs the HSTS cache. When set, 'http' URLs of hosts known to require HTTPS are upgraded
+     * locally instead of through a redirect. Empty disables the cache.
+     *
+     */
+    const std::string& hstsCachePath = {};
+
+    /**
+     * @brief File that backs the Alt-Svc cache, where the alternative services (for example, HTTP/2 or HTTP/3
+     * endpoints) advertised by the servers are kept. Empty disables the cache.
+     *
+     */
+    const std::string& altSvcCachePath = {};
+
+    /**
+     * @brief HTTP version used in the request.
+     *
+     */
+    const HttpVersionEnum& httpVersion = HttpVersionEnum::DEFAULT;
+
+    /**
+     * @brief Observer of the lifecycle of the request. Empty uses the global observer, if any.
+     *
+     */
+    const std::shared_ptr<IRequestObserver>& observer = {};
 };
 
 /**
@@ -209,6 +840,13 @@ struct PostRequestParameters
      */
     std::function<void(const std::string&, const long)> onError = {};
 
+    /**
+     * @brief Callback to be called with the whole response when the request is successful, instead of 'onSuccess'.
+     * GET requests with a callback aren't served from nor stored in the shared cache, which only keeps bodies.
+     *
+     */
+    std::function<void(Response)> onResponse = {};
+
     /**
      * @brief File name of to store the output data.
      *
@@ -0,0 +1,69 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _IN_FLIGHT_REQUESTS_HPP
+#define _IN_FLIGHT_REQUESTS_HPP
+
+#include <nlohmann/json.hpp>
+#include <string>
+
+/**
+ * @brief This class lists the requests being performed by the process, to find out which ones are stuck: method, URL
+ * without its query, thread, start time, elapsed time, bytes received and sent so far, and type of handler. Up to 1024
+ * requests are tracked at once, the ones started while there are more are only counted. The tracking is opt-in.
+ */
+class InFlightRequests final
+{
+public:
+    /**
+     * @brief Starts tracking the requests being performed. They aren't tracked by default.
+     */
+    static void enable();
+
+    /**
+     * @brief Stops tracking the requests being performed. The requests being tracked are listed until they're done.
+     */
+    static void disable();
+
+    /**
+     * @brief Returns whether the requests being performed are tracked.
+     *
+     * @return true if the tracking is enabled.
+     */
+    static bool enabled();
+
+    /**
+     * @brief Returns the requests being performed as a JSON document.
+     *
+     * @return nlohmann::json Requests, from the oldest one.
+     */
+    static nlohmann::json json();
+
+    /**
+     * @brief Writes the requests being performed to a file. The file is replaced at once, so a reader never sees a
+     * partial list.
+     *
+     * @param path Output file.
+     */
+    static void write(const std::string& path);
+
+    /**
+     * @brief Writes the requests being performed to a file each time the process receives a signal, like SIGUSR1. The
+     * signal handler only wakes up a thread that writes the file, so the requests are listed even while the threads
+     * that perform them are stuck. The tracking is enabled.
+     *
+     * @param signalNumber Signal.
+     * @param path Output file.
+     */
+    static void writeOnSignal(int signalNumber, const std::string& path);
+};
+
+#endif // _IN_FLIGHT_REQUESTS_HPP
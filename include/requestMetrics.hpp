@@ -0,0 +1,71 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _REQUEST_METRICS_HPP
+#define _REQUEST_METRICS_HPP
+
+#include <functional>
+#include <nlohmann/json.hpp>
+#include <string>
+
+enum class MetricsFormat
+{
+    JSON,      ///< JSON document.
+    PROMETHEUS ///< Prometheus text exposition format.
+};
+
+/**
+ * @brief This class exports the metrics of all the requests performed by the process: requests by method, status and
+ * host, requests in flight, bytes received and sent, connection reuse, handler cache hits, misses and evictions, and
+ * the latency histogram of the transfers. Each thread records its requests on its own counters, which are only added
+ * up when the metrics are exported.
+ */
+class RequestMetrics final
+{
+public:
+    /**
+     * @brief Returns the metrics as a JSON document.
+     *
+     * @return nlohmann::json Metrics.
+     */
+    static nlohmann::json json();
+
+    /**
+     * @brief Returns the metrics in the Prometheus text exposition format.
+     *
+     * @return std::string Metrics.
+     */
+    static std::string prometheus();
+
+    /**
+     * @brief Writes the metrics to a file. The file is replaced at once, so a reader never sees a partial export.
+     *
+     * @param path Output file.
+     * @param format Format of the metrics.
+     */
+    static void write(const std::string& path, MetricsFormat format = MetricsFormat::JSON);
+
+    /**
+     * @brief Hands the metrics to a callback.
+     *
+     * @param callback Callback that receives the exported metrics.
+     * @param format Format of the metrics.
+     */
+    static void report(const std::function<void(const std::string&)>& callback,
+                       MetricsFormat format = MetricsFormat::JSON);
+
+    /**
+     * @brief Sets all the counters and histograms to zero. The requests in flight are kept.
+     */
+    static void reset();
+};
+
+#endif // _REQUEST_METRICS_HPP
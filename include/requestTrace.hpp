@@ -0,0 +1,77 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _REQUEST_TRACE_HPP
+#define _REQUEST_TRACE_HPP
+
+#include <cstddef>
+#include <nlohmann/json.hpp>
+#include <string>
+
+/**
+ * @brief This class controls the trace of the requests performed by the process, and exports it in the Chrome trace
+ * event format, which chrome://tracing and Perfetto open. The trace shows, on the thread that performed them, the
+ * handler cache lookups, the transfers with their phases (queueing, DNS, connect, TLS, send, wait and receive) and the
+ * callbacks of the requests.
+ *
+ * The trace is disabled by default, and then it has no cost beyond checking a flag. Once enabled, the last events are
+ * kept in a fixed-size buffer that the requests write to without locking.
+ */
+class RequestTrace final
+{
+public:
+    /**
+     * @brief Starts tracing the requests.
+     *
+     * @param capacity Events kept, the oldest ones are dropped once there are more. Each event takes 128 bytes.
+     */
+    static void enable(size_t capacity = 8192);
+
+    /**
+     * @brief Stops tracing the requests. The events recorded are kept until they're cleared.
+     */
+    static void disable();
+
+    /**
+     * @brief Returns whether the requests are traced.
+     *
+     * @return true if the trace is enabled.
+     */
+    static bool enabled();
+
+    /**
+     * @brief Drops the events recorded.
+     */
+    static void clear();
+
+    /**
+     * @brief Returns the trace as a Chrome trace event document.
+     *
+     * @return nlohmann::json Trace.
+     */
+    static nlohmann::json json();
+
+    /**
+     * @brief Writes the trace to a file. The file is replaced at once, so a reader never sees a partial trace.
+     *
+     * @param path Output file.
+     */
+    static void write(const std::string& path);
+
+    /**
+     * @brief Writes the trace to a file when the process exits normally.
+     *
+     * @param path Output file, empty to not write it.
+     */
+    static void writeAtExit(const std::string& path);
+};
+
+#endif // _REQUEST_TRACE_HPP
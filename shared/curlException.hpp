@@ -12,6 +12,7 @@
 #ifndef _CURL_EXCEPTION_HPP
 #define _CURL_EXCEPTION_HPP
 
+#include <curl/curl.h>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -22,7 +23,7 @@ namespace Curl
  * @brief Custom exception for Curl wrapper.
  *
  */
-class CurlException : public std::exception
+class CurlException : public std::runtime_error
 {
 public:
     /**
@@ -36,13 +37,13 @@ public:
     }
 
     /**
-     * @brief Return error message.
+     * @brief Returns the cURL error code of the failure.
      *
-     * @return const char* Error message.
+     * @return CURLcode cURL error code.
      */
-    const char* what() const noexcept override
+    CURLcode errorCode() const noexcept
     {
-        return m_error.what();
+        return m_errorCode;
     }
 
     /**
@@ -50,10 +51,25 @@ public:
      *
      * @param errorMessage Error message to show.
      * @param responseCode HTTP response code ID.
+     * @param errorCode cURL error code, an HTTP error by default.
      */
-    CurlException(const std::string& errorMessage, const long responseCode)
-        : m_error {errorMessage}
+    CurlException(const std::string& errorMessage,
+                  const long responseCode,
+                  const CURLcode errorCode = CURLE_HTTP_RETURNED_ERROR)
+        : std::runtime_error {errorMessage}
         , m_responseCode {responseCode}
+        , m_errorCode {errorCode}
+    {
+    }
+
+    /**
+     * @brief Construct a new Curl Exception object for a failure without HTTP response.
+     *
+     * @param errorMessage Error message to show.
+     * @param errorCode cURL error code.
+     */
+    CurlException(const std::string& errorMessage, const CURLcode errorCode)
+        : CurlException {errorMessage, -1, errorCode}
     {
     }
 
@@ -63,14 +79,13 @@ public:
      * @param curlException Pair object with an error message and a response code ID.
      */
     explicit CurlException(const std::pair<const std::string&, const long>& curlException)
-        : m_error {curlException.first}
-        , m_responseCode {curlException.second}
+        : CurlException {curlException.first, curlException.second}
     {
     }
 
 private:
-    std::runtime_error m_error;
     const long m_responseCode;
+    const CURLcode m_errorCode;
 };
 } // namespace Curl
 
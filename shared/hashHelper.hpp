@@ -0,0 +1,43 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _HASH_HELPER_HPP
+#define _HASH_HELPER_HPP
+
+#include <cstdint>
+#include <string_view>
+
+namespace Utils
+{
+constexpr uint64_t FNV1A_64_OFFSET_BASIS {0xcbf29ce484222325ULL};
+constexpr uint64_t FNV1A_64_PRIME {0x100000001b3ULL};
+
+/**
+ * @brief Computes the 64-bit FNV-1a hash of the given data.
+ * Unlike std::hash, the result is stable across processes and builds, so it can be used in persistent or shared
+ * storage.
+ *
+ * @param data Data to hash.
+ * @param seed Initial value, used to chain several calls.
+ * @return uint64_t Hash value.
+ */
+constexpr uint64_t fnv1aHash(std::string_view data, uint64_t seed = FNV1A_64_OFFSET_BASIS)
+{
+    for (const auto character : data)
+    {
+        seed ^= static_cast<uint8_t>(character);
+        seed *= FNV1A_64_PRIME;
+    }
+    return seed;
+}
+} // namespace Utils
+
+#endif // _HASH_HELPER_HPP
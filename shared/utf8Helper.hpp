@@ -0,0 +1,50 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _UTF8_HELPER_HPP
+#define _UTF8_HELPER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Utils
+{
+// Continuation bytes that follow the first byte of a UTF-8 code point, at most.
+constexpr size_t UTF8_MAX_CONTINUATION_BYTES {3};
+
+/**
+ * @brief Returns the longest prefix of a UTF-8 string that fits in a size without splitting a code point. Invalid
+ * sequences are cut like any other bytes.
+ *
+ * @param value UTF-8 string.
+ * @param maxSize Maximum size of the prefix, in bytes.
+ * @return std::string_view Prefix, a view into the string.
+ */
+constexpr std::string_view utf8Prefix(std::string_view value, const size_t maxSize)
+{
+    if (value.size() <= maxSize)
+    {
+        return value;
+    }
+
+    // The first byte left out is a continuation byte when a code point is cut, then the whole code point is left out.
+    auto size {maxSize};
+    while (size > 0 && maxSize - size < UTF8_MAX_CONTINUATION_BYTES &&
+           (static_cast<uint8_t>(value[size]) & 0xC0) == 0x80)
+    {
+        --size;
+    }
+    return value.substr(0, size);
+}
+} // namespace Utils
+
+#endif // _UTF8_HELPER_HPP
@@ -10,15 +10,454 @@
  */
 
 #include "HTTPRequest.hpp"
+#include "curlHandlerCache.hpp"
 #include "curlWrapper.hpp"
+#include "deltaPatcher.hpp"
+#include "downloadStore.hpp"
 #include "factoryRequestImplemetator.hpp"
+#include "parsedURL.hpp"
+#include "permanentRedirectCache.hpp"
+#include "requestTracer.hpp"
+#include "sharedResponseCache.hpp"
 #include "urlRequest.hpp"
+#include <algorithm>
 #include <atomic>
+#include <cctype>
+#include <chrono>
+#include <curl/curl.h>
+#include <filesystem>
+#include <future>
+#include <memory>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 using wrapperType = cURLWrapper;
+using factoryType = FactoryRequestWrapper<wrapperType>;
+
+namespace
+{
+/**
+ * @brief Builds the key that identifies a request in the shared response cache.
+ *
+ * @param url Request URL.
+ * @param secureCommunication Secure communication object.
+ * @param httpHeaders Headers of the request.
+ * @return std::string Cache key, empty if the request must not be shared because it carries credentials. The key is a
+ * digest, so the headers, which may hold tokens, are never written to the shared file.
+ */
+std::string sharedCacheKey(const std::string& url,
+                           const SecureCommunication& secureCommunication,
+                           const HeaderSet& httpHeaders)
+{
+    if (!secureCommunication.getParameter(urlrequest::AuthenticationParameter::BASIC_AUTH_CREDS).empty() ||
+        !secureCommunication.getParameter(urlrequest::AuthenticationParameter::SSL_KEY).empty())
+    {
+        return {};
+    }
+
+    // The key of the header set doesn't depend on the order of its headers.
+    const auto key {url + httpHeaders.key()};
+    Sha256Hasher hasher;
+    hasher.update(key.data(), key.size());
+    return hasher.hexDigest();
+}
+
+/**
+ * @brief Updates the output file applying the patch published by the server for its current content. The patched file
+ * is only kept if it matches the expected digest. Patches the server doesn't publish are remembered, so they aren't
+ * requested again for the same version.
+ *
+ * @param url URL of the full file.
+ * @param secureCommunication Secure communication object.
+ * @param httpHeaders Headers of the request.
+ * @param configurationParameters Configuration of the request.
+ * @param outputFile Local copy to update.
+ * @param expectedDigest SHA-256 digest expected for the new version.
+ * @return true if the output file is up to date, false if the full file must be downloaded.
+ */
+bool patchDownload(const URL& url,
+                   const SecureCommunication& secureCommunication,
+                   const HeaderSet& httpHeaders,
+                   const ConfigurationParameters& configurationParameters,
+                   const std::string& outputFile,
+                   const std::string& expectedDigest)
+{
+    std::error_code ec;
+    if (expectedDigest.empty() || !std::filesystem::is_regular_file(outputFile, ec) ||
+        std::filesystem::file_size(outputFile, ec) > DELTA_PATCH_MAX_BASE_SIZE || ec)
+    {
+        return false;
+    }
+
+    const auto patchFile {outputFile + ".patch"};
+    const auto patchedFile {outputFile + ".patched"};
+    std::string patchUrl;
+    try
+    {
+        const auto baseDigest {Sha256Hasher::fileDigest(outputFile)};
+        if (Sha256Hasher::equal(baseDigest, expectedDigest))
+        {
+            return true;
+        }
+
+        patchUrl = DeltaPatcher::patchUrl(url.url(), baseDigest);
+        if (MissingPatches::instance().contains(patchUrl, expectedDigest))
+        {
+            return false;
+        }
+
+        BasicGetRequest<wrapperType>::builder(
+            factoryType::acquire(configurationParameters.handlerType,
+                                 configurationParameters.shouldRun,
+                                 configurationParameters.hstsCachePath,
+                                 configurationParameters.altSvcCachePath))
+            .url(patchUrl, secureCommunication)
+            .outputFile(patchFile)
+            .headers(httpHeaders)
+            .configuration(configurationParameters)
+            .execute();
+
+        const auto digest {DeltaPatcher::apply(outputFile, patchFile, patchedFile)};
+        if (!Sha256Hasher::equal(digest, expectedDigest))
+        {
+            throw std::runtime_error("Patched file digest mismatch");
+        }
+
+        // Replacing the file, instead of rewriting it, keeps any other link to the old version intact.
+        std::filesystem::rename(patchedFile, outputFile);
+        std::filesystem::remove(patchFile, ec);
+        return true;
+    }
+    catch (const Curl::CurlException& ex)
+    {
+        if (ex.responseCode() == 404 || ex.responseCode() == 410)
+        {
+            MissingPatches::instance().insert(patchUrl, expectedDigest);
+        }
+        std::filesystem::remove(patchFile, ec);
+        return false;
+    }
+    catch (const std::exception&)
+    {
+        std::filesystem::remove(patchFile, ec);
+        std::filesystem::remove(patchedFile, ec);
+        return false;
+    }
+}
+
+/**
+ * @brief Checks whether a request to a cached redirect target failed because the target may no longer be valid: its
+ * host can't be resolved or reached, or it answered with an HTTP error. Other failures, like timeouts or interruptions,
+ * would fail the same on the original URL.
+ *
+ * @param exception Failure of the request.
+ * @return true if the cached redirect is stale.
+ */
+bool isStaleRedirectTarget(const std::exception& exception)
+{
+    const auto curlException {dynamic_cast<const Curl::CurlException*>(&exception)};
+    if (curlException == nullptr)
+    {
+        return false;
+    }
+
+    switch (curlException->errorCode())
+    {
+        case CURLE_COULDNT_RESOLVE_HOST:
+        case CURLE_COULDNT_CONNECT:
+        case CURLE_HTTP_RETURNED_ERROR: return true;
+        default: return false;
+    }
+}
+
+/**
+ * @brief Checks whether a header carries credentials that libcurl doesn't send to another origin when it follows a
+ * redirect.
+ *
+ * @param header Header, as 'Name: value'.
+ * @return true for the Authorization and Cookie headers.
+ */
+bool isCredentialHeader(std::string_view header)
+{
+    const auto name {HeaderSet::name(header)};
+    const auto equals {[&name](std::string_view credential)
+                       {
+                           return std::equal(name.begin(),
+                                             name.end(),
+                                             credential.begin(),
+                                             credential.end(),
+                                             [](const char a, const char b)
+                                             { return std::tolower(a) == std::tolower(b); });
+                       }};
+    return equals("Authorization") || equals("Cookie");
+}
+
+/**
+ * @brief Returns the headers without the ones that carry credentials, for a request sent to a cached redirect target
+ * of another origin.
+ *
+ * @param httpHeaders Headers of the request.
+ * @return HeaderSet Headers without the Authorization and Cookie headers.
+ */
+HeaderSet withoutCredentials(const HeaderSet& httpHeaders)
+{
+    if (!httpHeaders.contains("Authorization") && !httpHeaders.contains("Cookie"))
+    {
+        return httpHeaders;
+    }
+
+    std::unordered_set<std::string> headers;
+    for (auto node {httpHeaders.list()}; node != nullptr; node = node->next)
+    {
+        if (!isCredentialHeader(node->data))
+        {
+            headers.emplace(node->data);
+        }
+    }
+    return headers;
+}
+
+/**
+ * @brief Returns the secure communication without the basic authentication credentials, for a request sent to a cached
+ * redirect target of another origin.
+ *
+ * @param secureCommunication Secure communication object of the request.
+ * @return SecureCommunication Secure communication object without credentials.
+ */
+SecureCommunication withoutCredentials(const SecureCommunication& secureCommunication)
+{
+    auto withoutBasicAuth {secureCommunication};
+    withoutBasicAuth.basicAuth("");
+    return withoutBasicAuth;
+}
+
+/**
+ * @brief Returns a cached redirect target of another origin without the user information of its URL.
+ *
+ * @param target Redirect target.
+ * @return std::string Target without user information, or the target itself if it isn't a valid URL.
+ */
+std::string withoutCredentials(const std::string& target)
+{
+    const auto parsedTarget {ParsedURL::parse(target)};
+    const auto withoutUserInfo {parsedTarget ? parsedTarget->withoutUserInfo() : nullptr};
+    return withoutUserInfo ? withoutUserInfo->url() : target;
+}
+
+/**
+ * @brief Performs a request through the permanent redirects cache, if it's enabled. The request is sent straight to the
+ * cached target; if the target may no longer be valid, the entry is dropped and the request is retried against the
+ * original URL. Any other failure is thrown. A target of another origin doesn't get the credentials of the request, as
+ * libcurl does when it follows the redirect itself.
+ *
+ * @param url Requested URL.
+ * @param secureCommunication Secure communication object of the request.
+ * @param httpHeaders Headers of the request.
+ * @param configurationParameters Configuration of the request.
+ * @param perform Callable that performs the request to the given URL, with the given secure communication and headers,
+ * and returns its permanent redirect target.
+ */
+template<typename TPerform>
+void performFollowingRedirectsCache(const URL& url,
+                                    const SecureCommunication& secureCommunication,
+                                    const HeaderSet& httpHeaders,
+                                    const ConfigurationParameters& configurationParameters,
+                                    TPerform&& perform)
+{
+    if (!configurationParameters.cachePermanentRedirects)
+    {
+        perform(url, secureCommunication, httpHeaders);
+        return;
+    }
+
+    const auto redirectsCache {
+        PermanentRedirectCacheRegistry::instance().getCache(configurationParameters.redirectCachePath)};
+
+    const auto target {redirectsCache->resolve(url.url())};
+    std::string permanentRedirect;
+    if (target == url.url())
+    {
+        permanentRedirect = perform(url, secureCommunication, httpHeaders);
+    }
+    else
+    {
+        try
+        {
+            if (PermanentRedirectCache::sameOrigin(url.url(), target))
+            {
+                permanentRedirect = perform(HttpURL(target), secureCommunication, httpHeaders);
+            }
+            else
+            {
+                permanentRedirect = perform(HttpURL(withoutCredentials(target)),
+                                            withoutCredentials(secureCommunication),
+                                            withoutCredentials(httpHeaders));
+            }
+        }
+        catch (const std::exception& exception)
+        {
+            if (!isStaleRedirectTarget(exception))
+            {
+                throw;
+            }
+            redirectsCache->invalidate(url.url());
+            permanentRedirect = perform(url, secureCommunication, httpHeaders);
+        }
+    }
+
+    if (!permanentRedirect.empty())
+    {
+        redirectsCache->insert(url.url(), permanentRedirect);
+    }
+}
+} // namespace
+
+/**
+ * @brief State of a prepared request: the request implementator over the handle it owns, and what may change between
+ * executions.
+ */
+class PreparedRequest::Impl final
+{
+private:
+    /**
+     * @brief Sets the URL of the execution, appending the query to the prepared URL. The prepared URL is only set
+     * again after an execution that changed it.
+     *
+     * @param query Query parameters, nullptr to use the prepared URL.
+     */
+    void setUrl(const QueryBuilder* query)
+    {
+        if (query == nullptr || query->str().empty())
+        {
+            if (m_queryApplied)
+            {
+                if (m_parsedUrl)
+                {
+                    m_request->setOption<OPT_CURLU>(m_parsedUrl->handle());
+                }
+                else
+                {
+                    m_request->setOption<OPT_URL>(m_url);
+                }
+                m_queryUrl.reset();
+                m_queryApplied = false;
+            }
+            return;
+        }
+
+        if (m_parsedUrl && (m_queryUrl = m_parsedUrl->withQuery(query->str())))
+        {
+            m_request->setOption<OPT_CURLU>(m_queryUrl->handle());
+        }
+        else
+        {
+            m_request->setOption<OPT_URL>(ParsedURL::appendQuery(m_url, query->str()));
+        }
+        m_queryApplied = true;
+    }
+
+public:
+    std::shared_ptr<IRequestImplementator> m_request; ///< Request over the handle owned by the prepared request.
+    std::shared_ptr<const ParsedURL> m_parsedUrl;     ///< Prepared URL, referenced by the handle.
+    std::shared_ptr<const ParsedURL> m_queryUrl;      ///< URL with the query of the last execution.
+    std::string m_url;                                ///< Prepared URL, used when it couldn't be parsed.
+    std::string m_data;                               ///< Default body.
+    bool m_hasBody {false};                           ///< The method sends a body.
+    bool m_queryApplied {false};                      ///< The handle has the URL with a query.
+
+    /**
+     * @brief Performs the request.
+     *
+     * @param data Body of the request.
+     * @param query Query parameters, nullptr to use the prepared URL.
+     * @param postRequestParameters Parameters that define the behavior after the request is made.
+     */
+    void execute(const std::string& data,
+                 const QueryBuilder* query,
+                 const PostRequestParameters& postRequestParameters)
+    {
+        const auto& onError {postRequestParameters.onError};
+        const auto& onSuccess {postRequestParameters.onSuccess};
+        const auto& onResponse {postRequestParameters.onResponse};
+
+        try
+        {
+            // The body isn't copied by libcurl, so it's set on each execution.
+            if (m_hasBody)
+            {
+                m_request->setOption<OPT_POSTFIELDS>(data);
+                m_request->setOption<OPT_POSTFIELDSIZE>(data.size());
+            }
+            setUrl(query);
+
+            m_request->execute();
+
+            if (onResponse)
+            {
+                RequestTracer::callback(onResponse, m_request->takeResponse());
+            }
+            else
+            {
+                RequestTracer::callback(onSuccess, m_request->response());
+            }
+        }
+        catch (const Curl::CurlException& ex)
+        {
+            if (onError)
+            {
+                onError(ex.what(), ex.responseCode());
+            }
+            else
+            {
+                throw;
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            if (onError)
+            {
+                onError(ex.what(), NOT_USED);
+            }
+            else
+            {
+                throw;
+            }
+        }
+    }
+};
+
+PreparedRequest::PreparedRequest(std::unique_ptr<Impl> impl)
+    : m_impl {std::move(impl)}
+{
+}
+
+PreparedRequest::~PreparedRequest() = default;
+
+PreparedRequest::PreparedRequest(PreparedRequest&& other) noexcept = default;
+
+PreparedRequest& PreparedRequest::operator=(PreparedRequest&& other) noexcept = default;
+
+void PreparedRequest::execute(const PostRequestParameters& postRequestParameters)
+{
+    m_impl->execute(m_impl->m_data, nullptr, postRequestParameters);
+}
+
+void PreparedRequest::execute(const std::string& data, const PostRequestParameters& postRequestParameters)
+{
+    m_impl->execute(data, nullptr, postRequestParameters);
+}
+
+void PreparedRequest::execute(const QueryBuilder& query, const PostRequestParameters& postRequestParameters)
+{
+    m_impl->execute(m_impl->m_data, &query, postRequestParameters);
+}
 
 void HTTPRequest::download(RequestParameters requestParameters,
                            PostRequestParameters postRequestParameters,
@@ -28,24 +467,66 @@ void HTTPRequest::download(RequestParameters requestParameters,
     const auto& url {requestParameters.url};
     const auto& secureCommunication {requestParameters.secureCommunication};
     const auto& httpHeaders {requestParameters.httpHeaders};
+    const auto& contentValidator {requestParameters.contentValidator};
+    const auto& expectedDigest {requestParameters.expectedDigest};
     // Post request parameters
     const auto& onError {postRequestParameters.onError};
     const auto& outputFile {postRequestParameters.outputFile};
     // Configuration parameters
-    const auto& timeout {configurationParameters.timeout};
-    const auto& userAgent {configurationParameters.userAgent};
     const auto& handlerType {configurationParameters.handlerType};
     const auto& shouldRun {configurationParameters.shouldRun};
+    const auto& hstsCachePath {configurationParameters.hstsCachePath};
+    const auto& altSvcCachePath {configurationParameters.altSvcCachePath};
+    const auto& downloadStorePath {configurationParameters.downloadStorePath};
+    const auto& downloadStoreMaxSize {configurationParameters.downloadStoreMaxSize};
+    const auto& deltaUpdate {configurationParameters.deltaUpdate};
 
     try
     {
-        GetRequest::builder(FactoryRequestWrapper<wrapperType>::create(handlerType, shouldRun))
-            .url(url.url(), secureCommunication)
-            .outputFile(outputFile)
-            .appendHeaders(httpHeaders)
-            .timeout(timeout)
-            .userAgent(userAgent)
-            .execute();
+        std::optional<DownloadStore> downloadStore;
+        if (!downloadStorePath.empty() && !contentValidator.empty() && !outputFile.empty())
+        {
+            downloadStore.emplace(downloadStorePath, downloadStoreMaxSize);
+            if (downloadStore->fetch(url.url(), contentValidator, outputFile))
+            {
+                return;
+            }
+        }
+
+        // Without a digest a patched file couldn't be verified, so the full file is downloaded.
+        if (!deltaUpdate || outputFile.empty() || expectedDigest.empty() ||
+            !patchDownload(url, secureCommunication, httpHeaders, configurationParameters, outputFile, expectedDigest))
+        {
+            performFollowingRedirectsCache(
+                url,
+                secureCommunication,
+                httpHeaders,
+                configurationParameters,
+                [&](const URL& requestUrl,
+                    const SecureCommunication& requestSecureCommunication,
+                    const HeaderSet& requestHeaders)
+                {
+                    auto req {BasicGetRequest<wrapperType>::builder(
+                        factoryType::acquire(handlerType, shouldRun, hstsCachePath, altSvcCachePath))};
+                    req.url(requestUrl, requestSecureCommunication)
+                        .outputFile(outputFile)
+                        .headers(requestHeaders)
+                        .configuration(configurationParameters)
+                        .execute();
+                    return req.permanentRedirect();
+                });
+
+            if (!expectedDigest.empty() && !outputFile.empty() &&
+                !Sha256Hasher::equal(Sha256Hasher::fileDigest(outputFile), expectedDigest))
+            {
+                throw std::runtime_error("Downloaded file digest mismatch");
+            }
+        }
+
+        if (downloadStore)
+        {
+            downloadStore->store(url.url(), contentValidator, outputFile);
+        }
     }
     catch (const Curl::CurlException& ex)
     {
@@ -82,12 +563,13 @@ void HTTPRequest::post(RequestParameters requestParameters,
     // Post request parameters
     const auto& onError {postRequestParameters.onError};
     const auto& onSuccess {postRequestParameters.onSuccess};
+    const auto& onResponse {postRequestParameters.onResponse};
     const auto& outputFile {postRequestParameters.outputFile};
     // Configuration parameters
-    const auto& timeout {configurationParameters.timeout};
-    const auto& userAgent {configurationParameters.userAgent};
     const auto& handlerType {configurationParameters.handlerType};
     const auto& shouldRun {configurationParameters.shouldRun};
+    const auto& hstsCachePath {configurationParameters.hstsCachePath};
+    const auto& altSvcCachePath {configurationParameters.altSvcCachePath};
 
     try
     {
@@ -95,16 +577,23 @@ void HTTPRequest::post(RequestParameters requestParameters,
                                      ? std::get<std::string>(requestParameters.data)
                                      : std::get<nlohmann::json>(requestParameters.data).dump();
 
-        auto req {PostRequest::builder(FactoryRequestWrapper<wrapperType>::create(handlerType, shouldRun))};
-        req.url(url.url(), secureCommunication)
+        auto req {BasicPostRequest<wrapperType>::builder(
+            factoryType::acquire(handlerType, shouldRun, hstsCachePath, altSvcCachePath))};
+        req.url(url, secureCommunication)
             .postData(data)
-            .appendHeaders(httpHeaders)
-            .timeout(timeout)
-            .userAgent(userAgent)
+            .headers(httpHeaders)
+            .configuration(configurationParameters)
             .outputFile(outputFile)
             .execute();
 
-        onSuccess(req.response());
+        if (onResponse)
+        {
+            RequestTracer::callback(onResponse, req.takeResponse());
+        }
+        else
+        {
+            RequestTracer::callback(onSuccess, req.response());
+        }
     }
     catch (const Curl::CurlException& ex)
     {
@@ -141,24 +630,80 @@ void HTTPRequest::get(RequestParameters requestParameters,
     // Post request parameters
     const auto& onError {postRequestParameters.onError};
     const auto& onSuccess {postRequestParameters.onSuccess};
+    const auto& onResponse {postRequestParameters.onResponse};
     const auto& outputFile {postRequestParameters.outputFile};
     // Configuration parameters
-    const auto& timeout {configurationParameters.timeout};
-    const auto& userAgent {configurationParameters.userAgent};
     const auto& handlerType {configurationParameters.handlerType};
     const auto& shouldRun {configurationParameters.shouldRun};
+    const auto& hstsCachePath {configurationParameters.hstsCachePath};
+    const auto& altSvcCachePath {configurationParameters.altSvcCachePath};
+    const auto& sharedCacheTTL {configurationParameters.sharedCacheTTL};
+    const auto& sharedCachePath {configurationParameters.sharedCachePath};
 
     try
     {
-        auto req {GetRequest::builder(FactoryRequestWrapper<wrapperType>::create(handlerType, shouldRun))};
-        req.url(url.url(), secureCommunication)
-            .appendHeaders(httpHeaders)
-            .timeout(timeout)
-            .userAgent(userAgent)
-            .outputFile(outputFile)
-            .execute();
+        // Responses written to a file are not shared, the file itself is the result.
+        std::shared_ptr<SharedResponseCache> sharedCache;
+        std::string cacheKey;
+        if (sharedCacheTTL > 0 && outputFile.empty() && !onResponse)
+        {
+            cacheKey = sharedCacheKey(url.url(), secureCommunication, httpHeaders);
+            if (!cacheKey.empty())
+            {
+                sharedCache = SharedResponseCacheRegistry::instance().getCache(sharedCachePath);
+            }
+
+            if (sharedCache)
+            {
+                if (const auto cachedResponse {sharedCache->get(cacheKey)}; cachedResponse)
+                {
+                    RequestTracer::callback(onSuccess, *cachedResponse);
+                    return;
+                }
+            }
+        }
+
+        std::string response;
+        std::optional<Response> wholeResponse;
+        performFollowingRedirectsCache(
+            url,
+            secureCommunication,
+            httpHeaders,
+            configurationParameters,
+            [&](const URL& requestUrl,
+                const SecureCommunication& requestSecureCommunication,
+                const HeaderSet& requestHeaders)
+            {
+                auto req {BasicGetRequest<wrapperType>::builder(
+                    factoryType::acquire(handlerType, shouldRun, hstsCachePath, altSvcCachePath))};
+                req.url(requestUrl, requestSecureCommunication)
+                    .headers(requestHeaders)
+                    .configuration(configurationParameters)
+                    .outputFile(outputFile)
+                    .execute();
+                if (onResponse)
+                {
+                    wholeResponse.emplace(req.takeResponse());
+                }
+                else
+                {
+                    response = req.response();
+                }
+                return req.permanentRedirect();
+            });
+
+        if (onResponse)
+        {
+            RequestTracer::callback(onResponse, std::move(*wholeResponse));
+            return;
+        }
+
+        if (sharedCache)
+        {
+            sharedCache->put(cacheKey, response, std::chrono::seconds(sharedCacheTTL));
+        }
 
-        onSuccess(req.response());
+        RequestTracer::callback(onSuccess, response);
     }
     catch (const Curl::CurlException& ex)
     {
@@ -195,12 +740,13 @@ void HTTPRequest::put(RequestParameters requestParameters,
     // Post request parameters
     const auto& onError {postRequestParameters.onError};
     const auto& onSuccess {postRequestParameters.onSuccess};
+    const auto& onResponse {postRequestParameters.onResponse};
     const auto& outputFile {postRequestParameters.outputFile};
     // Configuration parameters
-    const auto& timeout {configurationParameters.timeout};
-    const auto& userAgent {configurationParameters.userAgent};
     const auto& handlerType {configurationParameters.handlerType};
     const auto& shouldRun {configurationParameters.shouldRun};
+    const auto& hstsCachePath {configurationParameters.hstsCachePath};
+    const auto& altSvcCachePath {configurationParameters.altSvcCachePath};
 
     try
     {
@@ -208,16 +754,23 @@ void HTTPRequest::put(RequestParameters requestParameters,
                                      ? std::get<std::string>(requestParameters.data)
                                      : std::get<nlohmann::json>(requestParameters.data).dump();
 
-        auto req {PutRequest::builder(FactoryRequestWrapper<wrapperType>::create(handlerType, shouldRun))};
-        req.url(url.url(), secureCommunication)
+        auto req {BasicPutRequest<wrapperType>::builder(
+            factoryType::acquire(handlerType, shouldRun, hstsCachePath, altSvcCachePath))};
+        req.url(url, secureCommunication)
             .postData(data)
-            .appendHeaders(httpHeaders)
-            .timeout(timeout)
-            .userAgent(userAgent)
+            .headers(httpHeaders)
+            .configuration(configurationParameters)
             .outputFile(outputFile)
             .execute();
 
-        onSuccess(req.response());
+        if (onResponse)
+        {
+            RequestTracer::callback(onResponse, req.takeResponse());
+        }
+        else
+        {
+            RequestTracer::callback(onSuccess, req.response());
+        }
     }
     catch (const Curl::CurlException& ex)
     {
@@ -254,12 +807,13 @@ void HTTPRequest::patch(RequestParameters requestParameters,
     // Post request parameters
     const auto& onError {postRequestParameters.onError};
     const auto& onSuccess {postRequestParameters.onSuccess};
+    const auto& onResponse {postRequestParameters.onResponse};
     const auto& outputFile {postRequestParameters.outputFile};
     // Configuration parameters
-    const auto& timeout {configurationParameters.timeout};
-    const auto& userAgent {configurationParameters.userAgent};
     const auto& handlerType {configurationParameters.handlerType};
     const auto& shouldRun {configurationParameters.shouldRun};
+    const auto& hstsCachePath {configurationParameters.hstsCachePath};
+    const auto& altSvcCachePath {configurationParameters.altSvcCachePath};
 
     try
     {
@@ -267,16 +821,23 @@ void HTTPRequest::patch(RequestParameters requestParameters,
                                      ? std::get<std::string>(requestParameters.data)
                                      : std::get<nlohmann::json>(requestParameters.data).dump();
 
-        auto req {PatchRequest::builder(FactoryRequestWrapper<wrapperType>::create(handlerType, shouldRun))};
-        req.url(url.url(), secureCommunication)
+        auto req {BasicPatchRequest<wrapperType>::builder(
+            factoryType::acquire(handlerType, shouldRun, hstsCachePath, altSvcCachePath))};
+        req.url(url, secureCommunication)
             .postData(data)
-            .appendHeaders(httpHeaders)
-            .timeout(timeout)
-            .userAgent(userAgent)
+            .headers(httpHeaders)
+            .configuration(configurationParameters)
             .outputFile(outputFile)
             .execute();
 
-        onSuccess(req.response());
+        if (onResponse)
+        {
+            RequestTracer::callback(onResponse, req.takeResponse());
+        }
+        else
+        {
+            RequestTracer::callback(onSuccess, req.response());
+        }
     }
     catch (const Curl::CurlException& ex)
     {
@@ -313,24 +874,32 @@ void HTTPRequest::delete_(RequestParameters requestParameters,
     // Post request parameters
     const auto& onError {postRequestParameters.onError};
     const auto& onSuccess {postRequestParameters.onSuccess};
+    const auto& onResponse {postRequestParameters.onResponse};
     const auto& outputFile {postRequestParameters.outputFile};
     // Configuration parameters
-    const auto& timeout {configurationParameters.timeout};
-    const auto& userAgent {configurationParameters.userAgent};
     const auto& handlerType {configurationParameters.handlerType};
     const auto& shouldRun {configurationParameters.shouldRun};
+    const auto& hstsCachePath {configurationParameters.hstsCachePath};
+    const auto& altSvcCachePath {configurationParameters.altSvcCachePath};
 
     try
     {
-        auto req {DeleteRequest::builder(FactoryRequestWrapper<wrapperType>::create(handlerType, shouldRun))};
-        req.url(url.url(), secureCommunication)
-            .appendHeaders(httpHeaders)
-            .timeout(timeout)
-            .userAgent(userAgent)
+        auto req {BasicDeleteRequest<wrapperType>::builder(
+            factoryType::acquire(handlerType, shouldRun, hstsCachePath, altSvcCachePath))};
+        req.url(url, secureCommunication)
+            .headers(httpHeaders)
+            .configuration(configurationParameters)
             .outputFile(outputFile)
             .execute();
 
-        onSuccess(req.response());
+        if (onResponse)
+        {
+            RequestTracer::callback(onResponse, req.takeResponse());
+        }
+        else
+        {
+            RequestTracer::callback(onSuccess, req.response());
+        }
     }
     catch (const Curl::CurlException& ex)
     {
@@ -355,3 +924,154 @@ void HTTPRequest::delete_(RequestParameters requestParameters,
         }
     }
 }
+
+template<typename TRequest>
+PreparedRequest HTTPRequest::prepare(const RequestParameters& requestParameters,
+                                     const std::atomic<bool>& shouldRun,
+                                     const ConfigurationParameters& configurationParameters)
+{
+    auto impl {std::make_unique<PreparedRequest::Impl>()};
+
+    // The handle isn't taken from the cache of the thread, the prepared request owns it.
+    auto curlHandler {cURLHandlerCache::createCurlHandler(configurationParameters.handlerType, shouldRun)};
+    curlHandler->keepOptions(true);
+    impl->m_request = factoryType::create(std::move(curlHandler));
+
+    std::optional<HttpURL> parsedUrl;
+    if (!requestParameters.url.parsedUrl() && requestParameters.url.socketType() == SOCKET_TCP)
+    {
+        // The prepared request is performed many times, so its URL is parsed once.
+        parsedUrl = HttpURL::parse(requestParameters.url.url());
+    }
+    const URL& url {parsedUrl ? *parsedUrl : requestParameters.url};
+
+    impl->m_parsedUrl = url.parsedUrl();
+    impl->m_url = url.url();
+    impl->m_hasBody = std::is_base_of_v<PostData<TRequest>, TRequest>;
+    if (impl->m_hasBody)
+    {
+        impl->m_data = std::holds_alternative<std::string>(requestParameters.data)
+                           ? std::get<std::string>(requestParameters.data)
+                           : std::get<nlohmann::json>(requestParameters.data).dump();
+    }
+
+    TRequest::builder(impl->m_request)
+        .url(url, requestParameters.secureCommunication)
+        .headers(requestParameters.httpHeaders)
+        .configuration(configurationParameters);
+
+    return PreparedRequest(std::move(impl));
+}
+
+PreparedRequest HTTPRequest::prepareGet(RequestParameters requestParameters,
+                                        const std::atomic<bool>& shouldRun,
+                                        ConfigurationParameters configurationParameters)
+{
+    return prepare<GetRequest>(requestParameters, shouldRun, configurationParameters);
+}
+
+PreparedRequest HTTPRequest::preparePost(RequestParameters requestParameters,
+                                         const std::atomic<bool>& shouldRun,
+                                         ConfigurationParameters configurationParameters)
+{
+    return prepare<PostRequest>(requestParameters, shouldRun, configurationParameters);
+}
+
+PreparedRequest HTTPRequest::preparePut(RequestParameters requestParameters,
+                                        const std::atomic<bool>& shouldRun,
+                                        ConfigurationParameters configurationParameters)
+{
+    return prepare<PutRequest>(requestParameters, shouldRun, configurationParameters);
+}
+
+PreparedRequest HTTPRequest::preparePatch(RequestParameters requestParameters,
+                                          const std::atomic<bool>& shouldRun,
+                                          ConfigurationParameters configurationParameters)
+{
+    return prepare<PatchRequest>(requestParameters, shouldRun, configurationParameters);
+}
+
+PreparedRequest HTTPRequest::prepareDelete(RequestParameters requestParameters,
+                                           const std::atomic<bool>& shouldRun,
+                                           ConfigurationParameters configurationParameters)
+{
+    return prepare<DeleteRequest>(requestParameters, shouldRun, configurationParameters);
+}
+
+size_t HTTPRequest::preconnect(const std::vector<std::string>& urls,
+                               const std::atomic<bool>& shouldRun,
+                               const SecureCommunication& secureCommunication,
+                               ConfigurationParameters configurationParameters)
+{
+    const auto& handlerType {configurationParameters.handlerType};
+
+    size_t connected {0};
+    for (const auto& url : urls)
+    {
+        try
+        {
+            // The shared pool doesn't belong to a handler, so the calling thread doesn't take a slot of the cache.
+            const std::shared_ptr<IRequestImplementator> request {
+                handlerType == CurlHandlerTypeEnum::SHARED_MULTI
+                    ? factoryType::create(cURLHandlerCache::createCurlHandler(handlerType, shouldRun))
+                    : factoryType::acquire(handlerType, shouldRun)};
+
+            HeadRequest::builder(request)
+                .url(url, secureCommunication)
+                .timeout(configurationParameters.timeout)
+                .userAgent(configurationParameters.userAgent)
+                .httpVersion(configurationParameters.httpVersion)
+                .execute();
+            ++connected;
+        }
+        catch (const std::exception&)
+        {
+            // The host is connected to by its first request.
+        }
+    }
+    return connected;
+}
+
+std::future<size_t> HTTPRequest::warmup(std::vector<std::string> urls, SecureCommunication secureCommunication)
+{
+    static const std::atomic<bool> SHOULD_RUN {true};
+
+    // The first handle runs the global initialization of libcurl, as it does for the first request. Without a
+    // thread-safe libcurl, it can't race with the requests of other threads, so it's created before returning.
+    const auto threadSafe {(curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_THREADSAFE) != 0};
+    std::shared_ptr<ICURLHandler> firstHandler;
+    if (!threadSafe)
+    {
+        firstHandler = cURLHandlerCache::createCurlHandler(CurlHandlerTypeEnum::SHARED_MULTI, SHOULD_RUN);
+    }
+
+    // The worker is detached, unlike the one of std::async, so dropping the future doesn't wait for the warmup.
+    std::promise<size_t> promise;
+    auto future {promise.get_future()};
+    std::thread(
+        [this,
+         promise = std::move(promise),
+         firstHandler = std::move(firstHandler),
+         urls = std::move(urls),
+         secureCommunication = std::move(secureCommunication)]() mutable
+        {
+            try
+            {
+                if (!firstHandler)
+                {
+                    firstHandler = cURLHandlerCache::createCurlHandler(CurlHandlerTypeEnum::SHARED_MULTI, SHOULD_RUN);
+                }
+                cURLHandlerCache::instance();
+                promise.set_value(preconnect(urls,
+                                             SHOULD_RUN,
+                                             secureCommunication,
+                                             ConfigurationParameters {0, CurlHandlerTypeEnum::SHARED_MULTI}));
+            }
+            catch (...)
+            {
+                promise.set_exception(std::current_exception());
+            }
+        })
+        .detach();
+    return future;
+}
@@ -0,0 +1,182 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "IURLRequest.hpp"
+#include <algorithm>
+#include <cctype>
+#include <curl/curl.h>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+char lower(const char c)
+{
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+/**
+ * @brief Compares a lowercase header name with a header name in any case.
+ *
+ * @param lowercaseName Lowercase name.
+ * @param name Name in any case.
+ * @return int Negative, zero or positive if the lowercase name sorts before, equal or after the other name.
+ */
+int compareName(std::string_view lowercaseName, std::string_view name)
+{
+    const auto size {std::min(lowercaseName.size(), name.size())};
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (const auto c {lower(name[i])}; lowercaseName[i] != c)
+        {
+            return lowercaseName[i] < c ? -1 : 1;
+        }
+    }
+    return lowercaseName.size() == name.size() ? 0 : (lowercaseName.size() < name.size() ? -1 : 1);
+}
+} // namespace
+
+/**
+ * @brief Compiled headers. The header list and the index point into the buffer, so the object is neither copied nor
+ * moved once built.
+ */
+class HeaderSet::Data final
+{
+public:
+    std::string m_buffer;                                          ///< Headers, each one followed by a null character.
+    std::vector<curl_slist> m_nodes;                               ///< Header list over the buffer.
+    std::vector<std::pair<std::string, std::string_view>> m_index; ///< Lowercase names and values, sorted by name.
+    std::string m_key;                                             ///< Sorted headers, each one after a newline.
+
+    explicit Data(const std::set<std::string>& headers)
+    {
+        size_t size {0};
+        for (const auto& header : headers)
+        {
+            size += header.size() + 1;
+        }
+        m_buffer.reserve(size);
+        m_key.reserve(size);
+        for (const auto& header : headers)
+        {
+            m_buffer.append(header).push_back('\0');
+            m_key.append("\n").append(header);
+        }
+
+        m_nodes.resize(headers.size());
+        m_index.reserve(headers.size());
+        size_t offset {0};
+        for (size_t i = 0; i < m_nodes.size(); ++i)
+        {
+            const std::string_view header {m_buffer.data() + offset};
+            m_nodes[i].data = m_buffer.data() + offset;
+            m_nodes[i].next = i + 1 < m_nodes.size() ? &m_nodes[i + 1] : nullptr;
+            offset += header.size() + 1;
+
+            const auto headerName {HeaderSet::name(header)};
+            auto value {header.substr(std::min(headerName.size() + 1, header.size()))};
+            value.remove_prefix(std::min(value.find_first_not_of(' '), value.size()));
+
+            std::string lowercaseName(headerName.size(), '\0');
+            std::transform(headerName.begin(), headerName.end(), lowercaseName.begin(), lower);
+            m_index.emplace_back(std::move(lowercaseName), value);
+        }
+        std::stable_sort(m_index.begin(),
+                         m_index.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+    }
+
+    Data(const Data&) = delete;
+    Data& operator=(const Data&) = delete;
+
+    /**
+     * @brief Finds a header in the index.
+     *
+     * @param name Header name, in any case.
+     * @return Index entry of the header, or the end of the index.
+     */
+    std::vector<std::pair<std::string, std::string_view>>::const_iterator find(std::string_view name) const
+    {
+        const auto it {std::lower_bound(m_index.cbegin(),
+                                        m_index.cend(),
+                                        name,
+                                        [](const auto& entry, std::string_view value)
+                                        { return compareName(entry.first, value) < 0; })};
+        return it != m_index.cend() && compareName(it->first, name) == 0 ? it : m_index.cend();
+    }
+};
+
+HeaderSet::HeaderSet(std::initializer_list<std::string> headers)
+{
+    if (headers.size() != 0)
+    {
+        m_data = std::make_shared<const Data>(std::set<std::string>(headers.begin(), headers.end()));
+    }
+}
+
+HeaderSet::HeaderSet(const std::unordered_set<std::string>& headers)
+{
+    if (!headers.empty())
+    {
+        m_data = std::make_shared<const Data>(std::set<std::string>(headers.begin(), headers.end()));
+    }
+}
+
+const HeaderSet& HeaderSet::defaults()
+{
+    static const HeaderSet defaultHeaders {DEFAULT_HEADERS};
+    return defaultHeaders;
+}
+
+std::string_view HeaderSet::name(std::string_view header)
+{
+    auto headerName {header.substr(0, header.find_first_of(":;"))};
+    while (!headerName.empty() && std::isspace(static_cast<unsigned char>(headerName.back())))
+    {
+        headerName.remove_suffix(1);
+    }
+    return headerName;
+}
+
+bool HeaderSet::contains(std::string_view name) const
+{
+    return m_data && m_data->find(name) != m_data->m_index.cend();
+}
+
+std::string_view HeaderSet::value(std::string_view name) const
+{
+    if (!m_data)
+    {
+        return {};
+    }
+
+    const auto it {m_data->find(name)};
+    return it != m_data->m_index.cend() ? it->second : std::string_view {};
+}
+
+size_t HeaderSet::size() const
+{
+    return m_data ? m_data->m_nodes.size() : 0;
+}
+
+const std::string& HeaderSet::key() const
+{
+    static const std::string emptyKey;
+    return m_data ? m_data->m_key : emptyKey;
+}
+
+const curl_slist* HeaderSet::list() const
+{
+    return m_data ? m_data->m_nodes.data() : nullptr;
+}
@@ -0,0 +1,46 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "IURLRequest.hpp"
+#include "parsedURL.hpp"
+#include <string>
+
+HttpURL::HttpURL(const std::string& url)
+{
+    m_socketType = SOCKET_TCP;
+    m_url = url;
+}
+
+HttpURL HttpURL::parse(const std::string& url)
+{
+    HttpURL parsedUrl {url};
+    parsedUrl.m_parsedUrl = ParsedURL::parse(url);
+    return parsedUrl;
+}
+
+HttpURL::HttpURL(const HttpURL& base, const QueryBuilder& query)
+{
+    m_socketType = SOCKET_TCP;
+    if (base.m_parsedUrl)
+    {
+        m_parsedUrl = base.m_parsedUrl->withQuery(query.str());
+    }
+
+    if (m_parsedUrl)
+    {
+        m_url = m_parsedUrl->url();
+    }
+    else
+    {
+        // Not parsed, or not a valid URL, which libcurl reports when the request is performed.
+        m_url = ParsedURL::appendQuery(base.m_url, query.str());
+    }
+}
@@ -12,8 +12,14 @@
 #ifndef _CURL_HANDLER_HPP
 #define _CURL_HANDLER_HPP
 
+#include "IURLRequest.hpp"
+#include "requestMetricsRegistry.hpp"
+#include <chrono>
+#include <cstdint>
 #include <curl/curl.h>
+#include <map>
 #include <memory>
+#include <string>
 
 //! ICURLHandler abstract class
 /**
@@ -23,8 +29,129 @@
 class ICURLHandler
 {
 protected:
-    std::shared_ptr<CURL> m_curlHandler;         ///< Pointer to the CURL handle.
-    const CurlHandlerTypeEnum m_curlHandlerType; ///< Enum value for this cURL handler.
+    std::shared_ptr<CURL> m_curlHandler;            ///< Pointer to the CURL handle.
+    const CurlHandlerTypeEnum m_curlHandlerType;    ///< Enum value for this cURL handler.
+    std::map<CURLoption, std::string> m_cacheFiles; ///< Files loaded into the caches kept across requests.
+    bool m_keepOptions {false};                     ///< Options are kept after each transfer.
+    long m_responseCode {0};                        ///< Status code of the last transfer.
+    TransferMetrics m_transferMetrics;              ///< Metrics of the last transfer.
+    std::string m_effectiveUrl;                     ///< URL of the last hop of the last transfer.
+
+    /**
+     * @brief Stores the information of the transfer, which curl_easy_reset clears, and hands it to the transfer
+     * observer.
+     */
+    void captureTransferInfo()
+    {
+        const auto handle {m_curlHandler.get()};
+        const auto microseconds {[handle](const CURLINFO info)
+                                 {
+                                     curl_off_t value {0};
+                                     curl_easy_getinfo(handle, info, &value);
+                                     return std::chrono::microseconds(value);
+                                 }};
+        const auto bytes {[handle](const CURLINFO info)
+                          {
+                              curl_off_t value {0};
+                              curl_easy_getinfo(handle, info, &value);
+                              return static_cast<uint64_t>(value);
+                          }};
+        long headerSize {0};
+        long connects {0};
+        long httpVersion {0};
+
+        m_responseCode = 0;
+        m_transferMetrics = {};
+        curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &m_responseCode);
+        curl_easy_getinfo(handle, CURLINFO_REDIRECT_COUNT, &m_transferMetrics.redirectCount);
+        m_transferMetrics.nameLookupTime = microseconds(CURLINFO_NAMELOOKUP_TIME_T);
+        m_transferMetrics.connectTime = microseconds(CURLINFO_CONNECT_TIME_T);
+        m_transferMetrics.appConnectTime = microseconds(CURLINFO_APPCONNECT_TIME_T);
+        m_transferMetrics.preTransferTime = microseconds(CURLINFO_PRETRANSFER_TIME_T);
+#if LIBCURL_VERSION_NUM >= 0x080600
+        m_transferMetrics.queueTime = microseconds(CURLINFO_QUEUE_TIME_T);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x080a00
+        m_transferMetrics.postTransferTime = microseconds(CURLINFO_POSTTRANSFER_TIME_T);
+#endif
+        m_transferMetrics.startTransferTime = microseconds(CURLINFO_STARTTRANSFER_TIME_T);
+        m_transferMetrics.totalTime = microseconds(CURLINFO_TOTAL_TIME_T);
+        m_transferMetrics.bytesReceived = bytes(CURLINFO_SIZE_DOWNLOAD_T);
+        m_transferMetrics.bytesSent = bytes(CURLINFO_SIZE_UPLOAD_T);
+        if (curl_easy_getinfo(handle, CURLINFO_HEADER_SIZE, &headerSize) == CURLE_OK)
+        {
+            m_transferMetrics.headerBytesReceived = headerSize;
+        }
+        // Only the connections that had to be opened are counted.
+        if (curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &connects) == CURLE_OK)
+        {
+            m_transferMetrics.connections = connects;
+        }
+        m_transferMetrics.connectionReused = m_responseCode != 0 && m_transferMetrics.connections == 0;
+        if (curl_easy_getinfo(handle, CURLINFO_HTTP_VERSION, &httpVersion) == CURLE_OK)
+        {
+            switch (httpVersion)
+            {
+                case CURL_HTTP_VERSION_1_0: m_transferMetrics.httpVersion = 10; break;
+                case CURL_HTTP_VERSION_1_1: m_transferMetrics.httpVersion = 11; break;
+                case CURL_HTTP_VERSION_2_0: m_transferMetrics.httpVersion = 20; break;
+                case CURL_HTTP_VERSION_3: m_transferMetrics.httpVersion = 30; break;
+                default: break;
+            }
+        }
+
+        char* effectiveUrl {nullptr};
+        if (curl_easy_getinfo(handle, CURLINFO_EFFECTIVE_URL, &effectiveUrl) == CURLE_OK && effectiveUrl != nullptr)
+        {
+            m_effectiveUrl.assign(effectiveUrl);
+        }
+        else
+        {
+            m_effectiveUrl.clear();
+        }
+
+        if (TransferObserver::enabled())
+        {
+            TransferObserver::notify(m_effectiveUrl, m_responseCode, m_transferMetrics);
+        }
+    }
+
+    /**
+     * @brief Creates the CURL handle of the handler. The handles alive are counted by the request metrics, so a leak
+     * shows up in them.
+     *
+     * @return std::shared_ptr<CURL> cURL handle.
+     */
+    static std::shared_ptr<CURL> createHandle()
+    {
+        std::shared_ptr<CURL> handle {curl_easy_init(),
+                                      [](CURL* curl)
+                                      {
+                                          if (curl != nullptr)
+                                          {
+                                              curl_easy_cleanup(curl);
+                                              RequestMetricsRegistry::handleDestroyed();
+                                          }
+                                      }};
+        if (handle)
+        {
+            RequestMetricsRegistry::handleCreated();
+        }
+        return handle;
+    }
+
+    /**
+     * @brief Resets the options of the handle after a transfer, unless they are kept for the next one. The information
+     * of the transfer is stored first.
+     */
+    void resetOptions()
+    {
+        captureTransferInfo();
+        if (!m_keepOptions)
+        {
+            curl_easy_reset(m_curlHandler.get());
+        }
+    }
 
 public:
     /**
@@ -54,6 +181,99 @@ public:
         return m_curlHandler;
     }
 
+    /**
+     * @brief Enables one of the caches that libcurl keeps in the handle across requests (HSTS, Alt-Svc), backed by the
+     * given file. libcurl reads the file when it's set and writes the cache back to it when the handle is cleaned up.
+     * The cache survives curl_easy_reset, so each file is loaded only once per handle.
+     *
+     * @param fileOption Option that sets the cache file.
+     * @param controlOption Option that enables the cache.
+     * @param controlValue Value of the control option.
+     * @param path Cache file.
+     * @return CURLcode Result of setting the options.
+     */
+    CURLcode setCacheFile(const CURLoption fileOption,
+                          const CURLoption controlOption,
+                          const long controlValue,
+                          const std::string& path)
+    {
+        auto& loadedPath {m_cacheFiles[fileOption]};
+        if (loadedPath == path)
+        {
+            return CURLE_OK;
+        }
+
+        auto result {curl_easy_setopt(m_curlHandler.get(), controlOption, controlValue)};
+        if (result == CURLE_OK)
+        {
+            result = curl_easy_setopt(m_curlHandler.get(), fileOption, path.c_str());
+        }
+        if (result == CURLE_OK)
+        {
+            loadedPath = path;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Checks whether the caches loaded into the handle are backed by the given files. libcurl can't disable
+     * them once loaded, so a handle with caches must only serve the requests that use the same files.
+     *
+     * @param hstsCachePath HSTS cache file, empty if none.
+     * @param altSvcCachePath Alt-Svc cache file, empty if none.
+     * @return true if the loaded caches are exactly the given ones.
+     */
+    [[nodiscard]] bool usesCacheFiles(const std::string& hstsCachePath, const std::string& altSvcCachePath) const
+    {
+        const auto loadedPath {[this](const CURLoption fileOption)
+                               {
+                                   const auto it {m_cacheFiles.find(fileOption)};
+                                   return it != m_cacheFiles.end() ? it->second : std::string {};
+                               }};
+        return loadedPath(CURLOPT_HSTS) == hstsCachePath && loadedPath(CURLOPT_ALTSVC) == altSvcCachePath;
+    }
+
+    /**
+     * @brief Keeps the options of the handle after each transfer, so a request configured once can be performed many
+     * times. The handle must not be shared with other requests.
+     *
+     * @param keepOptions Whether the options are kept.
+     */
+    void keepOptions(const bool keepOptions)
+    {
+        m_keepOptions = keepOptions;
+    }
+
+    /**
+     * @brief Returns the status code of the last transfer.
+     *
+     * @return long Status code, 0 if no response was received.
+     */
+    [[nodiscard]] long responseCode() const
+    {
+        return m_responseCode;
+    }
+
+    /**
+     * @brief Returns the metrics of the last transfer.
+     *
+     * @return const TransferMetrics& Transfer metrics.
+     */
+    [[nodiscard]] const TransferMetrics& transferMetrics() const
+    {
+        return m_transferMetrics;
+    }
+
+    /**
+     * @brief Returns the URL of the last hop of the last transfer.
+     *
+     * @return const std::string& Effective URL.
+     */
+    [[nodiscard]] const std::string& effectiveUrl() const
+    {
+        return m_effectiveUrl;
+    }
+
     /**
      * @brief Returns the type of the cURL handler.
      *
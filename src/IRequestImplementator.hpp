@@ -12,7 +12,16 @@
 #ifndef _IREQUEST_IMPLEMENTATOR_HPP
 #define _IREQUEST_IMPLEMENTATOR_HPP
 
+#include <array>
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <utility>
+
+class HeaderSet;
+class IRequestObserver;
+class Response;
 
 enum OPTION_REQUEST_TYPE
 {
@@ -32,9 +41,103 @@ enum OPTION_REQUEST_TYPE
     OPT_VERIFYPEER,
     OPT_SSL_CERT,
     OPT_SSL_KEY,
-    OPT_BASIC_AUTH
+    OPT_BASIC_AUTH,
+    OPT_HSTS,
+    OPT_ALTSVC,
+    OPT_HTTP_VERSION,
+    OPT_CURLU,
+    OPT_NOBODY,
+    OPT_COUNT ///< Number of options, keep it last.
 };
 
+enum OPTION_VALUE_TYPE
+{
+    VALUE_STRING,
+    VALUE_LONG,
+    VALUE_POINTER
+};
+
+/**
+ * @brief Checks at compile time that a table has one entry per key, sorted by key, so it can be indexed by the key.
+ *
+ * @param table Table of pairs whose first member is the key.
+ * @param size Number of keys.
+ * @return true if the entry of each key is at its index.
+ */
+template<typename TTable>
+constexpr bool isIndexedByKey(const TTable& table, const size_t size)
+{
+    for (size_t i = 0; i < table.size(); ++i)
+    {
+        if (static_cast<size_t>(table[i].first) != i)
+        {
+            return false;
+        }
+    }
+    return table.size() == size;
+}
+
+// Type of the value taken by each option.
+constexpr std::array<std::pair<OPTION_REQUEST_TYPE, OPTION_VALUE_TYPE>, OPT_COUNT> OPTION_VALUE_TYPE_MAP {{
+    {OPT_URL, VALUE_STRING},
+    {OPT_CAINFO, VALUE_STRING},
+    {OPT_TIMEOUT_MS, VALUE_LONG},
+    {OPT_WRITEDATA, VALUE_POINTER},
+    {OPT_USERAGENT, VALUE_STRING},
+    {OPT_POSTFIELDS, VALUE_STRING},
+    {OPT_WRITEFUNCTION, VALUE_POINTER},
+    {OPT_POSTFIELDSIZE, VALUE_LONG},
+    {OPT_CUSTOMREQUEST, VALUE_STRING},
+    {OPT_UNIX_SOCKET_PATH, VALUE_STRING},
+    {OPT_FAILONERROR, VALUE_LONG},
+    {OPT_FOLLOW_REDIRECT, VALUE_LONG},
+    {OPT_MAX_REDIRECTIONS, VALUE_LONG},
+    {OPT_VERIFYPEER, VALUE_LONG},
+    {OPT_SSL_CERT, VALUE_STRING},
+    {OPT_SSL_KEY, VALUE_STRING},
+    {OPT_BASIC_AUTH, VALUE_STRING},
+    {OPT_HSTS, VALUE_STRING},
+    {OPT_ALTSVC, VALUE_STRING},
+    {OPT_HTTP_VERSION, VALUE_LONG},
+    {OPT_CURLU, VALUE_POINTER},
+    {OPT_NOBODY, VALUE_LONG}}};
+
+static_assert(isIndexedByKey(OPTION_VALUE_TYPE_MAP, OPT_COUNT),
+              "OPTION_VALUE_TYPE_MAP must have one entry per option, in the order of OPTION_REQUEST_TYPE");
+
+/**
+ * @brief Type of the value taken by an option, as passed to IRequestImplementator::setOption.
+ */
+template<OPTION_REQUEST_TYPE optIndex>
+using OptionValueType = std::conditional_t<
+    OPTION_VALUE_TYPE_MAP[optIndex].second == VALUE_STRING,
+    std::string,
+    std::conditional_t<OPTION_VALUE_TYPE_MAP[optIndex].second == VALUE_LONG, long, void*>>;
+
+/**
+ * @brief Converts a value to the type taken by an option, checking at compile time that it can be converted. A value
+ * that already has that type is passed through without a copy.
+ *
+ * @tparam optIndex The option index.
+ * @param value The option value.
+ * @return The value, as the type taken by the option.
+ */
+template<OPTION_REQUEST_TYPE optIndex, typename TValue>
+decltype(auto) optionValue(TValue&& value)
+{
+    using TOption = OptionValueType<optIndex>;
+    static_assert(std::is_constructible_v<TOption, TValue>, "The value doesn't have the type taken by the option");
+
+    if constexpr (std::is_same_v<std::decay_t<TValue>, TOption>)
+    {
+        return std::forward<TValue>(value);
+    }
+    else
+    {
+        return static_cast<TOption>(std::forward<TValue>(value));
+    }
+}
+
 /**
  * @brief This class is a interface for IRequestImplementator.
  * It provides a simple interface to perform HTTP requests.
@@ -43,6 +146,19 @@ class IRequestImplementator
 {
 public:
     virtual ~IRequestImplementator() = default;
+
+    /**
+     * @brief Sets an option, checking at compile time that the value has the type the option takes.
+     *
+     * @tparam optIndex The option index.
+     * @param value The option value.
+     */
+    template<OPTION_REQUEST_TYPE optIndex, typename TValue>
+    void setOption(TValue&& value)
+    {
+        setOption(optIndex, optionValue<optIndex>(std::forward<TValue>(value)));
+    }
+
     /**
      * @brief Virtual method to set options to the handle.
      * @param optIndex The option index.
@@ -75,11 +191,37 @@ public:
      */
     virtual inline const std::string response() = 0;
 
+    /**
+     * @brief Virtual method to move the status, headers, body and metrics of the last request into a response.
+     * @return The response of the last request.
+     */
+    virtual Response takeResponse() = 0;
+
     /**
      * @brief Virtual method to add a header to the handle.
      * @param header The header to be added.
      */
     virtual void appendHeader(const std::string& header) = 0;
+
+    /**
+     * @brief Virtual method to set a compiled set of headers. The headers added with appendHeader are sent on top of
+     * the set.
+     * @param headers The set of headers, kept until the request is performed.
+     */
+    virtual void setHeaders(const HeaderSet& headers) = 0;
+
+    /**
+     * @brief Virtual method to get the target of the permanent redirects (301 or 308) that the last request followed
+     * before any other response.
+     * @return The URL the request was permanently redirected to, or an empty string.
+     */
+    virtual const std::string permanentRedirect() = 0;
+
+    /**
+     * @brief Virtual method to set the observer of the lifecycle of the request, instead of the global one.
+     * @param observer The observer, kept until the implementator is reset.
+     */
+    virtual void setObserver(std::shared_ptr<IRequestObserver> observer) = 0;
 };
 
 #endif // _IREQUEST_IMPLEMENTATOR_HPP
@@ -0,0 +1,170 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "inFlightRequests.hpp"
+#include "inFlightRequestTable.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <semaphore.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+std::mutex g_signalMutex; ///< Guards the file written on a signal.
+std::string g_signalPath; ///< File written on a signal.
+sem_t g_signalSemaphore;  ///< Posted by the signal handler to wake up the writer thread.
+
+/**
+ * @brief Signal handler, wakes up the writer thread. sem_post is async-signal-safe.
+ */
+void signalHandler(int)
+{
+    const auto savedErrno {errno};
+    sem_post(&g_signalSemaphore);
+    errno = savedErrno;
+}
+
+/**
+ * @brief Writes the requests being performed each time the semaphore is posted. Errors are ignored, the list is
+ * written again on the next signal.
+ */
+void signalWriter()
+{
+    while (true)
+    {
+        if (sem_wait(&g_signalSemaphore) != 0)
+        {
+            continue;
+        }
+
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock(g_signalMutex);
+            path = g_signalPath;
+        }
+
+        try
+        {
+            InFlightRequests::write(path);
+        }
+        catch (...)
+        {
+        }
+    }
+}
+} // namespace
+
+void InFlightRequests::enable()
+{
+    InFlightRequestTable::enable();
+}
+
+void InFlightRequests::disable()
+{
+    InFlightRequestTable::disable();
+}
+
+bool InFlightRequests::enabled()
+{
+    return InFlightRequestTable::enabled();
+}
+
+nlohmann::json InFlightRequests::json()
+{
+    const auto steadyNow {std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())};
+    const auto systemNow {std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch())};
+
+    std::vector<std::pair<std::chrono::microseconds, nlohmann::json>> requests;
+    const auto& table {InFlightRequestTable::instance()};
+    table.read(
+        [&](const InFlightRequest& request)
+        {
+            const auto elapsed {std::max(steadyNow - request.start, std::chrono::microseconds(0))};
+            auto entry = nlohmann::json::object();
+            entry["method"] = request.method;
+            entry["url"] = request.url;
+            entry["thread"] = request.threadId;
+            entry["start_us"] = (systemNow - elapsed).count();
+            entry["elapsed_us"] = elapsed.count();
+            entry["bytes_received"] = request.bytesReceived;
+            entry["bytes_sent"] = request.bytesSent;
+            entry["handler"] = HANDLER_TYPE_NAMES[static_cast<size_t>(request.handlerType)].second;
+            requests.emplace_back(request.start, std::move(entry));
+        });
+    std::stable_sort(requests.begin(),
+                     requests.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    auto result = nlohmann::json::object();
+    result["requests"] = nlohmann::json::array();
+    for (auto& [start, entry] : requests)
+    {
+        result["requests"].push_back(std::move(entry));
+    }
+    result["untracked"] = table.untracked();
+    return result;
+}
+
+void InFlightRequests::write(const std::string& path)
+{
+    const auto temporaryPath {path + ".tmp"};
+    {
+        std::ofstream file {temporaryPath, std::ios::trunc};
+        // The URLs aren't guaranteed to be valid UTF-8.
+        if (!file || !(file << json().dump(-1, ' ', false, nlohmann::json::error_handler_t::replace)))
+        {
+            throw std::runtime_error("Couldn't write the in-flight requests to: " + temporaryPath);
+        }
+    }
+    std::filesystem::rename(temporaryPath, path);
+}
+
+void InFlightRequests::writeOnSignal(const int signalNumber, const std::string& path)
+{
+    static std::once_flag started;
+    std::call_once(started,
+                   []()
+                   {
+                       if (sem_init(&g_signalSemaphore, 0, 0) != 0)
+                       {
+                           throw std::runtime_error("Couldn't create the semaphore of the in-flight requests writer");
+                       }
+                       // The thread waits for the signals until the process exits.
+                       std::thread(signalWriter).detach();
+                   });
+
+    {
+        std::lock_guard<std::mutex> lock(g_signalMutex);
+        g_signalPath = path;
+    }
+    InFlightRequestTable::enable();
+
+    struct sigaction action
+    {
+    };
+    action.sa_handler = signalHandler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    if (sigaction(signalNumber, &action, nullptr) != 0)
+    {
+        throw std::runtime_error("Couldn't set the handler of signal " + std::to_string(signalNumber));
+    }
+}
@@ -0,0 +1,206 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "requestMetrics.hpp"
+#include "requestMetricsRegistry.hpp"
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+// Upper bounds, in seconds, of the buckets of the Prometheus latency histogram.
+constexpr std::array<std::pair<std::string_view, uint64_t>, 12> PROMETHEUS_LATENCY_BUCKETS {{
+    {"0.001", 1000},
+    {"0.005", 5000},
+    {"0.01", 10000},
+    {"0.025", 25000},
+    {"0.05", 50000},
+    {"0.1", 100000},
+    {"0.25", 250000},
+    {"0.5", 500000},
+    {"1", 1000000},
+    {"2.5", 2500000},
+    {"5", 5000000},
+    {"10", 10000000}}};
+
+/**
+ * @brief Escapes a Prometheus label value.
+ *
+ * @param value Label value.
+ * @return std::string Escaped value.
+ */
+std::string escapeLabel(std::string_view value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (const auto c : value)
+    {
+        switch (c)
+        {
+            case '\\': escaped.append("\\\\"); break;
+            case '"': escaped.append("\\\""); break;
+            case '\n': escaped.append("\\n"); break;
+            default: escaped.push_back(c);
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief Writes the header of a Prometheus metric.
+ *
+ * @param out Output stream.
+ * @param name Metric name.
+ * @param type Metric type.
+ * @param help Metric description.
+ */
+void metricHeader(std::ostream& out, std::string_view name, std::string_view type, std::string_view help)
+{
+    out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+}
+
+std::string exportMetrics(const MetricsFormat format)
+{
+    return format == MetricsFormat::PROMETHEUS ? RequestMetrics::prometheus() : RequestMetrics::json().dump();
+}
+} // namespace
+
+nlohmann::json RequestMetrics::json()
+{
+    const auto snapshot {RequestMetricsRegistry::instance().snapshot()};
+    const auto& latency {snapshot.m_latency};
+
+    auto requests = nlohmann::json::array();
+    uint64_t total {0};
+    for (const auto& [labels, count] : snapshot.m_requests)
+    {
+        nlohmann::json request;
+        request["method"] = labels.method;
+        request["status"] = labels.status;
+        request["host"] = labels.host;
+        request["count"] = count;
+        requests.push_back(std::move(request));
+        total += count;
+    }
+
+    nlohmann::json metrics;
+    metrics["requests"]["total"] = total;
+    metrics["requests"]["in_flight"] = snapshot.m_inFlight;
+    metrics["requests"]["by_label"] = requests;
+    metrics["bytes"]["received"] = snapshot.m_bytesReceived;
+    metrics["bytes"]["sent"] = snapshot.m_bytesSent;
+    metrics["connections"]["reused"] = snapshot.m_reusedConnections;
+    metrics["connections"]["reuse_ratio"] =
+        snapshot.m_transfers != 0
+            ? static_cast<double>(snapshot.m_reusedConnections) / static_cast<double>(snapshot.m_transfers)
+            : 0.0;
+    metrics["handler_cache"]["hits"] = snapshot.m_handlerCacheHits;
+    metrics["handler_cache"]["misses"] = snapshot.m_handlerCacheMisses;
+    metrics["handler_cache"]["evictions"] = snapshot.m_handlerCacheEvictions;
+    metrics["handles"]["live"] = snapshot.m_liveHandles;
+    metrics["latency_us"]["count"] = latency.m_count;
+    metrics["latency_us"]["sum"] = latency.m_sum;
+    metrics["latency_us"]["max"] = latency.m_max;
+    metrics["latency_us"]["p50"] = latency.percentile(50);
+    metrics["latency_us"]["p90"] = latency.percentile(90);
+    metrics["latency_us"]["p99"] = latency.percentile(99);
+    metrics["latency_us"]["p999"] = latency.percentile(99.9);
+    return metrics;
+}
+
+std::string RequestMetrics::prometheus()
+{
+    const auto snapshot {RequestMetricsRegistry::instance().snapshot()};
+    const auto& latency {snapshot.m_latency};
+    std::ostringstream out;
+    // The default precision of 6 digits would drop the microseconds of the sums over a second.
+    out << std::setprecision(17);
+
+    metricHeader(out, "urlrequest_requests_total", "counter", "Requests performed, by method, status and host.");
+    for (const auto& [labels, count] : snapshot.m_requests)
+    {
+        out << "urlrequest_requests_total{method=\"" << escapeLabel(labels.method) << "\",status=\"" << labels.status
+            << "\",host=\"" << escapeLabel(labels.host) << "\"} " << count << '\n';
+    }
+
+    metricHeader(out, "urlrequest_requests_in_flight", "gauge", "Requests being performed.");
+    out << "urlrequest_requests_in_flight " << snapshot.m_inFlight << '\n';
+
+    metricHeader(out, "urlrequest_received_bytes_total", "counter", "Bytes of the response bodies.");
+    out << "urlrequest_received_bytes_total " << snapshot.m_bytesReceived << '\n';
+
+    metricHeader(out, "urlrequest_sent_bytes_total", "counter", "Bytes of the request bodies.");
+    out << "urlrequest_sent_bytes_total " << snapshot.m_bytesSent << '\n';
+
+    metricHeader(out, "urlrequest_transfers_total", "counter", "Transfers performed.");
+    out << "urlrequest_transfers_total " << snapshot.m_transfers << '\n';
+
+    metricHeader(out, "urlrequest_reused_connections_total", "counter", "Transfers over a reused connection.");
+    out << "urlrequest_reused_connections_total " << snapshot.m_reusedConnections << '\n';
+
+    metricHeader(
+        out, "urlrequest_handler_cache_events_total", "counter", "Lookups and evictions of the handler cache.");
+    out << "urlrequest_handler_cache_events_total{event=\"hit\"} " << snapshot.m_handlerCacheHits << '\n'
+        << "urlrequest_handler_cache_events_total{event=\"miss\"} " << snapshot.m_handlerCacheMisses << '\n'
+        << "urlrequest_handler_cache_events_total{event=\"eviction\"} " << snapshot.m_handlerCacheEvictions << '\n';
+
+    metricHeader(out, "urlrequest_live_handles", "gauge", "cURL handles alive.");
+    out << "urlrequest_live_handles " << snapshot.m_liveHandles << '\n';
+
+    // A bucket of the histogram is counted when all its latencies are within the Prometheus bucket.
+    metricHeader(out, "urlrequest_request_duration_seconds", "histogram", "Duration of the transfers.");
+    size_t bucket {0};
+    uint64_t cumulative {0};
+    for (const auto& [bound, microseconds] : PROMETHEUS_LATENCY_BUCKETS)
+    {
+        for (; bucket < LATENCY_BUCKETS && LatencyHistogram::upperBound(bucket) <= microseconds; ++bucket)
+        {
+            cumulative += latency.m_counts[bucket];
+        }
+        out << "urlrequest_request_duration_seconds_bucket{le=\"" << bound << "\"} " << cumulative << '\n';
+    }
+    out << "urlrequest_request_duration_seconds_bucket{le=\"+Inf\"} " << latency.m_count << '\n'
+        << "urlrequest_request_duration_seconds_sum " << static_cast<double>(latency.m_sum) / 1e6 << '\n'
+        << "urlrequest_request_duration_seconds_count " << latency.m_count << '\n';
+
+    return out.str();
+}
+
+void RequestMetrics::write(const std::string& path, const MetricsFormat format)
+{
+    const auto temporaryPath {path + ".tmp"};
+    {
+        std::ofstream file {temporaryPath, std::ios::trunc};
+        if (!file || !(file << exportMetrics(format)))
+        {
+            throw std::runtime_error("Couldn't write the request metrics to: " + temporaryPath);
+        }
+    }
+    std::filesystem::rename(temporaryPath, path);
+}
+
+void RequestMetrics::report(const std::function<void(const std::string&)>& callback, const MetricsFormat format)
+{
+    callback(exportMetrics(format));
+}
+
+void RequestMetrics::reset()
+{
+    RequestMetricsRegistry::instance().reset();
+}
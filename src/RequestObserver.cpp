@@ -0,0 +1,61 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "IURLRequest.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+namespace
+{
+std::atomic<bool> g_enabled {false};          ///< A global observer is set, read on every request.
+std::shared_mutex g_mutex;                    ///< Guards the global observer.
+std::shared_ptr<IRequestObserver> g_observer; ///< Global observer.
+} // namespace
+
+void IRequestObserver::onStart(const RequestEvent& /*event*/) {}
+
+void IRequestObserver::onDnsDone(const RequestEvent& /*event*/) {}
+
+void IRequestObserver::onConnected(const RequestEvent& /*event*/) {}
+
+void IRequestObserver::onTlsDone(const RequestEvent& /*event*/) {}
+
+void IRequestObserver::onFirstByte(const RequestEvent& /*event*/) {}
+
+void IRequestObserver::onComplete(const RequestEvent& /*event*/,
+                                  const long /*status*/,
+                                  const TransferMetrics& /*metrics*/)
+{
+}
+
+void IRequestObserver::onError(const RequestEvent& /*event*/, std::string_view /*message*/, const long /*status*/) {}
+
+void IRequestObserver::setGlobal(std::shared_ptr<IRequestObserver> observer)
+{
+    std::unique_lock<std::shared_mutex> lock(g_mutex);
+    g_observer = std::move(observer);
+    g_enabled.store(g_observer != nullptr, std::memory_order_release);
+}
+
+std::shared_ptr<IRequestObserver> IRequestObserver::global()
+{
+    // Without a global observer, the lock isn't taken.
+    if (!g_enabled.load(std::memory_order_acquire))
+    {
+        return nullptr;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(g_mutex);
+    return g_observer;
+}
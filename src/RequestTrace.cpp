@@ -0,0 +1,131 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "requestTrace.hpp"
+#include "requestTracer.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+std::mutex g_exitPathMutex; ///< Guards the file written at exit.
+std::string g_exitPath;     ///< File written at exit, empty to not write it.
+
+/**
+ * @brief Writes the trace to the file set for the exit, if any. Errors are ignored, the process is exiting.
+ */
+void writeAtExitHandler()
+{
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(g_exitPathMutex);
+        path = g_exitPath;
+    }
+
+    if (!path.empty())
+    {
+        try
+        {
+            RequestTrace::write(path);
+        }
+        catch (...)
+        {
+        }
+    }
+}
+} // namespace
+
+void RequestTrace::enable(const size_t capacity)
+{
+    RequestTracer::instance().enable(capacity);
+}
+
+void RequestTrace::disable()
+{
+    RequestTracer::instance().disable();
+}
+
+bool RequestTrace::enabled()
+{
+    return RequestTracer::enabled();
+}
+
+void RequestTrace::clear()
+{
+    RequestTracer::instance().clear();
+}
+
+nlohmann::json RequestTrace::json()
+{
+    const auto pid {static_cast<int64_t>(getpid())};
+    auto events = nlohmann::json::array();
+    RequestTracer::instance().read(
+        [&events, pid](const TraceEvent& event)
+        {
+            auto traceEvent = nlohmann::json::object();
+            traceEvent["name"] = event.name;
+            traceEvent["cat"] = event.category;
+            traceEvent["ph"] = "X";
+            traceEvent["ts"] = event.start.count();
+            traceEvent["dur"] = event.duration.count();
+            traceEvent["pid"] = pid;
+            traceEvent["tid"] = event.threadId;
+            if (event.detailName != nullptr)
+            {
+                traceEvent["args"][event.detailName] = event.detail;
+            }
+            if (event.status != 0)
+            {
+                traceEvent["args"]["status"] = event.status;
+            }
+            events.push_back(std::move(traceEvent));
+        });
+
+    auto trace = nlohmann::json::object();
+    trace["traceEvents"] = std::move(events);
+    trace["displayTimeUnit"] = "ms";
+    return trace;
+}
+
+void RequestTrace::write(const std::string& path)
+{
+    const auto temporaryPath {path + ".tmp"};
+    {
+        std::ofstream file {temporaryPath, std::ios::trunc};
+        // The details, like URLs, aren't guaranteed to be valid UTF-8.
+        if (!file || !(file << json().dump(-1, ' ', false, nlohmann::json::error_handler_t::replace)))
+        {
+            throw std::runtime_error("Couldn't write the request trace to: " + temporaryPath);
+        }
+    }
+    std::filesystem::rename(temporaryPath, path);
+}
+
+void RequestTrace::writeAtExit(const std::string& path)
+{
+    static std::once_flag registered;
+    {
+        std::lock_guard<std::mutex> lock(g_exitPathMutex);
+        g_exitPath = path;
+    }
+    std::call_once(registered,
+                   []()
+                   {
+                       // The tracer is constructed first, so it's destroyed after the trace is written.
+                       RequestTracer::instance();
+                       std::atexit(writeAtExitHandler);
+                   });
+}
@@ -0,0 +1,131 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "IURLRequest.hpp"
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+/**
+ * @brief Compares two header names, which are case insensitive.
+ *
+ * @param a First name.
+ * @param b Second name.
+ * @return int Negative, zero or positive if the first name sorts before, equal or after the second one.
+ */
+int compareName(std::string_view a, std::string_view b)
+{
+    const auto size {std::min(a.size(), b.size())};
+    for (size_t i = 0; i < size; ++i)
+    {
+        const auto x {std::tolower(static_cast<unsigned char>(a[i]))};
+        const auto y {std::tolower(static_cast<unsigned char>(b[i]))};
+        if (x != y)
+        {
+            return x < y ? -1 : 1;
+        }
+    }
+    return a.size() == b.size() ? 0 : (a.size() < b.size() ? -1 : 1);
+}
+
+std::string_view trim(std::string_view value)
+{
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.front())))
+    {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back())))
+    {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+using Entry = std::pair<std::string_view, std::string_view>;
+
+/**
+ * @brief Returns the range of the entries of a header.
+ *
+ * @param entries Entries sorted by name.
+ * @param name Header name, in any case.
+ * @return Range of the entries with the name.
+ */
+std::pair<std::vector<Entry>::const_iterator, std::vector<Entry>::const_iterator>
+findName(const std::vector<Entry>& entries, std::string_view name)
+{
+    return {std::lower_bound(entries.cbegin(),
+                             entries.cend(),
+                             name,
+                             [](const Entry& entry, std::string_view value)
+                             { return compareName(entry.first, value) < 0; }),
+            std::upper_bound(entries.cbegin(),
+                             entries.cend(),
+                             name,
+                             [](std::string_view value, const Entry& entry)
+                             { return compareName(value, entry.first) < 0; })};
+}
+} // namespace
+
+ResponseHeaders::ResponseHeaders(std::vector<char> buffer)
+    : m_buffer {std::move(buffer)}
+{
+    constexpr std::string_view STATUS_PREFIX {"HTTP/"};
+    std::string_view lines {m_buffer.data(), m_buffer.size()};
+    m_entries.reserve(std::count(m_buffer.cbegin(), m_buffer.cend(), '\n'));
+    while (!lines.empty())
+    {
+        const auto end {lines.find('\n')};
+        const auto line {lines.substr(0, end)};
+        lines.remove_prefix(end == std::string_view::npos ? lines.size() : end + 1);
+
+        const auto colon {line.find(':')};
+        if (colon == std::string_view::npos || line.substr(0, STATUS_PREFIX.size()) == STATUS_PREFIX)
+        {
+            continue;
+        }
+
+        if (const auto name {trim(line.substr(0, colon))}; !name.empty())
+        {
+            m_entries.emplace_back(name, trim(line.substr(colon + 1)));
+        }
+    }
+
+    // Stable, so the values of a repeated header keep the order they were received in.
+    std::stable_sort(m_entries.begin(),
+                     m_entries.end(),
+                     [](const Entry& a, const Entry& b) { return compareName(a.first, b.first) < 0; });
+}
+
+bool ResponseHeaders::contains(std::string_view name) const
+{
+    const auto [first, last] {findName(m_entries, name)};
+    return first != last;
+}
+
+std::string_view ResponseHeaders::value(std::string_view name) const
+{
+    const auto [first, last] {findName(m_entries, name)};
+    return first != last ? first->second : std::string_view {};
+}
+
+std::vector<std::string_view> ResponseHeaders::values(std::string_view name) const
+{
+    const auto [first, last] {findName(m_entries, name)};
+    std::vector<std::string_view> result;
+    result.reserve(std::distance(first, last));
+    std::transform(first, last, std::back_inserter(result), [](const Entry& entry) { return entry.second; });
+    return result;
+}
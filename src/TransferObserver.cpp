@@ -0,0 +1,62 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "IURLRequest.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+namespace
+{
+std::atomic<bool> g_enabled {false};                          ///< An observer is set, read on every transfer.
+std::shared_mutex g_mutex;                                    ///< Guards the observer.
+std::shared_ptr<const TransferObserver::Callback> g_observer; ///< Observer, kept alive while it's being called.
+} // namespace
+
+void TransferObserver::set(Callback callback)
+{
+    std::unique_lock<std::shared_mutex> lock(g_mutex);
+    g_observer = callback ? std::make_shared<const Callback>(std::move(callback)) : nullptr;
+    g_enabled.store(g_observer != nullptr, std::memory_order_release);
+}
+
+bool TransferObserver::enabled()
+{
+    return g_enabled.load(std::memory_order_acquire);
+}
+
+void TransferObserver::notify(std::string_view url, const long status, const TransferMetrics& metrics)
+{
+    if (!enabled())
+    {
+        return;
+    }
+
+    std::shared_ptr<const Callback> observer;
+    {
+        std::shared_lock<std::shared_mutex> lock(g_mutex);
+        observer = g_observer;
+    }
+
+    if (observer)
+    {
+        try
+        {
+            (*observer)(url, status, metrics);
+        }
+        catch (...)
+        {
+            // The observer must not change the result of the request.
+        }
+    }
+}
@@ -11,12 +11,14 @@
 
 #include "UNIXSocketRequest.hpp"
 #include "factoryRequestImplemetator.hpp"
+#include "requestTracer.hpp"
 #include "urlRequest.hpp"
 #include <atomic>
 #include <string>
 #include <unordered_set>
 
 using wrapperType = cURLWrapper;
+using factoryType = FactoryRequestWrapper<wrapperType>;
 
 void UNIXSocketRequest::download(RequestParameters requestParameters,
                                  PostRequestParameters postRequestParameters = {},
@@ -35,14 +37,16 @@ void UNIXSocketRequest::download(RequestParameters requestParameters,
     const auto& userAgent {configurationParameters.userAgent};
     const auto& handlerType {configurationParameters.handlerType};
     const auto& shouldRun {configurationParameters.shouldRun};
+    const auto& observer {configurationParameters.observer};
 
     try
     {
-        GetRequest::builder(FactoryRequestWrapper<wrapperType>::create(handlerType, shouldRun))
+        BasicGetRequest<wrapperType>::builder(factoryType::acquire(handlerType, shouldRun))
             .url(url.url(), secureCommunication)
             .unixSocketPath(url.unixSocketPath())
             .timeout(timeout)
             .userAgent(userAgent)
+            .observer(observer)
             .outputFile(outputFile)
             .execute();
     }
@@ -81,12 +85,14 @@ void UNIXSocketRequest::post(RequestParameters requestParameters,
     // Post request parameters
     const auto& onError {postRequestParameters.onError};
     const auto& onSuccess {postRequestParameters.onSuccess};
+    const auto& onResponse {postRequestParameters.onResponse};
     const auto& outputFile {postRequestParameters.outputFile};
     // Configuration parameters
     const auto& timeout {configurationParameters.timeout};
     const auto& userAgent {configurationParameters.userAgent};
     const auto& handlerType {configurationParameters.handlerType};
     const auto& shouldRun {configurationParameters.shouldRun};
+    const auto& observer {configurationParameters.observer};
 
     try
     {
@@ -94,16 +100,24 @@ void UNIXSocketRequest::post(RequestParameters requestParameters,
                                      ? std::get<std::string>(requestParameters.data)
                                      : std::get<nlohmann::json>(requestParameters.data).dump();
 
-        auto req {PostRequest::builder(FactoryRequestWrapper<wrapperType>::create(handlerType, shouldRun))};
+        auto req {BasicPostRequest<wrapperType>::builder(factoryType::acquire(handlerType, shouldRun))};
         req.url(url.url(), secureCommunication)
             .unixSocketPath(url.unixSocketPath())
             .timeout(timeout)
             .userAgent(userAgent)
+            .observer(observer)
             .postData(data)
             .outputFile(outputFile)
             .execute();
 
-        onSuccess(req.response());
+        if (onResponse)
+        {
+            RequestTracer::callback(onResponse, req.takeResponse());
+        }
+        else
+        {
+            RequestTracer::callback(onSuccess, req.response());
+        }
     }
     catch (const Curl::CurlException& ex)
     {
@@ -140,24 +154,34 @@ void UNIXSocketRequest::get(RequestParameters requestParameters,
     // Post request parameters
     const auto& onError {postRequestParameters.onError};
     const auto& onSuccess {postRequestParameters.onSuccess};
+    const auto& onResponse {postRequestParameters.onResponse};
     const auto& outputFile {postRequestParameters.outputFile};
     // Configuration parameters
     const auto& timeout {configurationParameters.timeout};
     const auto& userAgent {configurationParameters.userAgent};
     const auto& handlerType {configurationParameters.handlerType};
     const auto& shouldRun {configurationParameters.shouldRun};
+    const auto& observer {configurationParameters.observer};
 
     try
     {
-        auto req {GetRequest::builder(FactoryRequestWrapper<wrapperType>::create(handlerType, shouldRun))};
+        auto req {BasicGetRequest<wrapperType>::builder(factoryType::acquire(handlerType, shouldRun))};
         req.url(url.url(), secureCommunication)
             .unixSocketPath(url.unixSocketPath())
             .timeout(timeout)
             .userAgent(userAgent)
+            .observer(observer)
             .outputFile(outputFile)
             .execute();
 
-        onSuccess(req.response());
+        if (onResponse)
+        {
+            RequestTracer::callback(onResponse, req.takeResponse());
+        }
+        else
+        {
+            RequestTracer::callback(onSuccess, req.response());
+        }
     }
     catch (const Curl::CurlException& ex)
     {
@@ -194,12 +218,14 @@ void UNIXSocketRequest::put(RequestParameters requestParameters,
     // Post request parameters
     const auto& onError {postRequestParameters.onError};
     const auto& onSuccess {postRequestParameters.onSuccess};
+    const auto& onResponse {postRequestParameters.onResponse};
     const auto& outputFile {postRequestParameters.outputFile};
     // Configuration parameters
     const auto& timeout {configurationParameters.timeout};
     const auto& userAgent {configurationParameters.userAgent};
     const auto& handlerType {configurationParameters.handlerType};
     const auto& shouldRun {configurationParameters.shouldRun};
+    const auto& observer {configurationParameters.observer};
 
     try
     {
@@ -207,16 +233,24 @@ void UNIXSocketRequest::put(RequestParameters requestParameters,
                                      ? std::get<std::string>(requestParameters.data)
                                      : std::get<nlohmann::json>(requestParameters.data).dump();
 
-        auto req {PutRequest::builder(FactoryRequestWrapper<wrapperType>::create(handlerType, shouldRun))};
+        auto req {BasicPutRequest<wrapperType>::builder(factoryType::acquire(handlerType, shouldRun))};
         req.url(url.url(), secureCommunication)
             .unixSocketPath(url.unixSocketPath())
             .timeout(timeout)
             .userAgent(userAgent)
+            .observer(observer)
             .postData(data)
             .outputFile(outputFile)
             .execute();
 
-        onSuccess(req.response());
+        if (onResponse)
+        {
+            RequestTracer::callback(onResponse, req.takeResponse());
+        }
+        else
+        {
+            RequestTracer::callback(onSuccess, req.response());
+        }
     }
     catch (const Curl::CurlException& ex)
     {
@@ -253,12 +287,14 @@ void UNIXSocketRequest::patch(RequestParameters requestParameters,
     // Post request parameters
     const auto& onError {postRequestParameters.onError};
     const auto& onSuccess {postRequestParameters.onSuccess};
+    const auto& onResponse {postRequestParameters.onResponse};
     const auto& outputFile {postRequestParameters.outputFile};
     // Configuration parameters
     const auto& timeout {configurationParameters.timeout};
     const auto& userAgent {configurationParameters.userAgent};
     const auto& handlerType {configurationParameters.handlerType};
     const auto& shouldRun {configurationParameters.shouldRun};
+    const auto& observer {configurationParameters.observer};
 
     try
     {
@@ -266,16 +302,24 @@ void UNIXSocketRequest::patch(RequestParameters requestParameters,
                                      ? std::get<std::string>(requestParameters.data)
                                      : std::get<nlohmann::json>(requestParameters.data).dump();
 
-        auto req {PatchRequest::builder(FactoryRequestWrapper<wrapperType>::create(handlerType, shouldRun))};
+        auto req {BasicPatchRequest<wrapperType>::builder(factoryType::acquire(handlerType, shouldRun))};
         req.url(url.url(), secureCommunication)
             .unixSocketPath(url.unixSocketPath())
             .timeout(timeout)
             .userAgent(userAgent)
+            .observer(observer)
             .postData(data)
             .outputFile(outputFile)
             .execute();
 
-        onSuccess(req.response());
+        if (onResponse)
+        {
+            RequestTracer::callback(onResponse, req.takeResponse());
+        }
+        else
+        {
+            RequestTracer::callback(onSuccess, req.response());
+        }
     }
     catch (const Curl::CurlException& ex)
     {
@@ -312,24 +356,34 @@ void UNIXSocketRequest::delete_(RequestParameters requestParameters,
     // Post request parameters
     const auto& onError {postRequestParameters.onError};
     const auto& onSuccess {postRequestParameters.onSuccess};
+    const auto& onResponse {postRequestParameters.onResponse};
     const auto& outputFile {postRequestParameters.outputFile};
     // Configuration parameters
     const auto& timeout {configurationParameters.timeout};
     const auto& userAgent {configurationParameters.userAgent};
     const auto& handlerType {configurationParameters.handlerType};
     const auto& shouldRun {configurationParameters.shouldRun};
+    const auto& observer {configurationParameters.observer};
 
     try
     {
-        auto req {DeleteRequest::builder(FactoryRequestWrapper<wrapperType>::create(handlerType, shouldRun))};
+        auto req {BasicDeleteRequest<wrapperType>::builder(factoryType::acquire(handlerType, shouldRun))};
         req.url(url.url(), secureCommunication)
             .unixSocketPath(url.unixSocketPath())
             .timeout(timeout)
             .userAgent(userAgent)
+            .observer(observer)
             .outputFile(outputFile)
             .execute();
 
-        onSuccess(req.response());
+        if (onResponse)
+        {
+            RequestTracer::callback(onResponse, req.takeResponse());
+        }
+        else
+        {
+            RequestTracer::callback(onSuccess, req.response());
+        }
     }
     catch (const Curl::CurlException& ex)
     {
@@ -14,7 +14,10 @@
 
 #include "ICURLHandler.hpp"
 #include "curlMultiHandler.hpp"
+#include "curlSharedMultiHandler.hpp"
 #include "curlSingleHandler.hpp"
+#include "requestMetricsRegistry.hpp"
+#include "requestTracer.hpp"
 #include "singleton.hpp"
 #include <algorithm>
 #include <atomic>
@@ -40,45 +43,74 @@ private:
     std::mutex m_mutex; ///< Enum value for this content type.
 
 public:
+    /**
+     * @brief Creates a cURL handler that isn't stored in the cache, for requests that own their handle.
+     *
+     * @param curlHandlerType Type of the cURL handler.
+     * @param shouldRun Flag used to interrupt the handler.
+     * @return std::shared_ptr<ICURLHandler>
+     */
+    static std::shared_ptr<ICURLHandler> createCurlHandler(CurlHandlerTypeEnum curlHandlerType,
+                                                           const std::atomic<bool>& shouldRun)
+    {
+        switch (curlHandlerType)
+        {
+            case CurlHandlerTypeEnum::SINGLE: return std::make_shared<cURLSingleHandler>(curlHandlerType);
+            case CurlHandlerTypeEnum::MULTI: return std::make_shared<cURLMultiHandler>(curlHandlerType, shouldRun);
+            case CurlHandlerTypeEnum::SHARED_MULTI:
+                return std::make_shared<cURLSharedMultiHandler>(curlHandlerType, shouldRun);
+            default: throw std::invalid_argument("Invalid handler type.");
+        }
+    }
+
     /**
      * @brief Get the cURL handler object
      * This method creates a single or multi cURL handler and returns it, but ensures that only one cURL handler is used
      * per thread and keeps the queue size to a maximum of QUEUE_MAX_SIZE.
      *
+     * The HSTS and Alt-Svc caches stay loaded in the handle, so a handler is only reused by the requests that use the
+     * same cache files. The requests that don't use them never get a handler that would upgrade or redirect them.
+     *
      * @param curlHandlerType Type of the cURL handler. Default is 'SINGLE'.
      * @param shouldRun Flag used to interrupt the handler.
+     * @param hstsCachePath HSTS cache file the request uses, empty if none.
+     * @param altSvcCachePath Alt-Svc cache file the request uses, empty if none.
      * @return std::shared_ptr<ICURLHandler>
      */
     std::shared_ptr<ICURLHandler> getCurlHandler(CurlHandlerTypeEnum curlHandlerType = CurlHandlerTypeEnum::SINGLE,
-                                                 const std::atomic<bool>& shouldRun = true)
+                                                 const std::atomic<bool>& shouldRun = true,
+                                                 const std::string& hstsCachePath = {},
+                                                 const std::string& altSvcCachePath = {})
     {
+        RequestTracer::TraceSpan span {"handler cache lookup", "handler cache"};
         std::lock_guard<std::mutex> lock(m_mutex);
         const auto it {std::find_if(
             m_handlerQueue.cbegin(),
             m_handlerQueue.cend(),
-            [&curlHandlerType](const std::pair<std::thread::id, std::shared_ptr<ICURLHandler>>& pair)
-            { return std::this_thread::get_id() == pair.first && curlHandlerType == pair.second->getHandlerType(); })};
+            [&](const std::pair<std::thread::id, std::shared_ptr<ICURLHandler>>& pair)
+            {
+                return std::this_thread::get_id() == pair.first && curlHandlerType == pair.second->getHandlerType() &&
+                       pair.second->usesCacheFiles(hstsCachePath, altSvcCachePath);
+            })};
 
+        auto& requestMetrics {RequestMetricsRegistry::instance()};
         if (m_handlerQueue.end() != it)
         {
+            requestMetrics.handlerCacheHit();
+            span.result("hit");
             return it->second;
         }
         else
         {
+            requestMetrics.handlerCacheMiss();
+            span.result("miss");
             if (QUEUE_MAX_SIZE <= m_handlerQueue.size())
             {
+                requestMetrics.handlerCacheEviction();
+                span.result("eviction");
                 m_handlerQueue.pop_front();
             }
-            std::shared_ptr<ICURLHandler> handler;
-            switch (curlHandlerType)
-            {
-                case CurlHandlerTypeEnum::SINGLE: handler = std::make_shared<cURLSingleHandler>(curlHandlerType); break;
-                case CurlHandlerTypeEnum::MULTI:
-                    handler = std::make_shared<cURLMultiHandler>(curlHandlerType, shouldRun);
-                    break;
-                default: throw std::invalid_argument("Invalid handler type.");
-            }
-            m_handlerQueue.emplace_back(std::this_thread::get_id(), handler);
+            m_handlerQueue.emplace_back(std::this_thread::get_id(), createCurlHandler(curlHandlerType, shouldRun));
             return m_handlerQueue.back().second;
         }
     }
@@ -23,7 +23,6 @@
 static const int CURL_MULTI_HANDLER_TIMEOUT_MS = 1000;
 static const int CURL_MULTI_HANDLER_EXTRA_FDS = 0;
 
-using deleterCurlHandler = CustomDeleter<decltype(&curl_easy_cleanup), curl_easy_cleanup>;
 using deleterCurlMultiHandler = CustomDeleter<decltype(&curl_multi_cleanup), curl_multi_cleanup>;
 
 //! cURLMultiHandler class
@@ -48,7 +47,7 @@ public:
         : ICURLHandler(curlHandlerType)
         , m_shouldRun(shouldRun)
     {
-        m_curlHandler = std::shared_ptr<CURL>(curl_easy_init(), deleterCurlHandler());
+        m_curlHandler = createHandle();
         m_curlMultiHandler = std::shared_ptr<CURLM>(curl_multi_init(), deleterCurlMultiHandler());
     }
 
@@ -115,6 +114,7 @@ public:
                     {
                         throw Curl::CurlException("cURLMultiHandler::execute() failed: " +
                                                       std::string(curl_easy_strerror(errorCode)),
+                                                  errorCode,
                                                   errorCode);
                     }
                 }
@@ -123,7 +123,7 @@ public:
         catch (const std::exception& e)
         {
             curl_multi_remove_handle(m_curlMultiHandler.get(), m_curlHandler.get());
-            curl_easy_reset(m_curlHandler.get());
+            resetOptions();
             throw;
         }
 
@@ -135,7 +135,7 @@ public:
                                      std::string(curl_multi_strerror(multiRemoveCode)));
         }
 
-        curl_easy_reset(m_curlHandler.get());
+        resetOptions();
     }
 };
 
@@ -0,0 +1,248 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _CURL_SHARED_MULTI_HANDLER_HPP
+#define _CURL_SHARED_MULTI_HANDLER_HPP
+
+#include "ICURLHandler.hpp"
+#include "curlException.hpp"
+#include "customDeleter.hpp"
+#include "singleton.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <curl/curl.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+static const int CURL_SHARED_MULTI_POLL_TIMEOUT_MS = 1000;
+
+//! cURLSharedMulti class
+/**
+ * @brief This class owns the multi handle shared by all the cURLSharedMultiHandler instances. Transfers from every
+ * thread are added to it, so they share its connection pool and, with HTTP/2, are multiplexed over a single connection
+ * per host.
+ *
+ * A multi handle can only be used by one thread at a time. There is no dedicated thread: one of the threads waiting
+ * for a transfer drives all of them until its own transfer is done, and then another waiting thread takes over.
+ */
+class cURLSharedMulti final : public Singleton<cURLSharedMulti>
+{
+private:
+    using deleterCurlMulti = CustomDeleter<decltype(&curl_multi_cleanup), curl_multi_cleanup>;
+
+    std::unique_ptr<CURLM, deleterCurlMulti> m_multiHandle;
+    std::map<CURL*, CURLcode> m_results; ///< Results of the finished transfers, until their threads collect them.
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_driving {false};   ///< A thread is driving the transfers.
+    bool m_polling {false};   ///< The driving thread is waiting for activity, without holding the lock.
+    int m_waitingForPoll {0}; ///< Threads waiting to use the multi handle while it's polled.
+
+    /**
+     * @brief Waits until the multi handle isn't being polled, so it can be used. The poll is woken up.
+     *
+     * @param lock Lock of 'm_mutex'.
+     */
+    void waitForPoll(std::unique_lock<std::mutex>& lock)
+    {
+        ++m_waitingForPoll;
+        while (m_polling)
+        {
+            curl_multi_wakeup(m_multiHandle.get());
+            m_condition.wait(lock);
+        }
+        --m_waitingForPoll;
+        m_condition.notify_all();
+    }
+
+    /**
+     * @brief Performs the pending work of all the transfers and stores the results of the finished ones.
+     *
+     * @return CURLMcode Result of curl_multi_perform.
+     */
+    CURLMcode drive()
+    {
+        int runningHandles {0};
+        const auto multiCode {curl_multi_perform(m_multiHandle.get(), &runningHandles)};
+
+        int messagesInQueue {0};
+        while (const auto message {curl_multi_info_read(m_multiHandle.get(), &messagesInQueue)})
+        {
+            if (message->msg == CURLMSG_DONE)
+            {
+                // Once removed, the owner can reset and reuse the handle.
+                const auto handle {message->easy_handle};
+                const auto result {message->data.result};
+                curl_multi_remove_handle(m_multiHandle.get(), handle);
+                m_results[handle] = result;
+            }
+        }
+        return multiCode;
+    }
+
+public:
+    cURLSharedMulti()
+        : m_multiHandle {curl_multi_init()}
+    {
+        if (!m_multiHandle)
+        {
+            throw std::runtime_error("cURLSharedMulti initialization failed");
+        }
+        curl_multi_setopt(m_multiHandle.get(), CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    }
+
+    /**
+     * @brief Performs a transfer and waits until it finishes. As with the multi handler, a transfer interrupted through
+     * 'shouldRun' isn't reported as an error.
+     *
+     * @param handle Easy handle of the transfer.
+     * @param shouldRun Flag used to interrupt the transfer.
+     * @return CURLcode Result of the transfer.
+     */
+    CURLcode perform(CURL* handle, const std::atomic<bool>& shouldRun)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        waitForPoll(lock);
+
+        const auto addCode {curl_multi_add_handle(m_multiHandle.get(), handle)};
+        if (addCode != CURLM_OK)
+        {
+            throw std::runtime_error("cURLSharedMulti::perform() failed: curl_multi_add_handle: " +
+                                     std::string(curl_multi_strerror(addCode)));
+        }
+
+        while (true)
+        {
+            if (const auto it {m_results.find(handle)}; it != m_results.end())
+            {
+                const auto result {it->second};
+                m_results.erase(it);
+                return result;
+            }
+
+            if (!shouldRun.load())
+            {
+                waitForPoll(lock);
+                curl_multi_remove_handle(m_multiHandle.get(), handle);
+                m_results.erase(handle);
+                return CURLE_OK;
+            }
+
+            if (m_driving)
+            {
+                m_condition.wait_for(lock, std::chrono::milliseconds(CURL_SHARED_MULTI_POLL_TIMEOUT_MS));
+                continue;
+            }
+
+            m_driving = true;
+            const auto multiCode {drive()};
+            m_condition.notify_all();
+
+            if (multiCode == CURLM_OK && m_results.find(handle) == m_results.end())
+            {
+                // Other threads may add transfers or collect their results meanwhile.
+                m_polling = true;
+                lock.unlock();
+                curl_multi_poll(m_multiHandle.get(), nullptr, 0, CURL_SHARED_MULTI_POLL_TIMEOUT_MS, nullptr);
+                lock.lock();
+                m_polling = false;
+                m_condition.notify_all();
+
+                // Let the threads that woke up the poll use the handle before driving again.
+                m_condition.wait(lock, [this]() { return m_waitingForPoll == 0; });
+            }
+
+            m_driving = false;
+            m_condition.notify_all();
+
+            if (multiCode != CURLM_OK)
+            {
+                curl_multi_remove_handle(m_multiHandle.get(), handle);
+                throw std::runtime_error("cURLSharedMulti::perform() failed: curl_multi_perform: " +
+                                         std::string(curl_multi_strerror(multiCode)));
+            }
+        }
+    }
+};
+
+//! cURLSharedMultiHandler class
+/**
+ * @brief This class implements the ICURLHandler interface to represent a cURL handler whose transfers are performed
+ * through the multi handle shared by all threads.
+ */
+class cURLSharedMultiHandler final : public ICURLHandler
+{
+private:
+    const std::atomic<bool>& m_shouldRun; ///< Variable to control the graceful shutdown of the transfer.
+
+public:
+    /**
+     * @brief Construct a new cURLSharedMultiHandler object
+     *
+     * @param curlHandlerType Enum value of the cURL handler.
+     * @param shouldRun Flag used to interrupt the cURL handler.
+     */
+    explicit cURLSharedMultiHandler(CurlHandlerTypeEnum curlHandlerType, const std::atomic<bool>& shouldRun = true)
+        : ICURLHandler(curlHandlerType)
+        , m_shouldRun(shouldRun)
+    {
+        m_curlHandler = createHandle();
+    }
+
+    // LCOV_EXCL_START
+    ~cURLSharedMultiHandler() override = default;
+    // LCOV_EXCL_STOP
+
+    /**
+     * @brief This method performs the request.
+     */
+    void execute() override
+    {
+        // Wait for a connection that can be multiplexed rather than opening a new one.
+        curl_easy_setopt(m_curlHandler.get(), CURLOPT_PIPEWAIT, 1L);
+
+        CURLcode resPerform {CURLE_OK};
+        try
+        {
+            resPerform = cURLSharedMulti::instance().perform(m_curlHandler.get(), m_shouldRun);
+        }
+        catch (const std::exception&)
+        {
+            resetOptions();
+            throw;
+        }
+
+        long responseCode;
+        const auto resGetInfo {curl_easy_getinfo(m_curlHandler.get(), CURLINFO_RESPONSE_CODE, &responseCode)};
+
+        resetOptions();
+
+        if (resPerform != CURLE_OK)
+        {
+            if (resPerform == CURLE_HTTP_RETURNED_ERROR)
+            {
+                if (resGetInfo != CURLE_OK)
+                {
+                    throw std::runtime_error(
+                        "cURLSharedMultiHandler::execute() failed: Couldn't get HTTP response code");
+                }
+                throw Curl::CurlException(curl_easy_strerror(resPerform), responseCode);
+            }
+            throw Curl::CurlException(curl_easy_strerror(resPerform), resPerform);
+        }
+    }
+};
+
+#endif // _CURL_SHARED_MULTI_HANDLER_HPP
@@ -14,14 +14,11 @@
 
 #include "ICURLHandler.hpp"
 #include "curlException.hpp"
-#include "customDeleter.hpp"
 #include <curl/curl.h>
 #include <memory>
 #include <stdexcept>
 #include <utility>
 
-using deleterCurlHandler = CustomDeleter<decltype(&curl_easy_cleanup), curl_easy_cleanup>;
-
 //! cURLSingleHandler class
 /**
  * @brief class implements the ICURLHandler interface to represent a single cURL handler.
@@ -37,7 +34,7 @@ public:
     explicit cURLSingleHandler(CurlHandlerTypeEnum curlHandlerType)
         : ICURLHandler(curlHandlerType)
     {
-        m_curlHandler = std::shared_ptr<CURL>(curl_easy_init(), deleterCurlHandler());
+        m_curlHandler = createHandle();
     }
 
     // LCOV_EXCL_START
@@ -54,7 +51,7 @@ public:
         long responseCode;
         const auto resGetInfo {curl_easy_getinfo(m_curlHandler.get(), CURLINFO_RESPONSE_CODE, &responseCode)};
 
-        curl_easy_reset(m_curlHandler.get());
+        resetOptions();
 
         if (resPerform != CURLE_OK)
         {
@@ -66,7 +63,7 @@ public:
                 }
                 throw Curl::CurlException(curl_easy_strerror(resPerform), responseCode);
             }
-            throw std::runtime_error(curl_easy_strerror(resPerform));
+            throw Curl::CurlException(curl_easy_strerror(resPerform), resPerform);
         }
     }
 };
@@ -14,20 +14,32 @@
 
 #include "ICURLHandler.hpp"
 #include "IRequestImplementator.hpp"
+#include "IURLRequest.hpp"
 #include "curlHandlerCache.hpp"
 #include "curlMultiHandler.hpp"
 #include "curlSingleHandler.hpp"
 #include "customDeleter.hpp"
+#include "inFlightRequestTable.hpp"
+#include "requestMetricsRegistry.hpp"
+#include "requestTracer.hpp"
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
 #include <curl/curl.h>
 #include <map>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <stdexcept>
+#include <string_view>
 #include <thread>
+#include <utility>
+#include <vector>
 
-static const std::map<OPTION_REQUEST_TYPE, CURLoption> OPTION_REQUEST_TYPE_MAP = {
+constexpr std::array<std::pair<OPTION_REQUEST_TYPE, CURLoption>, OPT_COUNT> OPTION_REQUEST_TYPE_MAP {{
     {OPT_URL, CURLOPT_URL},
     {OPT_CAINFO, CURLOPT_CAINFO},
     {OPT_TIMEOUT_MS, CURLOPT_TIMEOUT_MS},
@@ -44,10 +56,90 @@ static const std::map<OPTION_REQUEST_TYPE, CURLoption> OPTION_REQUEST_TYPE_MAP =
     {OPT_VERIFYPEER, CURLOPT_SSL_VERIFYPEER},
     {OPT_SSL_CERT, CURLOPT_SSLCERT},
     {OPT_SSL_KEY, CURLOPT_SSLKEY},
-    {OPT_BASIC_AUTH, CURLOPT_USERPWD}};
+    {OPT_BASIC_AUTH, CURLOPT_USERPWD},
+    {OPT_HSTS, CURLOPT_HSTS},
+    {OPT_ALTSVC, CURLOPT_ALTSVC},
+    {OPT_HTTP_VERSION, CURLOPT_HTTP_VERSION},
+    {OPT_CURLU, CURLOPT_CURLU},
+    {OPT_NOBODY, CURLOPT_NOBODY}}};
+
+static_assert(isIndexedByKey(OPTION_REQUEST_TYPE_MAP, OPT_COUNT),
+              "OPTION_REQUEST_TYPE_MAP must have one entry per option, in the order of OPTION_REQUEST_TYPE");
+
+/**
+ * @brief Checks at compile time that the value type of each option is the one libcurl expects for its CURLoption.
+ *
+ * @return true if all the options match.
+ */
+constexpr bool optionValueTypesMatchCurl()
+{
+    for (size_t i = 0; i < OPT_COUNT; ++i)
+    {
+        const auto curlOption {static_cast<long>(OPTION_REQUEST_TYPE_MAP[i].second)};
+        switch (OPTION_VALUE_TYPE_MAP[i].second)
+        {
+            case VALUE_LONG:
+                if (curlOption < CURLOPTTYPE_LONG || curlOption >= CURLOPTTYPE_OBJECTPOINT)
+                {
+                    return false;
+                }
+                break;
+            case VALUE_STRING:
+                if (curlOption < CURLOPTTYPE_OBJECTPOINT || curlOption >= CURLOPTTYPE_FUNCTIONPOINT)
+                {
+                    return false;
+                }
+                break;
+            case VALUE_POINTER:
+                if (curlOption < CURLOPTTYPE_OBJECTPOINT || curlOption >= CURLOPTTYPE_OFF_T)
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+    return true;
+}
+
+static_assert(optionValueTypesMatchCurl(), "OPTION_VALUE_TYPE_MAP doesn't match the type of a libcurl option");
+
+// Options whose value is a cache file kept by the handle across requests, with the option and value that enable it.
+constexpr std::array<std::pair<OPTION_REQUEST_TYPE, std::pair<CURLoption, long>>, 2> OPTION_CACHE_CONTROL_MAP {{
+    {OPT_HSTS, {CURLOPT_HSTS_CTRL, CURLHSTS_ENABLE}},
+    {OPT_ALTSVC, {CURLOPT_ALTSVC_CTRL, CURLALTSVC_H1 | CURLALTSVC_H2 | CURLALTSVC_H3}}}};
+
+constexpr std::array<std::pair<HttpVersionEnum, long>, 4> HTTP_VERSION_MAP {{
+    {HttpVersionEnum::DEFAULT, CURL_HTTP_VERSION_NONE},
+    {HttpVersionEnum::HTTP_1_1, CURL_HTTP_VERSION_1_1},
+    {HttpVersionEnum::HTTP_2_TLS, CURL_HTTP_VERSION_2TLS},
+    {HttpVersionEnum::HTTP_2_PRIOR_KNOWLEDGE, CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE}}};
+
+static_assert(isIndexedByKey(HTTP_VERSION_MAP, HTTP_VERSION_MAP.size()),
+              "HTTP_VERSION_MAP must be in the order of HttpVersionEnum");
 
 auto constexpr MAX_REDIRECTIONS {20l};
 
+// Initial capacity of the buffer of the response headers.
+constexpr size_t RESPONSE_HEADERS_CAPACITY {1024};
+
+/**
+ * @brief Phase of a request notified to the request observers: the information that tells when it's done and, once
+ * the transfer is over, the metric where that information is kept.
+ */
+struct RequestPhase
+{
+    CURLINFO info;
+    std::chrono::microseconds TransferMetrics::*time;
+    void (IRequestObserver::*hook)(const RequestEvent&);
+};
+
+// Phases of a request, in the order they happen.
+constexpr std::array<RequestPhase, 4> REQUEST_PHASES {{
+    {CURLINFO_NAMELOOKUP_TIME_T, &TransferMetrics::nameLookupTime, &IRequestObserver::onDnsDone},
+    {CURLINFO_CONNECT_TIME_T, &TransferMetrics::connectTime, &IRequestObserver::onConnected},
+    {CURLINFO_APPCONNECT_TIME_T, &TransferMetrics::appConnectTime, &IRequestObserver::onTlsDone},
+    {CURLINFO_STARTTRANSFER_TIME_T, &TransferMetrics::startTransferTime, &IRequestObserver::onFirstByte}}};
+
 /**
  * @brief This class is a wrapper of the curl library.
  */
@@ -56,8 +148,40 @@ class cURLWrapper final : public IRequestImplementator
 private:
     using deleterCurlStringList = CustomDeleter<decltype(&curl_slist_free_all), curl_slist_free_all>;
     std::unique_ptr<curl_slist, deleterCurlStringList> m_curlHeaders;
+    HeaderSet m_headerSet;                 ///< Compiled headers, sent after the appended ones.
+    std::vector<curl_slist> m_headerNodes; ///< Appended headers chained to the compiled ones.
     std::string m_returnValue;
+    std::vector<char> m_responseHeaders; ///< Header lines of the last response.
     std::shared_ptr<ICURLHandler> m_curlHandler;
+    std::string m_url;
+    CURLU* m_parsedUrl {nullptr}; ///< URL of the request when it's given as a parsed handle.
+    std::string m_method;         ///< Method of the request, GET if it isn't set.
+    std::string m_hopUrl;
+    std::string m_permanentRedirect;
+    long m_hopStatus {0};
+    bool m_redirectChainBroken {false};
+    std::shared_ptr<IRequestObserver> m_observer; ///< Observer of the request, the global one is used if empty.
+    IRequestObserver* m_activeObserver {nullptr}; ///< Observer of the request being performed, if any.
+    RequestEvent m_event;                         ///< Event of the request being observed.
+    std::string m_eventUrl;                       ///< URL of the event.
+    size_t m_notifiedPhases {0};                  ///< Phases of the request already notified.
+
+    InFlightRequestTable::Entry* m_inFlight {nullptr}; ///< Entry of the request being performed, if any.
+
+    /**
+     * @brief Returns the libcurl option of an option index.
+     *
+     * @param optIndex The option index.
+     * @return CURLoption libcurl option.
+     */
+    static CURLoption curlOption(const OPTION_REQUEST_TYPE optIndex)
+    {
+        if (optIndex < 0 || optIndex >= OPT_COUNT)
+        {
+            throw std::out_of_range("cURLWrapper::setOption() failed: Invalid option");
+        }
+        return OPTION_REQUEST_TYPE_MAP[optIndex].second;
+    }
 
     static size_t writeData(char* data, size_t size, size_t nmemb, void* userdata)
     {
@@ -66,6 +190,366 @@ private:
         return size * nmemb;
     }
 
+    /**
+     * @brief Resolves a 'Location' header, which may be relative, against the URL of the response.
+     *
+     * @param base URL of the response.
+     * @param location Value of the header.
+     * @return std::string Absolute URL, or an empty string if it can't be resolved.
+     */
+    static std::string resolveLocation(const std::string& base, const std::string& location)
+    {
+        std::unique_ptr<CURLU, CustomDeleter<decltype(&curl_url_cleanup), curl_url_cleanup>> handle {curl_url()};
+        if (!handle || curl_url_set(handle.get(), CURLUPART_URL, base.c_str(), 0) != CURLUE_OK ||
+            curl_url_set(handle.get(), CURLUPART_URL, location.c_str(), 0) != CURLUE_OK)
+        {
+            return {};
+        }
+
+        char* resolved {nullptr};
+        if (curl_url_get(handle.get(), CURLUPART_URL, &resolved, 0) != CURLUE_OK)
+        {
+            return {};
+        }
+        std::string result {resolved};
+        curl_free(resolved);
+        return result;
+    }
+
+    /**
+     * @brief Header callback, keeps the header lines of the last response and tracks the leading permanent redirects
+     * of the transfer. Each followed hop reports its status line before its headers.
+     */
+    static size_t headerData(char* data, size_t size, size_t nmemb, void* userdata)
+    {
+        const auto wrapper {reinterpret_cast<cURLWrapper*>(userdata)};
+        std::string_view line {data, size * nmemb};
+        while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back())))
+        {
+            line.remove_suffix(1);
+        }
+
+        constexpr std::string_view STATUS_PREFIX {"HTTP/"};
+        constexpr std::string_view LOCATION_HEADER {"location:"};
+        if (line.substr(0, STATUS_PREFIX.size()) == STATUS_PREFIX)
+        {
+            wrapper->m_responseHeaders.clear();
+            const auto space {line.find(' ')};
+            wrapper->m_hopStatus =
+                space != std::string_view::npos ? std::strtol(line.data() + space + 1, nullptr, 10) : 0;
+            return size * nmemb;
+        }
+
+        // The buffer is moved out with the response, so it's reserved at once instead of growing line by line.
+        if (wrapper->m_responseHeaders.capacity() == 0)
+        {
+            wrapper->m_responseHeaders.reserve(RESPONSE_HEADERS_CAPACITY);
+        }
+        wrapper->m_responseHeaders.insert(wrapper->m_responseHeaders.end(), data, data + size * nmemb);
+        if (!wrapper->m_redirectChainBroken && line.size() > LOCATION_HEADER.size() &&
+            std::equal(LOCATION_HEADER.begin(),
+                       LOCATION_HEADER.end(),
+                       line.begin(),
+                       [](const char a, const char b)
+                       { return a == std::tolower(static_cast<unsigned char>(b)); }))
+        {
+            auto location {line.substr(LOCATION_HEADER.size())};
+            while (!location.empty() && std::isspace(static_cast<unsigned char>(location.front())))
+            {
+                location.remove_prefix(1);
+            }
+
+            // A URL given as a parsed handle isn't known as a string, the first hop is resolved against the
+            // effective URL.
+            char* effectiveUrl {nullptr};
+            if (wrapper->m_hopUrl.empty() &&
+                curl_easy_getinfo(wrapper->m_curlHandler->getHandler().get(), CURLINFO_EFFECTIVE_URL, &effectiveUrl) ==
+                    CURLE_OK &&
+                effectiveUrl != nullptr)
+            {
+                wrapper->m_hopUrl = effectiveUrl;
+            }
+
+            const auto target {wrapper->m_hopStatus == 301 || wrapper->m_hopStatus == 308
+                                   ? resolveLocation(wrapper->m_hopUrl, std::string(location))
+                                   : std::string()};
+            if (target.empty())
+            {
+                wrapper->m_redirectChainBroken = true;
+            }
+            else
+            {
+                wrapper->m_permanentRedirect = target;
+                wrapper->m_hopUrl = target;
+            }
+        }
+        return size * nmemb;
+    }
+
+    /**
+     * @brief Compares two header names, which are case insensitive.
+     */
+    static bool sameHeaderName(std::string_view a, std::string_view b)
+    {
+        return a.size() == b.size() &&
+               std::equal(a.begin(),
+                          a.end(),
+                          b.begin(),
+                          [](const char x, const char y)
+                          {
+                              return std::tolower(static_cast<unsigned char>(x)) ==
+                                     std::tolower(static_cast<unsigned char>(y));
+                          });
+    }
+
+    /**
+     * @brief Returns the list of headers of the request: the appended headers followed by the compiled set. The nodes
+     * of the appended headers are copied into 'm_headerNodes' and chained to the set, which is shared and can't be
+     * modified. If an appended header replaces one of the set, the rest of the set is copied too. Only the nodes are
+     * copied, not the strings.
+     *
+     * @return curl_slist* Header list.
+     */
+    curl_slist* headerList()
+    {
+        const auto compiledHeaders {const_cast<curl_slist*>(m_headerSet.list())};
+        if (!m_curlHeaders || !compiledHeaders)
+        {
+            return m_curlHeaders ? m_curlHeaders.get() : compiledHeaders;
+        }
+
+        m_headerNodes.clear();
+        auto replacesCompiledHeader {false};
+        for (auto node {m_curlHeaders.get()}; node != nullptr; node = node->next)
+        {
+            m_headerNodes.push_back({node->data, nullptr});
+            replacesCompiledHeader = replacesCompiledHeader || m_headerSet.contains(HeaderSet::name(node->data));
+        }
+        const auto appendedHeaders {m_headerNodes.size()};
+
+        if (replacesCompiledHeader)
+        {
+            for (auto node {compiledHeaders}; node != nullptr; node = node->next)
+            {
+                const auto name {HeaderSet::name(node->data)};
+                if (std::none_of(m_headerNodes.cbegin(),
+                                 m_headerNodes.cbegin() + appendedHeaders,
+                                 [&name](const curl_slist& appended)
+                                 { return sameHeaderName(HeaderSet::name(appended.data), name); }))
+                {
+                    m_headerNodes.push_back({node->data, nullptr});
+                }
+            }
+        }
+
+        for (size_t i = 0; i + 1 < m_headerNodes.size(); ++i)
+        {
+            m_headerNodes[i].next = &m_headerNodes[i + 1];
+        }
+        m_headerNodes.back().next = replacesCompiledHeader ? nullptr : compiledHeaders;
+        return m_headerNodes.data();
+    }
+
+    /**
+     * @brief Records the last request in the request metrics, and in the trace if it was traced.
+     *
+     * @param requestMetrics Request metrics.
+     * @param traceStart Start of the transfer, zero if it wasn't traced.
+     */
+    void recordRequest(RequestMetricsRegistry& requestMetrics, const std::chrono::microseconds traceStart) const
+    {
+        const auto& url {m_curlHandler->effectiveUrl()};
+        requestMetrics.requestFinished({m_method.empty() ? std::string_view("GET") : std::string_view(m_method),
+                                        m_curlHandler->responseCode(),
+                                        RequestMetricsRegistry::host(url)},
+                                       m_curlHandler->transferMetrics());
+        if (traceStart.count() != 0)
+        {
+            RequestTracer::instance().recordTransfer(
+                traceStart, m_method, url, m_curlHandler->responseCode(), m_curlHandler->transferMetrics());
+        }
+    }
+
+    /**
+     * @brief Calls a hook of the observer. The exceptions thrown by it are ignored.
+     *
+     * @param hook Hook call.
+     */
+    template<typename TCallback>
+    static void notifyObserver(TCallback&& hook)
+    {
+        try
+        {
+            hook();
+        }
+        catch (...)
+        {
+            // The observer must not change the result of the request.
+        }
+    }
+
+    /**
+     * @brief Returns the identifier of a new observed request.
+     *
+     * @return uint64_t Request identifier.
+     */
+    static uint64_t nextRequestId()
+    {
+        static std::atomic<uint64_t> lastRequestId {0};
+        return lastRequestId.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    /**
+     * @brief Notifies the phases of the request that are done since the last call. A phase libcurl doesn't report,
+     * like the connection of a request over a reused one, is skipped.
+     *
+     * @param elapsed Returns the time of a phase since the start of the request, zero if it isn't done.
+     */
+    template<typename TElapsed>
+    void notifyPhases(TElapsed&& elapsed)
+    {
+        for (auto phase {m_notifiedPhases}; phase < REQUEST_PHASES.size(); ++phase)
+        {
+            if (const auto time {elapsed(REQUEST_PHASES[phase])}; time.count() > 0)
+            {
+                // Once a phase is done, the skipped ones before it won't be.
+                m_notifiedPhases = phase + 1;
+                m_event.elapsed = time;
+                notifyObserver([this, phase]() { (m_activeObserver->*REQUEST_PHASES[phase].hook)(m_event); });
+            }
+        }
+    }
+
+    /**
+     * @brief Progress callback, called by libcurl during a transfer to update its entry in the in-flight table and, if
+     * it's observed, to notify its phases as they happen. With the 'SHARED_MULTI' handler, it may be called from the
+     * thread that drives the transfers.
+     */
+    static int progress(void* userdata, curl_off_t, curl_off_t received, curl_off_t, curl_off_t sent)
+    {
+        const auto wrapper {reinterpret_cast<cURLWrapper*>(userdata)};
+        const auto handle {wrapper->m_curlHandler->getHandler().get()};
+        if (const auto inFlight {wrapper->m_inFlight}; inFlight != nullptr)
+        {
+            inFlight->progress(static_cast<uint64_t>(received), static_cast<uint64_t>(sent));
+
+            // A URL given as a parsed handle is only known as a string once the transfer starts.
+            if (char* effectiveUrl {nullptr}; inFlight->needsUrl() &&
+                                              curl_easy_getinfo(handle, CURLINFO_EFFECTIVE_URL, &effectiveUrl) ==
+                                                  CURLE_OK &&
+                                              effectiveUrl != nullptr)
+            {
+                inFlight->url(effectiveUrl);
+            }
+        }
+
+        if (wrapper->m_activeObserver != nullptr)
+        {
+            wrapper->notifyPhases(
+                [handle](const RequestPhase& phase)
+                {
+                    curl_off_t value {0};
+                    curl_easy_getinfo(handle, phase.info, &value);
+                    return std::chrono::microseconds(value);
+                });
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Performs the request, tracking it in the in-flight table while it's performed if the table is enabled,
+     * and records it in the request metrics and in the trace, whether it succeeds or not.
+     */
+    void perform()
+    {
+        // libcurl calls the progress callback many times per transfer, so it's only set when something uses it.
+        const auto tracked {InFlightRequestTable::enabled()};
+        const auto handle {m_curlHandler->getHandler().get()};
+        const auto withProgress {tracked || m_activeObserver != nullptr};
+        if (withProgress && (curl_easy_setopt(handle, CURLOPT_XFERINFOFUNCTION, cURLWrapper::progress) != CURLE_OK ||
+                             curl_easy_setopt(handle, CURLOPT_XFERINFODATA, this) != CURLE_OK ||
+                             curl_easy_setopt(handle, CURLOPT_NOPROGRESS, 0L) != CURLE_OK))
+        {
+            throw std::runtime_error("cURLWrapper::execute() failed: Couldn't set the progress callback");
+        }
+
+        auto& requestMetrics {RequestMetricsRegistry::instance()};
+        requestMetrics.requestStarted();
+        const auto traceStart {RequestTracer::enabled() ? RequestTracer::now() : std::chrono::microseconds(0)};
+        std::optional<InFlightRequestTable::Entry> inFlight;
+        if (tracked)
+        {
+            m_inFlight = &inFlight.emplace(m_method, m_url, m_curlHandler->getHandlerType());
+        }
+        const auto finish {[&]()
+                           {
+                               // The options may be kept for the next request, performed by another wrapper.
+                               if (withProgress)
+                               {
+                                   curl_easy_setopt(handle, CURLOPT_NOPROGRESS, 1L);
+                               }
+                               m_inFlight = nullptr;
+                               recordRequest(requestMetrics, traceStart);
+                           }};
+        try
+        {
+            m_curlHandler->execute();
+        }
+        catch (...)
+        {
+            finish();
+            throw;
+        }
+        finish();
+    }
+
+    /**
+     * @brief Performs the request, notifying its lifecycle to an observer. The phases are notified from the progress
+     * callback as they happen, and those still pending once the transfer is over from its metrics.
+     *
+     * @param observer Observer of the request.
+     */
+    void performObserved(IRequestObserver& observer)
+    {
+        m_eventUrl = m_url;
+        if (char* parsedUrl {nullptr};
+            m_eventUrl.empty() && m_parsedUrl != nullptr &&
+            curl_url_get(m_parsedUrl, CURLUPART_URL, &parsedUrl, 0) == CURLUE_OK)
+        {
+            m_eventUrl = parsedUrl;
+            curl_free(parsedUrl);
+        }
+        m_event = {nextRequestId(),
+                   m_method.empty() ? std::string_view("GET") : std::string_view(m_method),
+                   m_eventUrl,
+                   std::chrono::microseconds(0)};
+        m_notifiedPhases = 0;
+
+        notifyObserver([&]() { observer.onStart(m_event); });
+        m_activeObserver = &observer;
+        const auto finish {[&]()
+                           {
+                               const auto& metrics {m_curlHandler->transferMetrics()};
+                               notifyPhases([&metrics](const RequestPhase& phase) { return metrics.*phase.time; });
+                               m_activeObserver = nullptr;
+                               m_event.elapsed = metrics.totalTime;
+                           }};
+        try
+        {
+            perform();
+        }
+        catch (const std::exception& e)
+        {
+            finish();
+            notifyObserver([&]() { observer.onError(m_event, e.what(), m_curlHandler->responseCode()); });
+            throw;
+        }
+        finish();
+        notifyObserver(
+            [&]()
+            { observer.onComplete(m_event, m_curlHandler->responseCode(), m_curlHandler->transferMetrics()); });
+    }
+
     /**
      * @brief Get the cURL Handler object.
      *
@@ -73,8 +557,8 @@ private:
      * @param shouldRun Flag used to interrupt the cURL handler.
      * @return std::shared_ptr<ICURLHandler>
      */
-    std::shared_ptr<ICURLHandler> curlHandlerInit(CurlHandlerTypeEnum handlerType,
-                                                  const std::atomic<bool>& shouldRun = true)
+    static std::shared_ptr<ICURLHandler> curlHandlerInit(CurlHandlerTypeEnum handlerType,
+                                                         const std::atomic<bool>& shouldRun = true)
     {
         return cURLHandlerCache::instance().getCurlHandler(handlerType, shouldRun);
     }
@@ -88,14 +572,46 @@ public:
      */
     cURLWrapper(CurlHandlerTypeEnum handlerType = CurlHandlerTypeEnum::SINGLE,
                 const std::atomic<bool>& shouldRun = true)
+        : cURLWrapper(curlHandlerInit(handlerType, shouldRun))
     {
-        m_curlHandler = curlHandlerInit(handlerType, shouldRun);
+    }
 
+    /**
+     * @brief Create a cURLWrapper over the given handler, instead of the one cached for the thread.
+     *
+     * @param curlHandler cURL handler.
+     */
+    explicit cURLWrapper(std::shared_ptr<ICURLHandler> curlHandler)
+        : m_curlHandler {std::move(curlHandler)}
+    {
         if (!m_curlHandler || !m_curlHandler->getHandler())
         {
             throw std::runtime_error("cURL initialization failed");
         }
 
+        reset();
+    }
+
+    cURLWrapper(const cURLWrapper&) = delete;
+    cURLWrapper& operator=(const cURLWrapper&) = delete;
+
+    virtual ~cURLWrapper() = default;
+
+    /**
+     * @brief Restores the state of a new wrapper, so that it can be reused for another request: the default options
+     * are set on the handle, and the headers and the response of the previous request are dropped.
+     */
+    void reset()
+    {
+        m_curlHeaders.reset();
+        m_headerSet = {};
+        m_returnValue.clear();
+        m_responseHeaders.clear();
+        m_url.clear();
+        m_parsedUrl = nullptr;
+        m_method.clear();
+        m_observer.reset();
+
         this->setOption(OPT_WRITEFUNCTION, reinterpret_cast<void*>(cURLWrapper::writeData));
 
         this->setOption(OPT_WRITEDATA, &m_returnValue);
@@ -105,9 +621,55 @@ public:
         this->setOption(OPT_FOLLOW_REDIRECT, 1l);
 
         this->setOption(OPT_MAX_REDIRECTIONS, MAX_REDIRECTIONS);
+
+        if (curl_easy_setopt(m_curlHandler->getHandler().get(), CURLOPT_HEADERFUNCTION, cURLWrapper::headerData) !=
+                CURLE_OK ||
+            curl_easy_setopt(m_curlHandler->getHandler().get(), CURLOPT_HEADERDATA, this) != CURLE_OK)
+        {
+            throw std::runtime_error("cURLWrapper::reset() failed: Couldn't set the header callback");
+        }
     }
 
-    virtual ~cURLWrapper() = default;
+    /**
+     * @brief Binds the wrapper to another cURL handler and resets it, so that a pooled wrapper is reused over the
+     * handler cached for the thread.
+     *
+     * @param curlHandler cURL handler.
+     */
+    void rebind(std::shared_ptr<ICURLHandler> curlHandler)
+    {
+        if (!curlHandler || !curlHandler->getHandler())
+        {
+            throw std::runtime_error("cURL initialization failed");
+        }
+
+        m_curlHandler = std::move(curlHandler);
+        reset();
+    }
+
+    /**
+     * @brief Drops the cURL handler of the wrapper, so that a pooled wrapper doesn't keep its handles alive while it
+     * isn't used. The wrapper must be rebound before it's used again.
+     */
+    void releaseHandler()
+    {
+        m_curlHeaders.reset();
+        m_headerSet = {};
+        m_returnValue.clear();
+        m_responseHeaders.clear();
+        m_observer.reset();
+        m_curlHandler.reset();
+    }
+
+    /**
+     * @brief Returns the cURL handler of the wrapper.
+     *
+     * @return const std::shared_ptr<ICURLHandler>& cURL handler.
+     */
+    const std::shared_ptr<ICURLHandler>& curlHandler() const
+    {
+        return m_curlHandler;
+    }
 
     /**
      * @brief This method returns the value of the last request.
@@ -118,6 +680,27 @@ public:
         return m_returnValue;
     }
 
+    /**
+     * @brief This method moves the status, headers, body and metrics of the last request into a response.
+     * @return The response of the last request.
+     */
+    Response takeResponse() override
+    {
+        return {m_curlHandler->responseCode(),
+                ResponseHeaders(std::move(m_responseHeaders)),
+                std::move(m_returnValue),
+                m_curlHandler->transferMetrics()};
+    }
+
+    /**
+     * @brief This method returns the target of the permanent redirects followed by the last request.
+     * @return The URL the request was permanently redirected to, or an empty string.
+     */
+    inline const std::string permanentRedirect() override
+    {
+        return m_permanentRedirect;
+    }
+
     /**
      * @brief This method sets an option to the curl handler.
      * @param optIndex The option index.
@@ -125,7 +708,13 @@ public:
      */
     void setOption(const OPTION_REQUEST_TYPE optIndex, void* ptr) override
     {
-        auto ret = curl_easy_setopt(m_curlHandler->getHandler().get(), OPTION_REQUEST_TYPE_MAP.at(optIndex), ptr);
+        if (optIndex == OPT_CURLU)
+        {
+            m_url.clear();
+            m_parsedUrl = static_cast<CURLU*>(ptr);
+        }
+
+        auto ret = curl_easy_setopt(m_curlHandler->getHandler().get(), curlOption(optIndex), ptr);
 
         if (ret != CURLE_OK)
         {
@@ -140,8 +729,30 @@ public:
      */
     void setOption(const OPTION_REQUEST_TYPE optIndex, const std::string& opt) override
     {
-        auto ret =
-            curl_easy_setopt(m_curlHandler->getHandler().get(), OPTION_REQUEST_TYPE_MAP.at(optIndex), opt.c_str());
+        if (optIndex == OPT_URL)
+        {
+            m_url = opt;
+            m_parsedUrl = nullptr;
+        }
+        else if (optIndex == OPT_CUSTOMREQUEST)
+        {
+            m_method = opt;
+        }
+
+        if (const auto control {std::find_if(OPTION_CACHE_CONTROL_MAP.cbegin(),
+                                             OPTION_CACHE_CONTROL_MAP.cend(),
+                                             [optIndex](const auto& entry) { return entry.first == optIndex; })};
+            control != OPTION_CACHE_CONTROL_MAP.cend())
+        {
+            const auto& [controlOption, controlValue] {control->second};
+            if (m_curlHandler->setCacheFile(curlOption(optIndex), controlOption, controlValue, opt) != CURLE_OK)
+            {
+                throw std::runtime_error("cURLWrapper::setOption() failed: Couldn't set the cache file");
+            }
+            return;
+        }
+
+        auto ret = curl_easy_setopt(m_curlHandler->getHandler().get(), curlOption(optIndex), opt.c_str());
 
         if (ret != CURLE_OK)
         {
@@ -156,7 +767,17 @@ public:
      */
     void setOption(const OPTION_REQUEST_TYPE optIndex, const long opt) override
     {
-        auto ret = curl_easy_setopt(m_curlHandler->getHandler().get(), OPTION_REQUEST_TYPE_MAP.at(optIndex), opt);
+        // The HTTP version is given as a HttpVersionEnum value.
+        auto value {opt};
+        if (optIndex == OPT_HTTP_VERSION)
+        {
+            if (opt < 0 || static_cast<size_t>(opt) >= HTTP_VERSION_MAP.size())
+            {
+                throw std::out_of_range("cURLWrapper::setOption() failed: Invalid HTTP version");
+            }
+            value = HTTP_VERSION_MAP[opt].second;
+        }
+        auto ret = curl_easy_setopt(m_curlHandler->getHandler().get(), curlOption(optIndex), value);
 
         if (ret != CURLE_OK)
         {
@@ -180,19 +801,51 @@ public:
         }
     }
 
+    /**
+     * @brief This method sets a compiled set of headers.
+     * @param headers The set of headers.
+     */
+    void setHeaders(const HeaderSet& headers) override
+    {
+        m_headerSet = headers;
+    }
+
+    /**
+     * @brief This method sets the observer of the lifecycle of the request.
+     * @param observer The observer, kept until the wrapper is reset.
+     */
+    void setObserver(std::shared_ptr<IRequestObserver> observer) override
+    {
+        m_observer = std::move(observer);
+    }
+
     /**
      * @brief This method performs the request.
      */
     void execute() override
     {
-        CURLcode setOptResult =
-            curl_easy_setopt(m_curlHandler->getHandler().get(), CURLOPT_HTTPHEADER, m_curlHeaders.get());
+        CURLcode setOptResult = curl_easy_setopt(m_curlHandler->getHandler().get(), CURLOPT_HTTPHEADER, headerList());
         if (CURLE_OK != setOptResult)
         {
             throw std::runtime_error("cURLWrapper::execute() failed: Couldn't set HTTP headers");
         }
 
-        m_curlHandler->execute();
+        // The wrapper may be executed again when the options of its handle are kept.
+        m_returnValue.clear();
+        m_responseHeaders.clear();
+        m_hopUrl = m_url;
+        m_permanentRedirect.clear();
+        m_redirectChainBroken = false;
+        m_hopStatus = 0;
+
+        // Without an observer, the only cost is checking for the global one.
+        const auto observer {m_observer ? m_observer : IRequestObserver::global()};
+        if (!observer)
+        {
+            perform();
+            return;
+        }
+        performObserved(*observer);
     }
 };
 
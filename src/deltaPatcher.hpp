@@ -0,0 +1,377 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _DELTA_PATCHER_HPP
+#define _DELTA_PATCHER_HPP
+
+#include "customDeleter.hpp"
+#include "singleton.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <fcntl.h>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <openssl/evp.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_set>
+#include <vector>
+#include <zstd.h>
+
+// Suffix of the patches offered next to the full file: '<url>.<sha256 of the previous file>.patch.zst'.
+constexpr auto DELTA_PATCH_SUFFIX {".patch.zst"};
+constexpr size_t DIGEST_READ_BUFFER_SIZE {64 * 1024};
+// Largest window accepted for a patch, the default limit of the zstd decoder (ZSTD_WINDOWLOG_LIMIT_DEFAULT, 128 MiB).
+// It bounds the memory the server can make the decoder use, and the size of the files that can be patched.
+constexpr int DELTA_PATCH_MAX_WINDOW_LOG {27};
+constexpr uint64_t DELTA_PATCH_MAX_BASE_SIZE {1ULL << DELTA_PATCH_MAX_WINDOW_LOG};
+// Missing patches remembered before the list is cleared.
+constexpr size_t DELTA_MISSING_PATCHES_MAX_SIZE {1024};
+
+/**
+ * @brief This class computes the SHA-256 digest of a stream of data.
+ */
+class Sha256Hasher final
+{
+private:
+    using deleterEvpContext = CustomDeleter<decltype(&EVP_MD_CTX_free), EVP_MD_CTX_free>;
+    std::unique_ptr<EVP_MD_CTX, deleterEvpContext> m_context;
+
+public:
+    Sha256Hasher()
+        : m_context {EVP_MD_CTX_new()}
+    {
+        if (!m_context || EVP_DigestInit_ex(m_context.get(), EVP_sha256(), nullptr) != 1)
+        {
+            throw std::runtime_error("Failed to initialize the SHA-256 digest");
+        }
+    }
+
+    /**
+     * @brief Adds data to the digest.
+     *
+     * @param data Pointer to the data.
+     * @param size Size of the data.
+     */
+    void update(const void* data, const size_t size)
+    {
+        if (EVP_DigestUpdate(m_context.get(), data, size) != 1)
+        {
+            throw std::runtime_error("Failed to update the SHA-256 digest");
+        }
+    }
+
+    /**
+     * @brief Finishes the digest.
+     *
+     * @return std::string Lowercase hexadecimal digest.
+     */
+    std::string hexDigest()
+    {
+        unsigned char digest[EVP_MAX_MD_SIZE];
+        unsigned int size {0};
+        if (EVP_DigestFinal_ex(m_context.get(), digest, &size) != 1)
+        {
+            throw std::runtime_error("Failed to finish the SHA-256 digest");
+        }
+
+        std::ostringstream hex;
+        hex << std::hex << std::setfill('0');
+        for (unsigned int i = 0; i < size; ++i)
+        {
+            hex << std::setw(2) << static_cast<int>(digest[i]);
+        }
+        return hex.str();
+    }
+
+    /**
+     * @brief Computes the digest of a file.
+     *
+     * @param path File path.
+     * @return std::string Lowercase hexadecimal digest.
+     */
+    static std::string fileDigest(const std::string& path)
+    {
+        std::unique_ptr<FILE, CustomDeleter<decltype(&fclose), fclose>> file {fopen(path.c_str(), "rb")};
+        if (!file)
+        {
+            throw std::runtime_error("Failed to open file: " + path);
+        }
+
+        Sha256Hasher hasher;
+        std::vector<char> buffer(DIGEST_READ_BUFFER_SIZE);
+        size_t read {0};
+        while ((read = fread(buffer.data(), 1, buffer.size(), file.get())) > 0)
+        {
+            hasher.update(buffer.data(), read);
+        }
+        if (ferror(file.get()))
+        {
+            throw std::runtime_error("Failed to read file: " + path);
+        }
+        return hasher.hexDigest();
+    }
+
+    /**
+     * @brief Compares two hexadecimal digests, ignoring the case.
+     *
+     * @param lhs First digest.
+     * @param rhs Second digest.
+     * @return true if both digests are equal.
+     */
+    static bool equal(const std::string& lhs, const std::string& rhs)
+    {
+        return lhs.size() == rhs.size() &&
+               std::equal(lhs.begin(),
+                          lhs.end(),
+                          rhs.begin(),
+                          [](const char a, const char b) { return std::tolower(a) == std::tolower(b); });
+    }
+};
+
+/**
+ * @brief This class applies binary patches produced by 'zstd --patch-from', which are regular zstd frames compressed
+ * using the previous version of the file as a raw prefix.
+ */
+class DeltaPatcher final
+{
+private:
+    using deleterDecompressionContext = CustomDeleter<decltype(&ZSTD_freeDCtx), ZSTD_freeDCtx>;
+    using deleterFile = CustomDeleter<decltype(&fclose), fclose>;
+
+    /**
+     * @brief Read-only memory mapping of the base file, referenced by the decompressor.
+     */
+    class BaseFileMapping final
+    {
+    private:
+        void* m_address {MAP_FAILED};
+        size_t m_size {0};
+
+    public:
+        explicit BaseFileMapping(const std::string& path)
+        {
+            const auto fd {open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+            if (fd < 0)
+            {
+                throw std::runtime_error("Failed to open base file: " + path);
+            }
+
+            struct stat fileStat {};
+            if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+            {
+                m_size = static_cast<size_t>(fileStat.st_size);
+                m_address = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            close(fd);
+
+            if (m_address == MAP_FAILED)
+            {
+                throw std::runtime_error("Failed to map base file: " + path);
+            }
+        }
+
+        ~BaseFileMapping()
+        {
+            munmap(m_address, m_size);
+        }
+
+        BaseFileMapping(const BaseFileMapping&) = delete;
+        BaseFileMapping& operator=(const BaseFileMapping&) = delete;
+
+        const void* data() const
+        {
+            return m_address;
+        }
+
+        size_t size() const
+        {
+            return m_size;
+        }
+    };
+
+    static void checkZstd(const size_t code, const std::string& operation)
+    {
+        if (ZSTD_isError(code))
+        {
+            throw std::runtime_error("DeltaPatcher::" + operation + " failed: " + ZSTD_getErrorName(code));
+        }
+    }
+
+public:
+    /**
+     * @brief Returns the URL of the patch that transforms the file with the given digest into the latest version.
+     *
+     * @param url URL of the full file.
+     * @param baseDigest SHA-256 digest of the local copy.
+     * @return std::string Patch URL.
+     */
+    static std::string patchUrl(const std::string& url, const std::string& baseDigest)
+    {
+        return url + "." + baseDigest + DELTA_PATCH_SUFFIX;
+    }
+
+    /**
+     * @brief Applies a patch to the base file. The patch is decompressed in a streaming way, so only the base file is
+     * mapped in memory.
+     *
+     * @param baseFile Previous version of the file.
+     * @param patchFile Patch produced by 'zstd --patch-from=<baseFile>'.
+     * @param outputFile File where the new version is written.
+     * @param maxWindowLog Largest window accepted, patches that need a bigger one are rejected.
+     * @return std::string SHA-256 digest of the new version.
+     */
+    static std::string apply(const std::string& baseFile,
+                             const std::string& patchFile,
+                             const std::string& outputFile,
+                             const int maxWindowLog = DELTA_PATCH_MAX_WINDOW_LOG)
+    {
+        const BaseFileMapping base {baseFile};
+
+        std::unique_ptr<ZSTD_DCtx, deleterDecompressionContext> context {ZSTD_createDCtx()};
+        if (!context)
+        {
+            throw std::runtime_error("DeltaPatcher::apply failed: Couldn't create the decompression context");
+        }
+
+        // Patches reference the whole base file, so the window is as large as the file. The limit keeps the patch from
+        // choosing how much memory the decoder allocates.
+        const auto windowLogBounds {ZSTD_dParam_getBounds(ZSTD_d_windowLogMax)};
+        checkZstd(windowLogBounds.error, "getBounds");
+        const auto windowLogMax {std::clamp(maxWindowLog, windowLogBounds.lowerBound, windowLogBounds.upperBound)};
+        checkZstd(ZSTD_DCtx_setParameter(context.get(), ZSTD_d_windowLogMax, windowLogMax), "setParameter");
+        checkZstd(ZSTD_DCtx_refPrefix(context.get(), base.data(), base.size()), "refPrefix");
+
+        std::unique_ptr<FILE, deleterFile> input {fopen(patchFile.c_str(), "rb")};
+        std::unique_ptr<FILE, deleterFile> output {fopen(outputFile.c_str(), "wb")};
+        if (!input || !output)
+        {
+            throw std::runtime_error("DeltaPatcher::apply failed: Couldn't open the patch or the output file");
+        }
+
+        Sha256Hasher hasher;
+        std::vector<char> inputBuffer(ZSTD_DStreamInSize());
+        std::vector<char> outputBuffer(ZSTD_DStreamOutSize());
+        size_t remaining {1};
+        size_t read {0};
+
+        while ((read = fread(inputBuffer.data(), 1, inputBuffer.size(), input.get())) > 0)
+        {
+            ZSTD_inBuffer in {inputBuffer.data(), read, 0};
+            while (in.pos < in.size)
+            {
+                if (remaining == 0)
+                {
+                    throw std::runtime_error("DeltaPatcher::apply failed: Unexpected data after the patch frame");
+                }
+
+                ZSTD_outBuffer out {outputBuffer.data(), outputBuffer.size(), 0};
+                remaining = ZSTD_decompressStream(context.get(), &out, &in);
+                checkZstd(remaining, "decompressStream");
+
+                if (fwrite(outputBuffer.data(), 1, out.pos, output.get()) != out.pos)
+                {
+                    throw std::runtime_error("DeltaPatcher::apply failed: Couldn't write the output file");
+                }
+                hasher.update(outputBuffer.data(), out.pos);
+            }
+        }
+
+        // Flush the data the decoder may still hold.
+        while (remaining != 0 && !ferror(input.get()))
+        {
+            ZSTD_inBuffer in {nullptr, 0, 0};
+            ZSTD_outBuffer out {outputBuffer.data(), outputBuffer.size(), 0};
+            remaining = ZSTD_decompressStream(context.get(), &out, &in);
+            checkZstd(remaining, "decompressStream");
+            if (out.pos == 0)
+            {
+                break;
+            }
+            if (fwrite(outputBuffer.data(), 1, out.pos, output.get()) != out.pos)
+            {
+                throw std::runtime_error("DeltaPatcher::apply failed: Couldn't write the output file");
+            }
+            hasher.update(outputBuffer.data(), out.pos);
+        }
+
+        if (ferror(input.get()) || remaining != 0)
+        {
+            throw std::runtime_error("DeltaPatcher::apply failed: Truncated patch");
+        }
+        if (fflush(output.get()) != 0)
+        {
+            throw std::runtime_error("DeltaPatcher::apply failed: Couldn't write the output file");
+        }
+
+        return hasher.hexDigest();
+    }
+};
+
+/**
+ * @brief This class remembers the patches that the server doesn't publish, so a delta update doesn't request the same
+ * missing patch again. A patch is identified by its URL and the digest of the version it should produce: once a new
+ * version is expected, its patch is requested again.
+ */
+class MissingPatches final : public Singleton<MissingPatches>
+{
+private:
+    std::mutex m_mutex;
+    std::unordered_set<std::string> m_patches;
+
+public:
+    /**
+     * @brief Checks whether the patch is known to be missing.
+     *
+     * @param patchUrl Patch URL.
+     * @param expectedDigest Digest of the version the patch should produce.
+     * @return true if the server didn't publish the patch.
+     */
+    bool contains(const std::string& patchUrl, const std::string& expectedDigest)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_patches.find(patchUrl + '\n' + expectedDigest) != m_patches.end();
+    }
+
+    /**
+     * @brief Records a missing patch.
+     *
+     * @param patchUrl Patch URL.
+     * @param expectedDigest Digest of the version the patch should produce.
+     */
+    void insert(const std::string& patchUrl, const std::string& expectedDigest)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_patches.size() >= DELTA_MISSING_PATCHES_MAX_SIZE)
+        {
+            m_patches.clear();
+        }
+        m_patches.insert(patchUrl + '\n' + expectedDigest);
+    }
+
+    /**
+     * @brief Forgets the missing patches.
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_patches.clear();
+    }
+};
+
+#endif // _DELTA_PATCHER_HPP
@@ -0,0 +1,289 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _DOWNLOAD_STORE_HPP
+#define _DOWNLOAD_STORE_HPP
+
+#include "hashHelper.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <fcntl.h>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#endif
+
+// Second seed used to widen the entry names to 128 bits.
+constexpr uint64_t DOWNLOAD_STORE_HASH_SEED {0x9e3779b97f4a7c15ULL};
+constexpr auto DOWNLOAD_STORE_TMP_SUFFIX {".tmp"};
+// Suffix of the file whose modification time tracks the last use of an entry.
+constexpr auto DOWNLOAD_STORE_USE_SUFFIX {".used"};
+
+/**
+ * @brief This class is a content-addressed store of downloaded files.
+ *
+ * Entries are keyed by the URL and a validator of the content (a version, an ETag or a digest), so the same artifact
+ * downloaded into different output files is transferred once. Outputs are cloned from the entries with a copy-on-write
+ * reflink when the filesystem supports it, so they share their blocks, and copied otherwise. An output never shares its
+ * inode with an entry, so modifying it in place doesn't affect the store. The last use of every entry is tracked by a
+ * sidecar file, and the least recently used entries are removed when the store grows above its maximum size.
+ */
+class DownloadStore final
+{
+private:
+    std::filesystem::path m_path;
+    uintmax_t m_maxSize;
+
+    /**
+     * @brief Clones the file with a copy-on-write reflink, if the filesystem supports it.
+     *
+     * @param source Source file.
+     * @param destination Destination file, must not exist.
+     * @return true if the file was cloned.
+     */
+    static bool reflink(const std::filesystem::path& source, const std::filesystem::path& destination)
+    {
+#ifdef FICLONE
+        const auto sourceFd {open(source.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (sourceFd < 0)
+        {
+            return false;
+        }
+        const auto destinationFd {open(destination.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644)};
+        if (destinationFd < 0)
+        {
+            close(sourceFd);
+            return false;
+        }
+
+        const auto cloned {ioctl(destinationFd, FICLONE, sourceFd) == 0};
+        close(destinationFd);
+        close(sourceFd);
+
+        if (!cloned)
+        {
+            std::error_code ec;
+            std::filesystem::remove(destination, ec);
+        }
+        return cloned;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Makes 'destination' a clone of 'source': a reflink when possible, a copy otherwise.
+     *
+     * @param source Existing file.
+     * @param destination Path to create, must not exist.
+     * @return true on success.
+     */
+    static bool clone(const std::filesystem::path& source, const std::filesystem::path& destination)
+    {
+        if (reflink(source, destination))
+        {
+            return true;
+        }
+
+        std::error_code ec;
+        return std::filesystem::copy_file(source, destination, ec) && !ec;
+    }
+
+    /**
+     * @brief Records the use of an entry, setting the modification time of its sidecar file to now.
+     *
+     * @param entry Entry path.
+     */
+    static void touch(const std::filesystem::path& entry)
+    {
+        auto sidecar {entry};
+        sidecar += DOWNLOAD_STORE_USE_SUFFIX;
+
+        const auto fd {open(sidecar.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644)};
+        if (fd >= 0)
+        {
+            futimens(fd, nullptr);
+            close(fd);
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new DownloadStore object. The store directory is created if it doesn't exist.
+     *
+     * @param path Directory of the store.
+     * @param maxSize Maximum size in bytes of the store.
+     */
+    DownloadStore(std::filesystem::path path, const uintmax_t maxSize)
+        : m_path {std::move(path)}
+        , m_maxSize {maxSize}
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(m_path, ec);
+    }
+
+    /**
+     * @brief Returns the path of the entry for the given URL and validator.
+     *
+     * @param url URL of the content.
+     * @param validator Validator of the content.
+     * @return std::filesystem::path Entry path, whether it exists or not.
+     */
+    std::filesystem::path entryPath(const std::string& url, const std::string& validator) const
+    {
+        const auto key {url + '\n' + validator};
+
+        std::ostringstream name;
+        name << std::hex << std::setfill('0') << std::setw(16) << Utils::fnv1aHash(key) << std::setw(16)
+             << Utils::fnv1aHash(key, DOWNLOAD_STORE_HASH_SEED);
+        return m_path / name.str();
+    }
+
+    /**
+     * @brief Clones the stored entry into the output file, if there is one.
+     *
+     * @param url URL of the content.
+     * @param validator Validator of the content.
+     * @param outputFile File to create. An existing file is replaced.
+     * @return true if the output was served from the store, false if it must be downloaded.
+     */
+    bool fetch(const std::string& url, const std::string& validator, const std::string& outputFile) const
+    {
+        const auto entry {entryPath(url, validator)};
+
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(entry, ec))
+        {
+            return false;
+        }
+
+        std::filesystem::remove(outputFile, ec);
+        if (!clone(entry, outputFile))
+        {
+            return false;
+        }
+
+        touch(entry);
+        return true;
+    }
+
+    /**
+     * @brief Adds a downloaded file to the store and removes the least recently used entries if the store is full.
+     *
+     * @param url URL of the content.
+     * @param validator Validator of the content.
+     * @param outputFile Downloaded file.
+     * @return true if the file was stored.
+     */
+    bool store(const std::string& url, const std::string& validator, const std::string& outputFile)
+    {
+        const auto entry {entryPath(url, validator)};
+        auto temporary {entry};
+        temporary += DOWNLOAD_STORE_TMP_SUFFIX + std::to_string(getpid());
+
+        std::error_code ec;
+        std::filesystem::remove(temporary, ec);
+        if (!clone(outputFile, temporary))
+        {
+            return false;
+        }
+
+        // Publish the entry atomically, other processes may be looking it up.
+        std::filesystem::rename(temporary, entry, ec);
+        if (ec)
+        {
+            std::filesystem::remove(temporary, ec);
+            return false;
+        }
+
+        touch(entry);
+        collectGarbage();
+        return true;
+    }
+
+    /**
+     * @brief Removes the least recently used entries until the store fits in its maximum size.
+     */
+    void collectGarbage()
+    {
+        struct Entry
+        {
+            std::filesystem::path path;
+            std::filesystem::file_time_type lastUse;
+            uintmax_t size;
+        };
+
+        std::vector<Entry> entries;
+        uintmax_t totalSize {0};
+
+        std::error_code ec;
+        for (std::filesystem::directory_iterator it {m_path, ec}, end; !ec && it != end; it.increment(ec))
+        {
+            std::error_code entryEc;
+            const auto name {it->path().filename().string()};
+            if (!it->is_regular_file(entryEc) || name.find(DOWNLOAD_STORE_TMP_SUFFIX) != std::string::npos ||
+                name.find(DOWNLOAD_STORE_USE_SUFFIX) != std::string::npos)
+            {
+                continue;
+            }
+
+            // Entries without a sidecar, being published, are taken as used when they were written.
+            auto sidecar {it->path()};
+            sidecar += DOWNLOAD_STORE_USE_SUFFIX;
+            auto lastUse {std::filesystem::last_write_time(sidecar, entryEc)};
+            if (entryEc)
+            {
+                entryEc.clear();
+                lastUse = it->last_write_time(entryEc);
+            }
+            const auto size {it->file_size(entryEc)};
+            if (!entryEc)
+            {
+                entries.push_back({it->path(), lastUse, size});
+                totalSize += size;
+            }
+        }
+
+        if (totalSize <= m_maxSize)
+        {
+            return;
+        }
+
+        std::sort(entries.begin(),
+                  entries.end(),
+                  [](const Entry& lhs, const Entry& rhs) { return lhs.lastUse < rhs.lastUse; });
+
+        for (const auto& entry : entries)
+        {
+            if (totalSize <= m_maxSize)
+            {
+                break;
+            }
+            if (std::filesystem::remove(entry.path, ec))
+            {
+                totalSize -= entry.size;
+                auto sidecar {entry.path};
+                sidecar += DOWNLOAD_STORE_USE_SUFFIX;
+                std::filesystem::remove(sidecar, ec);
+            }
+        }
+    }
+};
+
+#endif // _DOWNLOAD_STORE_HPP
@@ -13,10 +13,16 @@
 #define _FACTORY_REQUEST_WRAPPER_HPP
 
 #include "IRequestImplementator.hpp"
+#include "curlHandlerCache.hpp"
 #include "curlWrapper.hpp"
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <stdexcept>
+#include <utility>
+#include <vector>
+
+static const size_t WRAPPER_POOL_MAX_SIZE = 4;
 
 /**
  * @brief This class is a factory for IRequestImplementator.
@@ -59,6 +65,75 @@ public:
     {
         return std::make_shared<cURLWrapper>(handlerType, shouldRun);
     }
+
+    /**
+     * @brief Create a cURLRequest over the given cURL handler.
+     *
+     * @param curlHandler cURL handler owned by the request.
+     * @return A shared pointer to a cURLRequest.
+     */
+    static std::shared_ptr<IRequestImplementator> create(std::shared_ptr<ICURLHandler> curlHandler)
+    {
+        return std::make_shared<cURLWrapper>(std::move(curlHandler));
+    }
+
+    /**
+     * @brief Get a cURLRequest from the pool of the calling thread, creating it only if none is free. A wrapper is
+     * free when the pool holds its only reference: once the request that uses it is destroyed, it drops its handler
+     * and goes back to the pool, so that free wrappers don't keep the handles evicted from the cache alive. Reused
+     * wrappers are rebound to the handler cached for the thread and reset.
+     *
+     * @param handlerType Type of the cURL handler. Default is 'SINGLE'.
+     * @param shouldRun Flag used to interrupt the cURL handler.
+     * @param hstsCachePath HSTS cache file the request uses, empty if none.
+     * @param altSvcCachePath Alt-Svc cache file the request uses, empty if none.
+     * @return A shared pointer to a cURLRequest, which must not be shared with other threads.
+     */
+    static std::shared_ptr<cURLWrapper> acquire(CurlHandlerTypeEnum handlerType = CurlHandlerTypeEnum::SINGLE,
+                                                const std::atomic<bool>& shouldRun = true,
+                                                const std::string& hstsCachePath = {},
+                                                const std::string& altSvcCachePath = {})
+    {
+        thread_local std::vector<std::shared_ptr<cURLWrapper>> pool;
+
+        auto curlHandler {
+            cURLHandlerCache::instance().getCurlHandler(handlerType, shouldRun, hstsCachePath, altSvcCachePath)};
+
+        const auto it {std::find_if(pool.begin(),
+                                    pool.end(),
+                                    [](const std::shared_ptr<cURLWrapper>& wrapper)
+                                    { return wrapper.use_count() == 1; })};
+        if (it != pool.end())
+        {
+            (*it)->rebind(std::move(curlHandler));
+            return lend(*it);
+        }
+
+        auto wrapper {std::make_shared<cURLWrapper>(std::move(curlHandler))};
+        if (pool.size() < WRAPPER_POOL_MAX_SIZE)
+        {
+            pool.push_back(wrapper);
+        }
+        return lend(std::move(wrapper));
+    }
+
+private:
+    /**
+     * @brief Gives a wrapper to a request. The wrapper drops its handler when the request releases it.
+     *
+     * @param wrapper Wrapper of the pool.
+     * @return A shared pointer to the wrapper, which returns it to the pool when it's destroyed.
+     */
+    static std::shared_ptr<cURLWrapper> lend(std::shared_ptr<cURLWrapper> wrapper)
+    {
+        const auto pointer {wrapper.get()};
+        return {pointer,
+                [owner = std::move(wrapper)](cURLWrapper*) mutable
+                {
+                    owner->releaseHandler();
+                    owner.reset();
+                }};
+    }
 };
 
 #endif // _FACTORY_REQUEST_WRAPPER_HPP
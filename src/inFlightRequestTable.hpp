@@ -0,0 +1,363 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _IN_FLIGHT_REQUEST_TABLE_HPP
+#define _IN_FLIGHT_REQUEST_TABLE_HPP
+
+#include "IRequestImplementator.hpp"
+#include "IURLRequest.hpp"
+#include "singleton.hpp"
+#include "utf8Helper.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <utility>
+
+// Requests tracked at once, the ones started while the table is full aren't tracked.
+constexpr size_t IN_FLIGHT_CAPACITY {1024};
+
+// Words of the method of a tracked request, which keeps its first 8 bytes.
+constexpr size_t IN_FLIGHT_METHOD_WORDS {1};
+
+// Words of the URL of a tracked request, which keeps the first 256 bytes before its query, without splitting a UTF-8
+// character.
+constexpr size_t IN_FLIGHT_URL_WORDS {32};
+
+constexpr std::array<std::pair<CurlHandlerTypeEnum, std::string_view>, 3> HANDLER_TYPE_NAMES {{
+    {CurlHandlerTypeEnum::SINGLE, "single"},
+    {CurlHandlerTypeEnum::MULTI, "multi"},
+    {CurlHandlerTypeEnum::SHARED_MULTI, "shared_multi"}}};
+
+static_assert(isIndexedByKey(HANDLER_TYPE_NAMES, HANDLER_TYPE_NAMES.size()),
+              "HANDLER_TYPE_NAMES must be in the order of CurlHandlerTypeEnum");
+
+/**
+ * @struct InFlightRequest
+ * @brief The structure holds a request being performed, as read from the table.
+ */
+struct InFlightRequest
+{
+    std::string_view method {};          ///< Method of the request.
+    std::string_view url {};             ///< URL of the request, empty until the transfer starts.
+    CurlHandlerTypeEnum handlerType {};  ///< Type of the handler performing the request.
+    int64_t threadId {0};                ///< Thread performing the request, as given by the system.
+    std::chrono::microseconds start {0}; ///< Start of the request, on the steady clock.
+    uint64_t bytesReceived {0};          ///< Bytes of the response received so far.
+    uint64_t bytesSent {0};              ///< Bytes of the request body sent so far.
+};
+
+//! InFlightRequestTable class
+/**
+ * @brief This class keeps the requests being performed by the process, so they can be listed when a request hangs.
+ * The requests are kept in a fixed array of slots, each one guarded by a sequence number that is odd while the slot is
+ * written: a request takes a free slot without locking when it starts and frees it when it's done, and a reader drops
+ * the slots that change while they're read. Each thread starts looking for a free slot from the last one it took.
+ *
+ * The requests are only tracked once the table is enabled, until then checking whether it's enabled is all their cost.
+ */
+class InFlightRequestTable final : public Singleton<InFlightRequestTable>
+{
+private:
+    /**
+     * @brief Slot of the table. The fields are atomics, so a slot can be read while it's written.
+     */
+    struct Slot
+    {
+        std::atomic<uint64_t> m_sequence {0}; ///< Odd while the slot is written.
+        std::atomic<bool> m_active {false};
+        std::array<std::atomic<uint64_t>, IN_FLIGHT_METHOD_WORDS> m_method {};
+        std::array<std::atomic<uint64_t>, IN_FLIGHT_URL_WORDS> m_url {};
+        std::atomic<uint16_t> m_urlSize {0};
+        std::atomic<uint8_t> m_handlerType {0};
+        std::atomic<int64_t> m_threadId {0};
+        std::atomic<int64_t> m_start {0};
+        std::atomic<uint64_t> m_bytesReceived {0};
+        std::atomic<uint64_t> m_bytesSent {0};
+    };
+
+    inline static std::atomic<bool> s_enabled {false}; ///< The requests are tracked.
+
+    std::unique_ptr<Slot[]> m_slots {std::make_unique<Slot[]>(IN_FLIGHT_CAPACITY)};
+    std::atomic<uint64_t> m_untracked {0}; ///< Requests not tracked because the table was full.
+
+    static int64_t threadId()
+    {
+        thread_local const auto id {static_cast<int64_t>(syscall(SYS_gettid))};
+        return id;
+    }
+
+    /**
+     * @brief Copies a string into the words of a slot. Only the words the string takes are written.
+     *
+     * @param words Words of the slot.
+     * @param value String, truncated to the size of the words on a UTF-8 character boundary.
+     * @return size_t Bytes copied.
+     */
+    template<size_t N>
+    static size_t store(std::array<std::atomic<uint64_t>, N>& words, std::string_view value)
+    {
+        std::array<uint64_t, N> buffer {};
+        const auto size {Utils::utf8Prefix(value, sizeof(buffer)).size()};
+        if (size != 0)
+        {
+            std::memcpy(buffer.data(), value.data(), size);
+        }
+        for (size_t i = 0; i < (size + sizeof(uint64_t) - 1) / sizeof(uint64_t); ++i)
+        {
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        return size;
+    }
+
+    /**
+     * @brief Copies the words of a slot.
+     *
+     * @param words Words of the slot.
+     * @param size Bytes to copy.
+     * @return std::array<uint64_t, N> Copy, the rest of the words are zero.
+     */
+    template<size_t N>
+    static std::array<uint64_t, N> load(const std::array<std::atomic<uint64_t>, N>& words, const size_t size)
+    {
+        std::array<uint64_t, N> buffer {};
+        for (size_t i = 0; i < std::min(N, (size + sizeof(uint64_t) - 1) / sizeof(uint64_t)); ++i)
+        {
+            buffer[i] = words[i].load(std::memory_order_relaxed);
+        }
+        return buffer;
+    }
+
+    /**
+     * @brief Returns a URL without its query and fragment, which may hold credentials or personal data.
+     *
+     * @param url URL.
+     * @return std::string_view URL without its query, a view into the URL.
+     */
+    static std::string_view withoutQuery(std::string_view url)
+    {
+        return url.substr(0, url.find_first_of("?#"));
+    }
+
+public:
+    /**
+     * @brief Returns whether the requests are tracked.
+     *
+     * @return true if the table is enabled.
+     */
+    static bool enabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Starts tracking the requests.
+     */
+    static void enable()
+    {
+        s_enabled.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Stops tracking the requests. The requests being tracked are listed until they're done.
+     */
+    static void disable()
+    {
+        s_enabled.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Request tracked from its construction to its destruction. The request isn't tracked if the table is full.
+     */
+    class Entry final
+    {
+    private:
+        Slot* m_slot {nullptr};
+        bool m_hasUrl {false};
+
+        /**
+         * @brief Opens the slot for writing.
+         */
+        void beginWrite()
+        {
+            m_slot->m_sequence.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        /**
+         * @brief Closes the slot after writing.
+         */
+        void endWrite()
+        {
+            m_slot->m_sequence.fetch_add(1, std::memory_order_release);
+        }
+
+    public:
+        /**
+         * @brief Tracks a request.
+         *
+         * @param method Method of the request, GET if it's empty.
+         * @param url URL of the request, it can be set once the transfer starts. Its query isn't kept.
+         * @param handlerType Type of the handler performing the request.
+         */
+        Entry(std::string_view method, std::string_view url, const CurlHandlerTypeEnum handlerType)
+        {
+            thread_local size_t hint {0};
+            auto& table {InFlightRequestTable::instance()};
+            for (size_t i = 0; i < IN_FLIGHT_CAPACITY && m_slot == nullptr; ++i)
+            {
+                auto& slot {table.m_slots[(hint + i) % IN_FLIGHT_CAPACITY]};
+                // The sequence changes whenever the slot is taken or freed, so a free slot read with an even sequence
+                // is still free if the sequence doesn't change.
+                auto sequence {slot.m_sequence.load(std::memory_order_acquire)};
+                if (sequence % 2 == 0 && !slot.m_active.load(std::memory_order_relaxed) &&
+                    slot.m_sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire))
+                {
+                    hint = (hint + i) % IN_FLIGHT_CAPACITY;
+                    m_slot = &slot;
+                }
+            }
+
+            if (m_slot == nullptr)
+            {
+                table.m_untracked.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            std::atomic_thread_fence(std::memory_order_release);
+            store(m_slot->m_method, method.empty() ? std::string_view("GET") : method);
+            m_slot->m_urlSize.store(static_cast<uint16_t>(store(m_slot->m_url, withoutQuery(url))),
+                                    std::memory_order_relaxed);
+            m_hasUrl = !url.empty();
+            m_slot->m_handlerType.store(static_cast<uint8_t>(handlerType), std::memory_order_relaxed);
+            m_slot->m_threadId.store(threadId(), std::memory_order_relaxed);
+            m_slot->m_start.store(std::chrono::duration_cast<std::chrono::microseconds>(
+                                      std::chrono::steady_clock::now().time_since_epoch())
+                                      .count(),
+                                  std::memory_order_relaxed);
+            m_slot->m_bytesReceived.store(0, std::memory_order_relaxed);
+            m_slot->m_bytesSent.store(0, std::memory_order_relaxed);
+            m_slot->m_active.store(true, std::memory_order_relaxed);
+            endWrite();
+        }
+
+        ~Entry()
+        {
+            if (m_slot != nullptr)
+            {
+                beginWrite();
+                m_slot->m_active.store(false, std::memory_order_relaxed);
+                endWrite();
+            }
+        }
+
+        Entry(const Entry&) = delete;
+        Entry& operator=(const Entry&) = delete;
+
+        /**
+         * @brief Returns whether the request is tracked without its URL.
+         *
+         * @return true if the URL should be set.
+         */
+        bool needsUrl() const
+        {
+            return m_slot != nullptr && !m_hasUrl;
+        }
+
+        /**
+         * @brief Sets the URL of the request, if it isn't set yet.
+         *
+         * @param url URL of the request. Its query isn't kept.
+         */
+        void url(std::string_view url)
+        {
+            if (needsUrl() && !url.empty())
+            {
+                beginWrite();
+                m_slot->m_urlSize.store(static_cast<uint16_t>(store(m_slot->m_url, withoutQuery(url))),
+                                        std::memory_order_relaxed);
+                endWrite();
+                m_hasUrl = true;
+            }
+        }
+
+        /**
+         * @brief Updates the bytes transferred so far. A single counter is written at once, so the slot isn't opened.
+         *
+         * @param received Bytes of the response received.
+         * @param sent Bytes of the request body sent.
+         */
+        void progress(const uint64_t received, const uint64_t sent)
+        {
+            if (m_slot != nullptr)
+            {
+                m_slot->m_bytesReceived.store(received, std::memory_order_relaxed);
+                m_slot->m_bytesSent.store(sent, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    /**
+     * @brief Reads the requests being performed.
+     *
+     * @param callback Callback that receives each request. The method and the URL are only valid during the call.
+     */
+    template<typename TCallback>
+    void read(TCallback&& callback) const
+    {
+        for (size_t i = 0; i < IN_FLIGHT_CAPACITY; ++i)
+        {
+            const auto& slot {m_slots[i]};
+            const auto sequence {slot.m_sequence.load(std::memory_order_acquire)};
+            if (sequence % 2 != 0 || !slot.m_active.load(std::memory_order_relaxed))
+            {
+                continue;
+            }
+
+            const auto method {load(slot.m_method, sizeof(uint64_t) * IN_FLIGHT_METHOD_WORDS)};
+            const auto urlSize {slot.m_urlSize.load(std::memory_order_relaxed)};
+            const auto url {load(slot.m_url, urlSize)};
+            const auto methodName {reinterpret_cast<const char*>(method.data())};
+            const InFlightRequest request {
+                {methodName, strnlen(methodName, sizeof(method))},
+                {reinterpret_cast<const char*>(url.data()), std::min<size_t>(urlSize, sizeof(url))},
+                static_cast<CurlHandlerTypeEnum>(slot.m_handlerType.load(std::memory_order_relaxed)),
+                slot.m_threadId.load(std::memory_order_relaxed),
+                std::chrono::microseconds(slot.m_start.load(std::memory_order_relaxed)),
+                slot.m_bytesReceived.load(std::memory_order_relaxed),
+                slot.m_bytesSent.load(std::memory_order_relaxed)};
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.m_sequence.load(std::memory_order_relaxed) == sequence)
+            {
+                callback(request);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the number of requests that weren't tracked because the table was full.
+     *
+     * @return uint64_t Untracked requests.
+     */
+    uint64_t untracked() const
+    {
+        return m_untracked.load(std::memory_order_relaxed);
+    }
+};
+
+#endif // _IN_FLIGHT_REQUEST_TABLE_HPP
@@ -0,0 +1,247 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PARSED_URL_HPP
+#define _PARSED_URL_HPP
+
+#include "customDeleter.hpp"
+#include <curl/curl.h>
+#include <memory>
+#include <string>
+
+/**
+ * @brief This class holds a URL parsed into a cURL URL handle and its components. The handle is given to libcurl with
+ * CURLOPT_CURLU, so the URL isn't parsed again on each request.
+ */
+class ParsedURL final
+{
+private:
+    using deleterCurlUrl = CustomDeleter<decltype(&curl_url_cleanup), curl_url_cleanup>;
+
+    std::unique_ptr<CURLU, deleterCurlUrl> m_handle;
+    std::string m_url;
+    std::string m_scheme;
+    std::string m_host;
+    std::string m_path;
+    std::string m_query;
+    long m_port {0};
+
+    explicit ParsedURL(std::unique_ptr<CURLU, deleterCurlUrl> handle)
+        : m_handle {std::move(handle)}
+    {
+    }
+
+    /**
+     * @brief Returns a component of the URL.
+     *
+     * @param part Component to get.
+     * @param flags Flags of curl_url_get.
+     * @param value Component value, empty if the URL doesn't have it.
+     * @return true if the component could be read or is missing, false on any other error.
+     */
+    bool part(const CURLUPart part, const unsigned int flags, std::string& value) const
+    {
+        char* text {nullptr};
+        const auto code {curl_url_get(m_handle.get(), part, &text, flags)};
+        if (code != CURLUE_OK)
+        {
+            return code == CURLUE_NO_QUERY || code == CURLUE_NO_PORT;
+        }
+        value = text;
+        curl_free(text);
+        return true;
+    }
+
+    /**
+     * @brief Reads the components of the URL from the handle.
+     *
+     * @return true if the URL is complete.
+     */
+    bool load()
+    {
+        std::string port;
+        if (!part(CURLUPART_URL, 0, m_url) || !part(CURLUPART_SCHEME, 0, m_scheme) ||
+            !part(CURLUPART_HOST, 0, m_host) || !part(CURLUPART_PATH, 0, m_path) ||
+            !part(CURLUPART_QUERY, 0, m_query) || !part(CURLUPART_PORT, CURLU_DEFAULT_PORT, port))
+        {
+            return false;
+        }
+        m_port = port.empty() ? 0 : std::stol(port);
+        return true;
+    }
+
+public:
+    /**
+     * @brief Parses a URL.
+     *
+     * @param url URL to parse.
+     * @return std::shared_ptr<const ParsedURL> Parsed URL, or nullptr if it isn't a valid URL. Invalid URLs are left
+     * to libcurl, which reports the error when the request is performed.
+     */
+    static std::shared_ptr<const ParsedURL> parse(const std::string& url)
+    {
+        std::unique_ptr<CURLU, deleterCurlUrl> handle {curl_url()};
+        if (!handle || curl_url_set(handle.get(), CURLUPART_URL, url.c_str(), 0) != CURLUE_OK)
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<ParsedURL> parsedUrl {new ParsedURL(std::move(handle))};
+        return parsedUrl->load() ? parsedUrl : nullptr;
+    }
+
+    /**
+     * @brief Appends a query string to the query of a URL that isn't parsed, before its fragment, as a parsed URL does.
+     *
+     * @param url URL, as a string.
+     * @param query Percent-encoded query string, without the leading '?'.
+     * @return std::string URL with the query.
+     */
+    static std::string appendQuery(const std::string& url, const std::string& query)
+    {
+        if (query.empty())
+        {
+            return url;
+        }
+
+        const auto fragment {url.find('#')};
+        auto withQuery {url.substr(0, fragment)};
+        withQuery.append(withQuery.find('?') == std::string::npos ? "?" : "&").append(query);
+        if (fragment != std::string::npos)
+        {
+            withQuery.append(url, fragment);
+        }
+        return withQuery;
+    }
+
+    /**
+     * @brief Returns a copy of the URL with a query string appended to its current query. The copy duplicates the
+     * parsed handle, so the URL isn't parsed again.
+     *
+     * @param query Percent-encoded query string, without the leading '?'.
+     * @return std::shared_ptr<const ParsedURL> Parsed URL with the query, or nullptr on error.
+     */
+    std::shared_ptr<const ParsedURL> withQuery(const std::string& query) const
+    {
+        std::unique_ptr<CURLU, deleterCurlUrl> handle {curl_url_dup(m_handle.get())};
+        if (!handle ||
+            (!query.empty() &&
+             curl_url_set(handle.get(), CURLUPART_QUERY, query.c_str(), m_query.empty() ? 0 : CURLU_APPENDQUERY) !=
+                 CURLUE_OK))
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<ParsedURL> parsedUrl {new ParsedURL(std::move(handle))};
+        return parsedUrl->load() ? parsedUrl : nullptr;
+    }
+
+    /**
+     * @brief Returns a copy of the URL without its user information (user name, password and login options).
+     *
+     * @return std::shared_ptr<const ParsedURL> Parsed URL without user information, or nullptr on error.
+     */
+    std::shared_ptr<const ParsedURL> withoutUserInfo() const
+    {
+        std::unique_ptr<CURLU, deleterCurlUrl> handle {curl_url_dup(m_handle.get())};
+        if (!handle || curl_url_set(handle.get(), CURLUPART_USER, nullptr, 0) != CURLUE_OK ||
+            curl_url_set(handle.get(), CURLUPART_PASSWORD, nullptr, 0) != CURLUE_OK ||
+            curl_url_set(handle.get(), CURLUPART_OPTIONS, nullptr, 0) != CURLUE_OK)
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<ParsedURL> parsedUrl {new ParsedURL(std::move(handle))};
+        return parsedUrl->load() ? parsedUrl : nullptr;
+    }
+
+    /**
+     * @brief Returns the cURL URL handle. libcurl only reads it, so it can be shared by concurrent requests.
+     *
+     * @return CURLU* URL handle.
+     */
+    CURLU* handle() const
+    {
+        return m_handle.get();
+    }
+
+    /**
+     * @brief Returns the normalized URL.
+     *
+     * @return const std::string& URL.
+     */
+    const std::string& url() const
+    {
+        return m_url;
+    }
+
+    /**
+     * @brief Returns the URL scheme, in lowercase.
+     *
+     * @return const std::string& Scheme.
+     */
+    const std::string& scheme() const
+    {
+        return m_scheme;
+    }
+
+    /**
+     * @brief Returns the URL host.
+     *
+     * @return const std::string& Host.
+     */
+    const std::string& host() const
+    {
+        return m_host;
+    }
+
+    /**
+     * @brief Returns the URL port, or the default port of the scheme if the URL doesn't set it.
+     *
+     * @return long Port.
+     */
+    long port() const
+    {
+        return m_port;
+    }
+
+    /**
+     * @brief Returns the URL path.
+     *
+     * @return const std::string& Path.
+     */
+    const std::string& path() const
+    {
+        return m_path;
+    }
+
+    /**
+     * @brief Returns the URL query, without the leading '?'.
+     *
+     * @return const std::string& Query, empty if the URL doesn't have it.
+     */
+    const std::string& query() const
+    {
+        return m_query;
+    }
+
+    /**
+     * @brief Returns whether the URL uses TLS.
+     *
+     * @return true if the scheme is 'https'.
+     */
+    bool isHttps() const
+    {
+        return m_scheme == "https";
+    }
+};
+
+#endif // _PARSED_URL_HPP
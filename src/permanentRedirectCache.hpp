@@ -0,0 +1,236 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PERMANENT_REDIRECT_CACHE_HPP
+#define _PERMANENT_REDIRECT_CACHE_HPP
+
+#include "parsedURL.hpp"
+#include "singleton.hpp"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <shared_mutex>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+#include <unordered_map>
+
+constexpr size_t PERMANENT_REDIRECT_CACHE_MAX_ENTRIES {1024};
+
+/**
+ * @brief This class caches the targets of permanent redirects (301 and 308), so the following requests to the same URL
+ * go straight to the target and skip the redirect round-trip.
+ *
+ * The targets may be on another origin (scheme, host and port), like a CDN or the HTTPS version of the URL. A request
+ * to such a target must not carry the credentials of the original one, as libcurl does when it follows the redirect.
+ *
+ * The cache lives in memory and, if it has a persistence file, is also stored as a JSON object ({"url": "target"}) so
+ * that it survives restarts.
+ */
+class PermanentRedirectCache final
+{
+private:
+    std::unordered_map<std::string, std::string> m_redirects;
+    const std::string m_path;
+    std::shared_mutex m_mutex;
+
+    /**
+     * @brief Writes the cache to the persistence file. The caller must hold the lock.
+     */
+    void save() const
+    {
+        if (m_path.empty())
+        {
+            return;
+        }
+
+        // Replace the file atomically, other processes may be loading it.
+        const auto temporary {m_path + ".tmp" + std::to_string(getpid())};
+        {
+            std::ofstream file(temporary, std::ios::trunc);
+            file << nlohmann::json(m_redirects).dump();
+            if (!file)
+            {
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temporary, m_path, ec);
+        if (ec)
+        {
+            std::filesystem::remove(temporary, ec);
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new PermanentRedirectCache object, loading the entries of the persistence file. An
+     * unreadable or corrupt file is ignored, it's overwritten on the next change.
+     *
+     * @param path Persistence file. Empty keeps the cache in memory only.
+     */
+    explicit PermanentRedirectCache(std::string path = {})
+        : m_path {std::move(path)}
+    {
+        if (m_path.empty())
+        {
+            return;
+        }
+
+        std::ifstream file(m_path);
+        if (!file)
+        {
+            return;
+        }
+
+        const auto entries = nlohmann::json::parse(file, nullptr, false);
+        if (!entries.is_object())
+        {
+            return;
+        }
+
+        for (const auto& [url, target] : entries.items())
+        {
+            if (target.is_string() && ParsedURL::parse(target.get<std::string>()) &&
+                m_redirects.size() < PERMANENT_REDIRECT_CACHE_MAX_ENTRIES)
+            {
+                m_redirects.emplace(url, target.get<std::string>());
+            }
+        }
+    }
+
+    /**
+     * @brief Checks whether two URLs have the same scheme, host and port.
+     *
+     * @param url First URL.
+     * @param target Second URL.
+     * @return true if both URLs are valid and have the same origin.
+     */
+    static bool sameOrigin(const std::string& url, const std::string& target)
+    {
+        const auto parsedUrl {ParsedURL::parse(url)};
+        const auto parsedTarget {ParsedURL::parse(target)};
+        return parsedUrl && parsedTarget && parsedUrl->scheme() == parsedTarget->scheme() &&
+               parsedUrl->port() == parsedTarget->port() &&
+               std::equal(parsedUrl->host().begin(),
+                          parsedUrl->host().end(),
+                          parsedTarget->host().begin(),
+                          parsedTarget->host().end(),
+                          [](const char a, const char b) { return std::tolower(a) == std::tolower(b); });
+    }
+
+    /**
+     * @brief Returns the URL a request to 'url' should be sent to.
+     *
+     * @param url Requested URL.
+     * @return std::string Cached target, or 'url' if it isn't permanently redirected.
+     */
+    std::string resolve(const std::string& url)
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        const auto it {m_redirects.find(url)};
+        return it != m_redirects.end() ? it->second : url;
+    }
+
+    /**
+     * @brief Caches a permanent redirect. Targets that aren't valid URLs are not cached.
+     *
+     * @param url Requested URL.
+     * @param target Final URL of the chain of permanent redirects.
+     */
+    void insert(const std::string& url, const std::string& target)
+    {
+        if (!ParsedURL::parse(target))
+        {
+            return;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        const auto it {m_redirects.find(url)};
+        if (it != m_redirects.end())
+        {
+            if (it->second == target)
+            {
+                return;
+            }
+            it->second = target;
+        }
+        else
+        {
+            if (m_redirects.size() >= PERMANENT_REDIRECT_CACHE_MAX_ENTRIES)
+            {
+                m_redirects.erase(m_redirects.begin());
+            }
+            m_redirects.emplace(url, target);
+        }
+        save();
+    }
+
+    /**
+     * @brief Removes a cached redirect, for example after its target stopped existing.
+     *
+     * @param url Requested URL.
+     */
+    void invalidate(const std::string& url)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        if (m_redirects.erase(url) > 0)
+        {
+            save();
+        }
+    }
+};
+
+/**
+ * @brief Class responsible for keeping one permanent redirects cache per persistence file during the life of the
+ * process, so requests configured with different files don't overwrite each other's.
+ */
+class PermanentRedirectCacheRegistry final : public Singleton<PermanentRedirectCacheRegistry>
+{
+private:
+    std::map<std::string, std::shared_ptr<PermanentRedirectCache>> m_caches;
+    std::mutex m_mutex;
+
+public:
+    /**
+     * @brief Returns the cache persisted in the given file, loading it on first use.
+     *
+     * @param path Persistence file. Empty returns the cache kept in memory only.
+     * @return std::shared_ptr<PermanentRedirectCache> Cache instance.
+     */
+    std::shared_ptr<PermanentRedirectCache> getCache(const std::string& path = {})
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& cache {m_caches[path]};
+        if (!cache)
+        {
+            cache = std::make_shared<PermanentRedirectCache>(path);
+        }
+        return cache;
+    }
+
+    /**
+     * @brief Drops all the caches from memory. The persistence files are kept.
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_caches.clear();
+    }
+};
+
+#endif // _PERMANENT_REDIRECT_CACHE_HPP
@@ -0,0 +1,516 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _REQUEST_METRICS_REGISTRY_HPP
+#define _REQUEST_METRICS_REGISTRY_HPP
+
+#include "IURLRequest.hpp"
+#include "singleton.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Sub-buckets of each power of two of the latency histogram, which bound its relative error to 1/8.
+constexpr uint64_t LATENCY_SUB_BUCKETS {8};
+
+// Powers of two covered by the latency histogram, in microseconds. Longer latencies fall in the last bucket.
+constexpr uint64_t LATENCY_MAGNITUDES {40};
+
+constexpr size_t LATENCY_BUCKETS {(LATENCY_MAGNITUDES - 1) * LATENCY_SUB_BUCKETS};
+
+/**
+ * @brief Log-linear (HDR-style) histogram of latencies in microseconds: each power of two is split into
+ * LATENCY_SUB_BUCKETS buckets, so any latency is recorded with a bounded relative error in a fixed array.
+ */
+class LatencyHistogram final
+{
+public:
+    std::array<uint64_t, LATENCY_BUCKETS> m_counts {}; ///< Latencies in each bucket.
+    uint64_t m_count {0};                              ///< Latencies recorded.
+    uint64_t m_sum {0};                                ///< Sum of the latencies.
+    uint64_t m_max {0};                                ///< Highest latency.
+
+    /**
+     * @brief Returns the bucket of a latency.
+     *
+     * @param value Latency in microseconds.
+     * @return size_t Bucket index.
+     */
+    static constexpr size_t bucket(const uint64_t value)
+    {
+        if (value < LATENCY_SUB_BUCKETS)
+        {
+            return value;
+        }
+
+        // Position of the highest bit, at least 3 since the value is at least LATENCY_SUB_BUCKETS.
+        size_t magnitude {0};
+        for (auto v {value}; v > 1; v >>= 1)
+        {
+            ++magnitude;
+        }
+        const auto shift {magnitude - 3};
+        const auto index {(magnitude - 2) * LATENCY_SUB_BUCKETS + ((value >> shift) & (LATENCY_SUB_BUCKETS - 1))};
+        return std::min(index, LATENCY_BUCKETS - 1);
+    }
+
+    /**
+     * @brief Returns the lowest latency that isn't in a bucket or any of the previous ones.
+     *
+     * @param index Bucket index.
+     * @return uint64_t Upper bound of the bucket, exclusive, in microseconds.
+     */
+    static constexpr uint64_t upperBound(const size_t index)
+    {
+        if (index < LATENCY_SUB_BUCKETS)
+        {
+            return index + 1;
+        }
+
+        const auto shift {index / LATENCY_SUB_BUCKETS - 1};
+        return (LATENCY_SUB_BUCKETS + index % LATENCY_SUB_BUCKETS + 1) << shift;
+    }
+
+    /**
+     * @brief Returns a percentile of the recorded latencies, as the upper bound of its bucket.
+     *
+     * @param percentile Percentile, between 0 and 100.
+     * @return uint64_t Latency in microseconds, 0 if nothing was recorded.
+     */
+    uint64_t percentile(const double percentile) const
+    {
+        if (m_count == 0)
+        {
+            return 0;
+        }
+
+        const auto rank {std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * m_count)))};
+        uint64_t cumulative {0};
+        for (size_t i = 0; i < m_counts.size(); ++i)
+        {
+            cumulative += m_counts[i];
+            if (cumulative >= rank)
+            {
+                return std::min(upperBound(i) - 1, m_max);
+            }
+        }
+        return m_max;
+    }
+};
+
+static_assert(LatencyHistogram::bucket(7) == 7 && LatencyHistogram::bucket(15) == 15,
+              "The latencies below 16 microseconds must have a bucket each");
+static_assert(LatencyHistogram::upperBound(LatencyHistogram::bucket(1000)) > 1000 &&
+                  LatencyHistogram::upperBound(LatencyHistogram::bucket(1000) - 1) <= 1000,
+              "A latency must be below the upper bound of its bucket and not below the one of the previous bucket");
+
+/**
+ * @brief Labels of the request counters.
+ */
+struct RequestLabels
+{
+    std::string method; ///< Method of the request.
+    long status;        ///< Status code, 0 if no response was received.
+    std::string host;   ///< Host of the last hop.
+};
+
+/**
+ * @brief Orders the request labels, and compares them with labels given as views so that they're only copied when a
+ * new combination is counted.
+ */
+struct RequestLabelsLess
+{
+    using is_transparent = void;
+
+    template<typename TLabels>
+    static std::tuple<std::string_view, long, std::string_view> tie(const TLabels& labels)
+    {
+        return {labels.method, labels.status, labels.host};
+    }
+
+    template<typename TLeft, typename TRight>
+    bool operator()(const TLeft& left, const TRight& right) const
+    {
+        return tie(left) < tie(right);
+    }
+};
+
+/**
+ * @brief Request labels given as views.
+ */
+struct RequestLabelsView
+{
+    std::string_view method; ///< Method of the request.
+    long status;             ///< Status code, 0 if no response was received.
+    std::string_view host;   ///< Host of the last hop.
+};
+
+/**
+ * @brief Aggregated values of the metrics.
+ */
+struct RequestMetricsSnapshot
+{
+    std::map<RequestLabels, uint64_t, RequestLabelsLess> m_requests; ///< Requests by method, status and host.
+    int64_t m_inFlight {0};                                          ///< Requests being performed.
+    uint64_t m_bytesReceived {0};                                    ///< Bytes of the response bodies.
+    uint64_t m_bytesSent {0};                                        ///< Bytes of the request bodies.
+    uint64_t m_transfers {0};                                        ///< Transfers performed.
+    uint64_t m_reusedConnections {0};                                ///< Transfers over a reused connection.
+    uint64_t m_handlerCacheHits {0};                                 ///< Handlers found in the handler cache.
+    uint64_t m_handlerCacheMisses {0};                               ///< Handlers created by the handler cache.
+    uint64_t m_handlerCacheEvictions {0};                            ///< Handlers evicted from the handler cache.
+    int64_t m_liveHandles {0};                                       ///< cURL handles alive.
+    LatencyHistogram m_latency;                                      ///< Latencies of the transfers.
+};
+
+/**
+ * @brief This class keeps the metrics of the requests of the process. Each thread updates its own shard, without
+ * contention, and the shards are only added up when the metrics are read. The shard of a thread that exits is merged
+ * into the totals of the retired threads.
+ */
+class RequestMetricsRegistry final : public Singleton<RequestMetricsRegistry>
+{
+private:
+    /**
+     * @brief Metrics of a thread. The counters are only incremented by the thread, and read and reset by the readers.
+     */
+    struct Shard
+    {
+        std::atomic<int64_t> m_inFlight {0};
+        std::atomic<uint64_t> m_bytesReceived {0};
+        std::atomic<uint64_t> m_bytesSent {0};
+        std::atomic<uint64_t> m_transfers {0};
+        std::atomic<uint64_t> m_reusedConnections {0};
+        std::atomic<uint64_t> m_handlerCacheHits {0};
+        std::atomic<uint64_t> m_handlerCacheMisses {0};
+        std::atomic<uint64_t> m_handlerCacheEvictions {0};
+        std::array<std::atomic<uint64_t>, LATENCY_BUCKETS> m_latencyCounts {};
+        std::atomic<uint64_t> m_latencySum {0};
+        std::atomic<uint64_t> m_latencyMax {0};
+        std::mutex m_requestsMutex; ///< Guards the insertions into 'm_requests' from the readers.
+        std::map<RequestLabels, std::atomic<uint64_t>, RequestLabelsLess> m_requests; ///< Entries are never erased.
+        std::pair<const RequestLabels, std::atomic<uint64_t>>* m_lastRequest {nullptr}; ///< Entry of the last request.
+
+        /**
+         * @brief Adds the shard to a snapshot.
+         *
+         * @param snapshot Snapshot.
+         */
+        void addTo(RequestMetricsSnapshot& snapshot)
+        {
+            snapshot.m_inFlight += m_inFlight.load(std::memory_order_relaxed);
+            snapshot.m_bytesReceived += m_bytesReceived.load(std::memory_order_relaxed);
+            snapshot.m_bytesSent += m_bytesSent.load(std::memory_order_relaxed);
+            snapshot.m_transfers += m_transfers.load(std::memory_order_relaxed);
+            snapshot.m_reusedConnections += m_reusedConnections.load(std::memory_order_relaxed);
+            snapshot.m_handlerCacheHits += m_handlerCacheHits.load(std::memory_order_relaxed);
+            snapshot.m_handlerCacheMisses += m_handlerCacheMisses.load(std::memory_order_relaxed);
+            snapshot.m_handlerCacheEvictions += m_handlerCacheEvictions.load(std::memory_order_relaxed);
+
+            auto& latency {snapshot.m_latency};
+            for (size_t i = 0; i < LATENCY_BUCKETS; ++i)
+            {
+                const auto count {m_latencyCounts[i].load(std::memory_order_relaxed)};
+                latency.m_counts[i] += count;
+                latency.m_count += count;
+            }
+            latency.m_sum += m_latencySum.load(std::memory_order_relaxed);
+            latency.m_max = std::max(latency.m_max, m_latencyMax.load(std::memory_order_relaxed));
+
+            std::lock_guard<std::mutex> lock(m_requestsMutex);
+            for (const auto& [labels, count] : m_requests)
+            {
+                if (const auto value {count.load(std::memory_order_relaxed)}; value != 0)
+                {
+                    snapshot.m_requests[labels] += value;
+                }
+            }
+        }
+
+        /**
+         * @brief Sets all the metrics to zero. The entries of the requests are kept, since the thread keeps a pointer
+         * to the last one it used.
+         */
+        void clear()
+        {
+            for (auto* counter : {&m_bytesReceived,
+                                  &m_bytesSent,
+                                  &m_transfers,
+                                  &m_reusedConnections,
+                                  &m_handlerCacheHits,
+                                  &m_handlerCacheMisses,
+                                  &m_handlerCacheEvictions,
+                                  &m_latencySum,
+                                  &m_latencyMax})
+            {
+                counter->store(0, std::memory_order_relaxed);
+            }
+            for (auto& count : m_latencyCounts)
+            {
+                count.store(0, std::memory_order_relaxed);
+            }
+
+            std::lock_guard<std::mutex> lock(m_requestsMutex);
+            for (auto& [labels, count] : m_requests)
+            {
+                count.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Returns the counter of a combination of labels, adding it if it's new. Only called by the thread.
+         *
+         * @param labels Labels of the request.
+         * @return std::atomic<uint64_t>& Counter.
+         */
+        std::atomic<uint64_t>& requests(const RequestLabelsView& labels)
+        {
+            // The requests of a thread usually repeat their labels, so the last entry is checked first.
+            if (m_lastRequest != nullptr &&
+                RequestLabelsLess::tie(m_lastRequest->first) == RequestLabelsLess::tie(labels))
+            {
+                return m_lastRequest->second;
+            }
+
+            // Only this thread inserts entries, so it can look them up without the lock.
+            auto it {m_requests.find(labels)};
+            if (it == m_requests.end())
+            {
+                RequestLabels newLabels {std::string(labels.method), labels.status, std::string(labels.host)};
+                std::lock_guard<std::mutex> lock(m_requestsMutex);
+                it = m_requests
+                         .emplace(std::piecewise_construct,
+                                  std::forward_as_tuple(std::move(newLabels)),
+                                  std::forward_as_tuple(0))
+                         .first;
+            }
+            m_lastRequest = &*it;
+            return it->second;
+        }
+    };
+
+    /**
+     * @brief Shards of the live threads and totals of the threads that exited. They're never destroyed, so the threads
+     * that exit after the registry, like the main thread at exit, can still retire their shards.
+     */
+    struct Shards
+    {
+        std::mutex m_mutex;               ///< Guards the shards and the retired totals.
+        std::vector<Shard*> m_live;       ///< Shards of the live threads.
+        RequestMetricsSnapshot m_retired; ///< Totals of the threads that exited.
+    };
+
+    /**
+     * @brief Returns the shards, which are leaked at exit on purpose.
+     *
+     * @return Shards& Shards.
+     */
+    static Shards& shards()
+    {
+        static auto* const s_shards {new Shards};
+        return *s_shards;
+    }
+
+    /**
+     * @brief Registers the shard of a thread while the thread lives.
+     */
+    class ShardRegistration final
+    {
+    public:
+        Shard m_shard;
+
+        ShardRegistration()
+        {
+            auto& registered {shards()};
+            std::lock_guard<std::mutex> lock(registered.m_mutex);
+            registered.m_live.push_back(&m_shard);
+        }
+
+        ~ShardRegistration()
+        {
+            auto& registered {shards()};
+            std::lock_guard<std::mutex> lock(registered.m_mutex);
+            m_shard.addTo(registered.m_retired);
+            registered.m_live.erase(std::find(registered.m_live.begin(), registered.m_live.end(), &m_shard));
+        }
+    };
+
+    inline static std::atomic<int64_t> s_liveHandles {0}; ///< cURL handles alive.
+
+    /**
+     * @brief Returns the shard of the calling thread.
+     *
+     * @return Shard& Shard.
+     */
+    static Shard& shard()
+    {
+        thread_local ShardRegistration registration;
+        return registration.m_shard;
+    }
+
+    static void increment(std::atomic<uint64_t>& counter, const uint64_t value = 1)
+    {
+        // An atomic read-modify-write, so a reset by a reader between the read and the write isn't lost.
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+public:
+    RequestMetricsRegistry() = default;
+    ~RequestMetricsRegistry() override = default;
+
+    /**
+     * @brief Returns the host of a URL.
+     *
+     * @param url URL.
+     * @return std::string_view Host, a view into the URL.
+     */
+    static std::string_view host(std::string_view url)
+    {
+        if (const auto scheme {url.find("://")}; scheme != std::string_view::npos)
+        {
+            url.remove_prefix(scheme + 3);
+        }
+        url = url.substr(0, url.find_first_of("/?#"));
+        if (const auto userInfo {url.rfind('@')}; userInfo != std::string_view::npos)
+        {
+            url.remove_prefix(userInfo + 1);
+        }
+
+        // An IPv6 address keeps its brackets, without the port.
+        if (!url.empty() && url.front() == '[')
+        {
+            return url.substr(0, url.find(']') + 1);
+        }
+        return url.substr(0, url.find(':'));
+    }
+
+    /**
+     * @brief Counts a request that is being performed.
+     */
+    void requestStarted()
+    {
+        auto& inFlight {shard().m_inFlight};
+        inFlight.store(inFlight.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records a request that finished, successfully or not.
+     *
+     * @param labels Method, status and host of the request.
+     * @param metrics Metrics of its transfer.
+     */
+    void requestFinished(const RequestLabelsView& labels, const TransferMetrics& metrics)
+    {
+        auto& current {shard()};
+        current.m_inFlight.store(current.m_inFlight.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        increment(current.m_bytesReceived, metrics.bytesReceived);
+        increment(current.m_bytesSent, metrics.bytesSent);
+        increment(current.m_transfers);
+        if (metrics.connectionReused)
+        {
+            increment(current.m_reusedConnections);
+        }
+
+        const auto latency {static_cast<uint64_t>(std::max<int64_t>(0, metrics.totalTime.count()))};
+        increment(current.m_latencyCounts[LatencyHistogram::bucket(latency)]);
+        increment(current.m_latencySum, latency);
+        auto max {current.m_latencyMax.load(std::memory_order_relaxed)};
+        while (latency > max && !current.m_latencyMax.compare_exchange_weak(max, latency, std::memory_order_relaxed))
+        {
+        }
+
+        increment(current.requests(labels));
+    }
+
+    /**
+     * @brief Counts a handler found in the handler cache.
+     */
+    void handlerCacheHit()
+    {
+        increment(shard().m_handlerCacheHits);
+    }
+
+    /**
+     * @brief Counts a handler created by the handler cache.
+     */
+    void handlerCacheMiss()
+    {
+        increment(shard().m_handlerCacheMisses);
+    }
+
+    /**
+     * @brief Counts a handler evicted from the handler cache.
+     */
+    void handlerCacheEviction()
+    {
+        increment(shard().m_handlerCacheEvictions);
+    }
+
+    /**
+     * @brief Counts a cURL handle created. The handles aren't counted by the shards: a handle is often freed by another
+     * thread than the one that created it, and it can be freed at exit, after the registry.
+     */
+    static void handleCreated()
+    {
+        s_liveHandles.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Counts a cURL handle freed.
+     */
+    static void handleDestroyed()
+    {
+        s_liveHandles.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Adds up the metrics of all the threads.
+     *
+     * @return RequestMetricsSnapshot Aggregated metrics.
+     */
+    RequestMetricsSnapshot snapshot()
+    {
+        auto& registered {shards()};
+        std::lock_guard<std::mutex> lock(registered.m_mutex);
+        auto snapshot {registered.m_retired};
+        for (auto* shard : registered.m_live)
+        {
+            shard->addTo(snapshot);
+        }
+        snapshot.m_liveHandles = s_liveHandles.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    /**
+     * @brief Sets the counters and histograms of all the threads to zero. The requests in flight are kept.
+     */
+    void reset()
+    {
+        auto& registered {shards()};
+        std::lock_guard<std::mutex> lock(registered.m_mutex);
+        registered.m_retired = {};
+        for (auto* shard : registered.m_live)
+        {
+            shard->clear();
+        }
+    }
+};
+
+#endif // _REQUEST_METRICS_REGISTRY_HPP
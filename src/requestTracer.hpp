@@ -0,0 +1,380 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _REQUEST_TRACER_HPP
+#define _REQUEST_TRACER_HPP
+
+#include "IURLRequest.hpp"
+#include "singleton.hpp"
+#include "utf8Helper.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Events kept by the tracer by default, about 1 MiB.
+constexpr size_t DEFAULT_TRACE_CAPACITY {8192};
+
+// Words of the detail of a trace event, which keeps its first 64 bytes, without splitting a UTF-8 character.
+constexpr size_t TRACE_DETAIL_WORDS {8};
+
+// Names of the transfer spans, string literals that outlive the events.
+constexpr std::array<std::string_view, 6> TRACE_METHOD_NAMES {"GET", "POST", "PUT", "PATCH", "DELETE", "HEAD"};
+
+/**
+ * @struct TraceEvent
+ * @brief The structure holds a span recorded by the tracer. The names are string literals.
+ */
+struct TraceEvent
+{
+    const char* name {nullptr};             ///< Name of the span.
+    const char* category {nullptr};         ///< Category of the span.
+    const char* detailName {nullptr};       ///< Name of the detail, nullptr without detail.
+    std::string_view detail {};             ///< Detail of the span, like the URL of a transfer.
+    std::chrono::microseconds start {0};    ///< Start of the span, on the steady clock.
+    std::chrono::microseconds duration {0}; ///< Duration of the span.
+    long status {0};                        ///< Status code of a transfer.
+    uint32_t threadId {0};                  ///< Thread that recorded the span.
+};
+
+//! RequestTracer class
+/**
+ * @brief This class records the spans of the requests (handler cache lookups, transfers and their phases, and
+ * callbacks) into a ring buffer, so they can be exported as a trace. Each event is written into the slot given by an
+ * atomic counter, guarded by the sequence number of the slot: a writer only takes a slot that isn't being written,
+ * and a reader drops the slots whose sequence number changes while they're read. The oldest events are overwritten
+ * once the buffer is full.
+ *
+ * The tracer is disabled by default, and then checking whether it's enabled is all the cost of a span.
+ */
+class RequestTracer final : public Singleton<RequestTracer>
+{
+private:
+    /**
+     * @brief Slot of the buffer. The fields are atomics, so a slot can be read while it's written.
+     */
+    struct Slot
+    {
+        std::atomic<uint64_t> m_sequence {0}; ///< Odd while the slot is written, 2 * (index + 1) once written.
+        std::atomic<const char*> m_name {nullptr};
+        std::atomic<const char*> m_category {nullptr};
+        std::atomic<const char*> m_detailName {nullptr};
+        std::array<std::atomic<uint64_t>, TRACE_DETAIL_WORDS> m_detail {};
+        std::atomic<uint8_t> m_detailSize {0};
+        std::atomic<int64_t> m_start {0};
+        std::atomic<int64_t> m_duration {0};
+        std::atomic<long> m_status {0};
+        std::atomic<uint32_t> m_threadId {0};
+    };
+
+    /**
+     * @brief Ring buffer of events.
+     */
+    struct Buffer
+    {
+        explicit Buffer(const size_t capacity)
+            : m_capacity {capacity}
+            , m_slots {std::make_unique<Slot[]>(capacity)}
+        {
+        }
+
+        const size_t m_capacity;
+        std::unique_ptr<Slot[]> m_slots;
+        std::atomic<uint64_t> m_next {0};  ///< Index of the next event.
+        std::atomic<uint64_t> m_first {0}; ///< Index of the first event not cleared.
+    };
+
+    inline static std::atomic<bool> s_enabled {false}; ///< The spans are recorded.
+
+    std::mutex m_mutex;                             ///< Guards the buffers.
+    std::atomic<Buffer*> m_buffer {nullptr};        ///< Buffer being written.
+    std::vector<std::unique_ptr<Buffer>> m_buffers; ///< Buffers allocated, kept for the writers still using them.
+
+    static uint32_t threadId()
+    {
+        static std::atomic<uint32_t> lastThreadId {0};
+        thread_local const uint32_t id {lastThreadId.fetch_add(1, std::memory_order_relaxed) + 1};
+        return id;
+    }
+
+public:
+    /**
+     * @brief Returns whether the spans are recorded.
+     *
+     * @return true if the tracer is enabled.
+     */
+    static bool enabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the current time on the steady clock.
+     *
+     * @return std::chrono::microseconds Time.
+     */
+    static std::chrono::microseconds now()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch());
+    }
+
+    /**
+     * @brief Starts recording the spans. A buffer is allocated the first time, or when the capacity changes, and the
+     * events recorded before are kept otherwise.
+     *
+     * @param capacity Events kept.
+     */
+    void enable(const size_t capacity = DEFAULT_TRACE_CAPACITY)
+    {
+        if (capacity == 0)
+        {
+            throw std::invalid_argument("The trace capacity must be greater than zero");
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (const auto buffer {m_buffer.load()}; buffer == nullptr || buffer->m_capacity != capacity)
+        {
+            // The previous buffer isn't freed, a writer may still be using it.
+            m_buffers.push_back(std::make_unique<Buffer>(capacity));
+            m_buffer.store(m_buffers.back().get());
+        }
+        s_enabled.store(true);
+    }
+
+    /**
+     * @brief Stops recording the spans. The events recorded are kept.
+     */
+    void disable()
+    {
+        s_enabled.store(false);
+    }
+
+    /**
+     * @brief Drops the events recorded.
+     */
+    void clear()
+    {
+        if (const auto buffer {m_buffer.load()}; buffer != nullptr)
+        {
+            buffer->m_first.store(buffer->m_next.load());
+        }
+    }
+
+    /**
+     * @brief Records a span. The event is dropped if its slot is being written by a writer that the others have lapped.
+     *
+     * @param event Span. The thread is the calling one.
+     */
+    void record(const TraceEvent& event) noexcept
+    {
+        const auto buffer {m_buffer.load(std::memory_order_acquire)};
+        if (buffer == nullptr)
+        {
+            return;
+        }
+
+        const auto index {buffer->m_next.fetch_add(1, std::memory_order_relaxed)};
+        auto& slot {buffer->m_slots[index % buffer->m_capacity]};
+        auto sequence {slot.m_sequence.load(std::memory_order_relaxed)};
+        if (sequence % 2 != 0 ||
+            !slot.m_sequence.compare_exchange_strong(sequence, 2 * index + 1, std::memory_order_relaxed))
+        {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::array<uint64_t, TRACE_DETAIL_WORDS> detail {};
+        const auto detailSize {Utils::utf8Prefix(event.detail, sizeof(detail)).size()};
+        if (detailSize != 0)
+        {
+            std::memcpy(detail.data(), event.detail.data(), detailSize);
+        }
+        for (size_t i = 0; i < TRACE_DETAIL_WORDS; ++i)
+        {
+            slot.m_detail[i].store(detail[i], std::memory_order_relaxed);
+        }
+        slot.m_detailSize.store(static_cast<uint8_t>(detailSize), std::memory_order_relaxed);
+        slot.m_name.store(event.name, std::memory_order_relaxed);
+        slot.m_category.store(event.category, std::memory_order_relaxed);
+        slot.m_detailName.store(event.detailName, std::memory_order_relaxed);
+        slot.m_start.store(event.start.count(), std::memory_order_relaxed);
+        slot.m_duration.store(event.duration.count(), std::memory_order_relaxed);
+        slot.m_status.store(event.status, std::memory_order_relaxed);
+        slot.m_threadId.store(threadId(), std::memory_order_relaxed);
+
+        slot.m_sequence.store(2 * (index + 1), std::memory_order_release);
+    }
+
+    /**
+     * @brief Records a transfer, from its start until now, and its phases: queueing, DNS, connect, TLS, send, wait and
+     * receive. The phases are taken from the transfer metrics, those that didn't happen are skipped.
+     *
+     * @param start Start of the transfer.
+     * @param method Method of the request.
+     * @param url URL of the request.
+     * @param status Status code.
+     * @param metrics Transfer metrics.
+     */
+    void recordTransfer(const std::chrono::microseconds start,
+                        const std::string_view method,
+                        const std::string_view url,
+                        const long status,
+                        const TransferMetrics& metrics) noexcept
+    {
+        const auto end {now()};
+        const auto name {std::find(TRACE_METHOD_NAMES.cbegin(), TRACE_METHOD_NAMES.cend(), method)};
+        record({method.empty() ? "GET" : (name != TRACE_METHOD_NAMES.cend() ? name->data() : "request"),
+                "transfer",
+                "url",
+                url,
+                start,
+                end - start,
+                status});
+
+        // The send phase needs the post-transfer time, without it the wait includes the upload.
+        const auto sent {metrics.postTransferTime.count() > 0 ? metrics.postTransferTime : metrics.preTransferTime};
+        const std::array<std::tuple<const char*, std::chrono::microseconds, std::chrono::microseconds>, 7> phases {{
+            {"queue", std::chrono::microseconds(0), metrics.queueTime},
+            {"dns", metrics.queueTime, metrics.nameLookupTime},
+            {"connect", metrics.nameLookupTime, metrics.connectTime},
+            {"tls", metrics.connectTime, metrics.appConnectTime},
+            {"send", metrics.preTransferTime, metrics.postTransferTime},
+            {"wait", sent, metrics.startTransferTime},
+            {"receive", metrics.startTransferTime, metrics.totalTime}}};
+        for (const auto& [name, phaseStart, phaseEnd] : phases)
+        {
+            if (phaseEnd > phaseStart)
+            {
+                record({name, "phase", nullptr, {}, start + phaseStart, std::min(phaseEnd, end - start) - phaseStart});
+            }
+        }
+    }
+
+    /**
+     * @brief Reads the events recorded, from the oldest to the newest.
+     *
+     * @param callback Callback that receives each event. The detail is only valid during the call.
+     */
+    template<typename TCallback>
+    void read(TCallback&& callback) const
+    {
+        const auto buffer {m_buffer.load(std::memory_order_acquire)};
+        if (buffer == nullptr)
+        {
+            return;
+        }
+
+        const auto next {buffer->m_next.load(std::memory_order_acquire)};
+        const auto first {std::max(buffer->m_first.load(), next > buffer->m_capacity ? next - buffer->m_capacity : 0)};
+        for (auto index {first}; index < next; ++index)
+        {
+            const auto& slot {buffer->m_slots[index % buffer->m_capacity]};
+            const auto sequence {slot.m_sequence.load(std::memory_order_acquire)};
+            if (sequence != 2 * (index + 1))
+            {
+                continue;
+            }
+
+            std::array<uint64_t, TRACE_DETAIL_WORDS> detail {};
+            for (size_t i = 0; i < TRACE_DETAIL_WORDS; ++i)
+            {
+                detail[i] = slot.m_detail[i].load(std::memory_order_relaxed);
+            }
+            const TraceEvent event {
+                slot.m_name.load(std::memory_order_relaxed),
+                slot.m_category.load(std::memory_order_relaxed),
+                slot.m_detailName.load(std::memory_order_relaxed),
+                {reinterpret_cast<const char*>(detail.data()), slot.m_detailSize.load(std::memory_order_relaxed)},
+                std::chrono::microseconds(slot.m_start.load(std::memory_order_relaxed)),
+                std::chrono::microseconds(slot.m_duration.load(std::memory_order_relaxed)),
+                slot.m_status.load(std::memory_order_relaxed),
+                slot.m_threadId.load(std::memory_order_relaxed)};
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.m_sequence.load(std::memory_order_relaxed) == sequence)
+            {
+                callback(event);
+            }
+        }
+    }
+
+    /**
+     * @brief Calls a callback of the request, recording the call as a span.
+     *
+     * @param callback Callback.
+     * @param args Arguments of the callback.
+     */
+    template<typename TCallback, typename... TArgs>
+    static void callback(const TCallback& callback, TArgs&&... args)
+    {
+        const TraceSpan span {"callback", "callback"};
+        callback(std::forward<TArgs>(args)...);
+    }
+
+    /**
+     * @brief Span recorded from its construction to its destruction, if the tracer was enabled when it was
+     * constructed.
+     */
+    class TraceSpan final
+    {
+    private:
+        const char* m_name;
+        const char* m_category;
+        std::chrono::microseconds m_start;
+        const char* m_detail {nullptr};
+
+    public:
+        TraceSpan(const char* name, const char* category)
+            : m_name {name}
+            , m_category {category}
+            , m_start {enabled() ? now() : std::chrono::microseconds(0)}
+        {
+        }
+
+        TraceSpan(const TraceSpan&) = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+
+        ~TraceSpan()
+        {
+            if (m_start.count() != 0)
+            {
+                RequestTracer::instance().record({m_name,
+                                                  m_category,
+                                                  m_detail != nullptr ? "result" : nullptr,
+                                                  m_detail != nullptr ? m_detail : "",
+                                                  m_start,
+                                                  now() - m_start});
+            }
+        }
+
+        /**
+         * @brief Sets the result of the span.
+         *
+         * @param result Result, a string literal.
+         */
+        void result(const char* result)
+        {
+            m_detail = result;
+        }
+    };
+};
+
+#endif // _REQUEST_TRACER_HPP
@@ -0,0 +1,470 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _SHARED_RESPONSE_CACHE_HPP
+#define _SHARED_RESPONSE_CACHE_HPP
+
+#include "hashHelper.hpp"
+#include "singleton.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+constexpr uint64_t SHARED_CACHE_MAGIC {0x45484341434c5255ULL}; // "URLCACHE"
+constexpr uint32_t SHARED_CACHE_VERSION {3};
+constexpr uint32_t SHARED_CACHE_DEFAULT_SLOT_COUNT {256};
+constexpr uint32_t SHARED_CACHE_DEFAULT_SLOT_SIZE {64 * 1024};
+constexpr int SHARED_CACHE_READ_RETRIES {4};
+constexpr mode_t SHARED_CACHE_FILE_MODE {0600};
+// Time after which the writer owning a slot is considered dead and the slot can be taken over, in milliseconds.
+constexpr int64_t SHARED_CACHE_WRITER_TIMEOUT {10000};
+
+/**
+ * @brief Header stored at the beginning of the cache file. Every process mapping the file validates it before use, so
+ * a layout change only requires bumping SHARED_CACHE_VERSION.
+ */
+struct SharedCacheHeader
+{
+    uint64_t magic;     ///< Always SHARED_CACHE_MAGIC.
+    uint32_t version;   ///< Layout version, SHARED_CACHE_VERSION.
+    uint32_t slotCount; ///< Number of slots in the index.
+    uint32_t slotSize;  ///< Size in bytes of every slot, including its metadata.
+    uint32_t reserved;  ///< Padding, always zero.
+};
+
+/**
+ * @brief Metadata of a cache slot. The key and the value are stored right after it, as words.
+ * The slot is protected by a seqlock: the sequence is odd while a writer owns the slot, and readers retry whenever it
+ * changes while they copy the content. Every field is atomic, since readers copy them while a writer may change them.
+ * A writer that takes the slot over from a dead one moves the sequence to a new odd value, so the dead writer can't
+ * publish it anymore, and the checksum lets readers drop the words it may still store.
+ */
+struct SharedCacheSlot
+{
+    std::atomic<uint32_t> sequence;  ///< Seqlock sequence number.
+    std::atomic<uint32_t> keySize;   ///< Size of the key in bytes.
+    std::atomic<uint32_t> valueSize; ///< Size of the value in bytes.
+    uint32_t reserved;               ///< Padding, always zero.
+    std::atomic<uint64_t> keyHash;   ///< FNV-1a hash of the key.
+    std::atomic<int64_t> expiration; ///< Expiration time, in milliseconds since epoch.
+    std::atomic<uint64_t> checksum;  ///< FNV-1a hash of the key and the value.
+    std::atomic<int64_t> owner;      ///< Time the current writer took the slot, in milliseconds since epoch, or 0.
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "The shared cache requires lock-free atomics");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The shared cache requires lock-free atomics");
+static_assert(sizeof(SharedCacheHeader) % alignof(SharedCacheSlot) == 0, "Invalid shared cache header size");
+static_assert(sizeof(SharedCacheSlot) % sizeof(uint64_t) == 0, "Invalid shared cache slot size");
+
+/**
+ * @brief This class is a response cache backed by a memory-mapped file, usually placed in '/dev/shm', which allows
+ * several processes of the same user on the same host to share the responses they fetch.
+ *
+ * The index is a fixed array of slots; a key can live in the slot its hash points to or in the following one. Neither
+ * readers nor writers block: a writer that finds the slot busy simply gives up, since the entry is only a cache. A slot
+ * left owned by a writer that died is taken over once SHARED_CACHE_WRITER_TIMEOUT has elapsed.
+ */
+class SharedResponseCache final
+{
+private:
+    struct MappingDeleter
+    {
+        size_t size;
+        void operator()(void* address) const
+        {
+            munmap(address, size);
+        }
+    };
+
+    std::unique_ptr<void, MappingDeleter> m_mapping;
+    SharedCacheHeader* m_header {nullptr};
+    uint8_t* m_slots {nullptr};
+
+    static int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+
+    SharedCacheSlot* slot(const uint64_t index) const
+    {
+        return reinterpret_cast<SharedCacheSlot*>(m_slots + (index % m_header->slotCount) * m_header->slotSize);
+    }
+
+    static std::atomic<uint64_t>* slotData(SharedCacheSlot* slot)
+    {
+        return reinterpret_cast<std::atomic<uint64_t>*>(slot + 1);
+    }
+
+    static size_t words(const size_t size)
+    {
+        return (size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    }
+
+    /**
+     * @brief Copies the value of the slot if it holds the given non-expired key.
+     *
+     * @param current Slot to read.
+     * @param key Key to look for.
+     * @param keyHash Hash of the key.
+     * @return std::optional<std::string> Value, or std::nullopt if the slot doesn't hold the key.
+     */
+    std::optional<std::string> read(SharedCacheSlot* current, const std::string& key, const uint64_t keyHash) const
+    {
+        const auto capacity {m_header->slotSize - sizeof(SharedCacheSlot)};
+
+        for (int retry = 0; retry < SHARED_CACHE_READ_RETRIES; ++retry)
+        {
+            const auto begin {current->sequence.load(std::memory_order_acquire)};
+            if (begin & 1)
+            {
+                continue;
+            }
+
+            const auto hash {current->keyHash.load(std::memory_order_relaxed)};
+            const auto keySize {current->keySize.load(std::memory_order_relaxed)};
+            const auto valueSize {current->valueSize.load(std::memory_order_relaxed)};
+            const auto expiration {current->expiration.load(std::memory_order_relaxed)};
+            const auto checksum {current->checksum.load(std::memory_order_relaxed)};
+
+            if (hash != keyHash || keySize != key.size() || static_cast<size_t>(keySize) + valueSize > capacity)
+            {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (current->sequence.load(std::memory_order_relaxed) == begin)
+                {
+                    return std::nullopt;
+                }
+                continue;
+            }
+
+            std::string content(words(static_cast<size_t>(keySize) + valueSize) * sizeof(uint64_t), '\0');
+            const auto data {slotData(current)};
+            for (size_t i = 0; i < content.size() / sizeof(uint64_t); ++i)
+            {
+                const auto word {data[i].load(std::memory_order_relaxed)};
+                std::memcpy(content.data() + i * sizeof(uint64_t), &word, sizeof(word));
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (current->sequence.load(std::memory_order_relaxed) != begin)
+            {
+                continue;
+            }
+
+            content.resize(static_cast<size_t>(keySize) + valueSize);
+            if (Utils::fnv1aHash(content) != checksum)
+            {
+                // Torn by a writer that lost the slot while storing it.
+                return std::nullopt;
+            }
+
+            if (content.compare(0, keySize, key) != 0 || expiration <= now())
+            {
+                return std::nullopt;
+            }
+            return content.substr(keySize, valueSize);
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Stores the entry in the slot, unless another writer currently owns it. A writer that loses the slot to
+     * another one, after SHARED_CACHE_WRITER_TIMEOUT, gives up without publishing it.
+     *
+     * @param current Slot to write.
+     * @param key Entry key.
+     * @param keyHash Hash of the key.
+     * @param value Entry value.
+     * @param expiration Expiration time, in milliseconds since epoch.
+     * @return true if the entry was stored.
+     */
+    static bool write(SharedCacheSlot* current,
+                      const std::string& key,
+                      const uint64_t keyHash,
+                      const std::string& value,
+                      const int64_t expiration)
+    {
+        // The owner is the time the slot was taken, so a slot held by a dead writer can be told from a busy one.
+        const auto timestamp {std::max<int64_t>(now(), 1)};
+        auto owner {current->owner.load(std::memory_order_relaxed)};
+        if ((owner != 0 && timestamp - owner < SHARED_CACHE_WRITER_TIMEOUT) ||
+            !current->owner.compare_exchange_strong(owner, timestamp, std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        // The odd sequence identifies this writer: a sequence left odd by a dead writer is moved to the next odd value,
+        // so the dead writer's publication fails.
+        auto previous {current->sequence.load(std::memory_order_relaxed)};
+        const auto sequence {(previous | 1) + (previous & 1 ? 2 : 0)};
+        if (!current->sequence.compare_exchange_strong(previous, sequence, std::memory_order_relaxed))
+        {
+            owner = timestamp;
+            current->owner.compare_exchange_strong(owner, 0, std::memory_order_release);
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::string content(key);
+        content.append(value);
+        const auto checksum {Utils::fnv1aHash(content)};
+        content.resize(words(content.size()) * sizeof(uint64_t), '\0');
+        const auto data {slotData(current)};
+        for (size_t i = 0; i < content.size() / sizeof(uint64_t); ++i)
+        {
+            // A writer that took longer than the timeout lost the slot, and stops as soon as it notices.
+            if (current->sequence.load(std::memory_order_relaxed) != sequence)
+            {
+                return false;
+            }
+            uint64_t word {0};
+            std::memcpy(&word, content.data() + i * sizeof(uint64_t), sizeof(word));
+            data[i].store(word, std::memory_order_relaxed);
+        }
+        current->keyHash.store(keyHash, std::memory_order_relaxed);
+        current->keySize.store(static_cast<uint32_t>(key.size()), std::memory_order_relaxed);
+        current->valueSize.store(static_cast<uint32_t>(value.size()), std::memory_order_relaxed);
+        current->expiration.store(expiration, std::memory_order_relaxed);
+        current->checksum.store(checksum, std::memory_order_relaxed);
+
+        // Only the owner of the odd sequence can publish the slot.
+        auto expected {sequence};
+        if (!current->sequence.compare_exchange_strong(expected, sequence + 1, std::memory_order_release))
+        {
+            return false;
+        }
+        auto expectedOwner {timestamp};
+        current->owner.compare_exchange_strong(expectedOwner, 0, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Checks whether the slot can be overwritten by a new key.
+     *
+     * @param current Slot to check.
+     * @return true if the slot is empty or its entry has expired.
+     */
+    static bool isReusable(const SharedCacheSlot* current)
+    {
+        return current->keySize.load(std::memory_order_relaxed) == 0 ||
+               current->expiration.load(std::memory_order_relaxed) <= now();
+    }
+
+    /**
+     * @brief Checks whether the slot holds the given key, as far as its hash and size tell.
+     *
+     * @param current Slot to check.
+     * @param keyHash Hash of the key.
+     * @param keySize Size of the key.
+     * @return true if the slot may hold the key.
+     */
+    static bool holds(const SharedCacheSlot* current, const uint64_t keyHash, const size_t keySize)
+    {
+        return current->keyHash.load(std::memory_order_relaxed) == keyHash &&
+               current->keySize.load(std::memory_order_relaxed) == keySize;
+    }
+
+public:
+    /**
+     * @brief Maps the cache file, creating and formatting it if it doesn't exist yet. The file must be a regular file
+     * owned by the effective user and not writable by anybody else, so another user can't plant poisoned responses.
+     *
+     * @param path Path of the cache file.
+     * @param slotCount Number of slots used when the file is created.
+     * @param slotSize Size of every slot used when the file is created.
+     */
+    explicit SharedResponseCache(const std::string& path,
+                                 const uint32_t slotCount = SHARED_CACHE_DEFAULT_SLOT_COUNT,
+                                 const uint32_t slotSize = SHARED_CACHE_DEFAULT_SLOT_SIZE)
+    {
+        if (slotCount == 0 || slotSize <= sizeof(SharedCacheSlot) || slotSize % alignof(SharedCacheSlot) != 0)
+        {
+            throw std::invalid_argument("Invalid shared cache geometry");
+        }
+
+        const auto fd {open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | O_NOFOLLOW, SHARED_CACHE_FILE_MODE)};
+        if (fd < 0)
+        {
+            throw std::runtime_error("Failed to open shared cache file: " + path);
+        }
+
+        // The exclusive lock is only held while the file is formatted or validated.
+        flock(fd, LOCK_EX);
+
+        struct stat fileStat {};
+        auto success {fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && fileStat.st_uid == geteuid() &&
+                      (fileStat.st_mode & (S_IWGRP | S_IWOTH)) == 0};
+        SharedCacheHeader header {SHARED_CACHE_MAGIC, SHARED_CACHE_VERSION, slotCount, slotSize, 0};
+
+        if (success && fileStat.st_size == 0)
+        {
+            const auto size {sizeof(SharedCacheHeader) + static_cast<size_t>(slotCount) * slotSize};
+            success = ftruncate(fd, static_cast<off_t>(size)) == 0 &&
+                      pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+        }
+        else if (success)
+        {
+            success = pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                      header.magic == SHARED_CACHE_MAGIC && header.version == SHARED_CACHE_VERSION &&
+                      header.slotCount > 0 && header.slotSize > sizeof(SharedCacheSlot) &&
+                      header.slotSize % alignof(SharedCacheSlot) == 0 &&
+                      static_cast<size_t>(fileStat.st_size) ==
+                          sizeof(SharedCacheHeader) + static_cast<size_t>(header.slotCount) * header.slotSize;
+        }
+
+        void* address {MAP_FAILED};
+        const auto size {sizeof(SharedCacheHeader) + static_cast<size_t>(header.slotCount) * header.slotSize};
+        if (success)
+        {
+            address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+
+        flock(fd, LOCK_UN);
+        close(fd);
+
+        if (!success)
+        {
+            throw std::runtime_error("Invalid or incompatible shared cache file: " + path);
+        }
+        if (address == MAP_FAILED)
+        {
+            throw std::runtime_error("Failed to map shared cache file: " + path);
+        }
+
+        m_mapping = std::unique_ptr<void, MappingDeleter>(address, MappingDeleter {size});
+        m_header = static_cast<SharedCacheHeader*>(address);
+        m_slots = static_cast<uint8_t*>(address) + sizeof(SharedCacheHeader);
+    }
+
+    /**
+     * @brief Looks up a non-expired entry.
+     *
+     * @param key Entry key.
+     * @return std::optional<std::string> Cached value, or std::nullopt on a miss.
+     */
+    std::optional<std::string> get(const std::string& key) const
+    {
+        const auto keyHash {Utils::fnv1aHash(key)};
+
+        for (uint64_t probe = 0; probe < 2; ++probe)
+        {
+            if (auto value {read(slot(keyHash + probe), key, keyHash)})
+            {
+                return value;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Stores an entry. Entries that don't fit in a slot are not stored.
+     *
+     * @param key Entry key.
+     * @param value Entry value.
+     * @param ttl Time to live of the entry.
+     * @return true if the entry was stored.
+     */
+    bool put(const std::string& key, const std::string& value, const std::chrono::milliseconds ttl)
+    {
+        if (key.empty() || key.size() + value.size() > m_header->slotSize - sizeof(SharedCacheSlot))
+        {
+            return false;
+        }
+
+        const auto keyHash {Utils::fnv1aHash(key)};
+        auto target {slot(keyHash)};
+        const auto neighbour {slot(keyHash + 1)};
+
+        // Keep the key where it already is, otherwise prefer a free slot.
+        if (!holds(target, keyHash, key.size()) &&
+            (holds(neighbour, keyHash, key.size()) || (!isReusable(target) && isReusable(neighbour))))
+        {
+            target = neighbour;
+        }
+
+        return write(target, key, keyHash, value, now() + ttl.count());
+    }
+
+    /**
+     * @brief Returns the number of slots of the index.
+     *
+     * @return uint32_t Number of slots.
+     */
+    uint32_t slotCount() const
+    {
+        return m_header->slotCount;
+    }
+};
+
+/**
+ * @brief Class responsible for keeping one mapping per cache file during the life of the process.
+ */
+class SharedResponseCacheRegistry final : public Singleton<SharedResponseCacheRegistry>
+{
+private:
+    std::map<std::string, std::shared_ptr<SharedResponseCache>> m_caches;
+    std::mutex m_mutex;
+
+public:
+    /**
+     * @brief Returns the cache backed by the given file, mapping it on first use.
+     * A file that can't be mapped disables the cache for that path, the requests are then always performed.
+     *
+     * @param path Path of the cache file.
+     * @return std::shared_ptr<SharedResponseCache> Cache instance, or nullptr if the file is unusable.
+     */
+    std::shared_ptr<SharedResponseCache> getCache(const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it {m_caches.find(path)};
+        if (it != m_caches.end())
+        {
+            return it->second;
+        }
+
+        std::shared_ptr<SharedResponseCache> cache;
+        try
+        {
+            cache = std::make_shared<SharedResponseCache>(path);
+        }
+        catch (const std::exception&)
+        {
+            // The cache stays disabled for this path.
+        }
+        m_caches.emplace(path, cache);
+        return cache;
+    }
+
+    /**
+     * @brief Unmaps all the cache files.
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_caches.clear();
+    }
+};
+
+#endif // _SHARED_RESPONSE_CACHE_HPP
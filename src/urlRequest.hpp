@@ -13,16 +13,19 @@
 #define _CURLWRAPPER_HPP
 
 #include "IRequestImplementator.hpp"
+#include "IURLRequest.hpp"
 #include "builder.hpp"
 #include "customDeleter.hpp"
 #include "fsWrapper.hpp"
+#include "parsedURL.hpp"
 #include "secureCommunication.hpp"
 #include <algorithm>
+#include <array>
 #include <functional>
-#include <map>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -35,14 +38,20 @@ enum METHOD_TYPE
     METHOD_POST,
     METHOD_PUT,
     METHOD_PATCH,
-    METHOD_DELETE
+    METHOD_DELETE,
+    METHOD_HEAD
 };
 
-static const std::map<METHOD_TYPE, std::string> METHOD_TYPE_MAP = {{METHOD_GET, "GET"},
-                                                                   {METHOD_POST, "POST"},
-                                                                   {METHOD_PUT, "PUT"},
-                                                                   {METHOD_PATCH, "PATCH"},
-                                                                   {METHOD_DELETE, "DELETE"}};
+constexpr std::array<std::pair<METHOD_TYPE, std::string_view>, METHOD_HEAD + 1> METHOD_TYPE_MAP {{
+    {METHOD_GET, "GET"},
+    {METHOD_POST, "POST"},
+    {METHOD_PUT, "PUT"},
+    {METHOD_PATCH, "PATCH"},
+    {METHOD_DELETE, "DELETE"},
+    {METHOD_HEAD, "HEAD"}}};
+
+static_assert(isIndexedByKey(METHOD_TYPE_MAP, METHOD_HEAD + 1),
+              "METHOD_TYPE_MAP must be in the order of METHOD_TYPE");
 
 static const std::vector<std::string> DEFAULT_CAINFO_PATHS = {
     "/etc/ssl/certs/ca-certificates.crt",     // Debian systems
@@ -52,24 +61,33 @@ static const std::vector<std::string> DEFAULT_CAINFO_PATHS = {
     "/etc/ssl/cert.pem",                      // OpenBSD, FreeBSD, MacOS
 };
 
+template<typename T>
+class PostData;
+
 /**
  * @brief This class is a wrapper for curl library.
  * It provides a simple interface to perform HTTP requests.
  *
+ * The request implementator is a template parameter: with the IRequestImplementator interface the request can be given
+ * any implementation, such as a mock, and with a final implementation, such as cURLWrapper, the calls to it aren't
+ * virtual.
+ *
  * @tparam T Type of the response body.
+ * @tparam TFileSystem File system wrapper.
+ * @tparam TRequestImplementator Request implementator.
  */
-template<typename T, typename TFileSystem = FsWrapper>
+template<typename T, typename TFileSystem = FsWrapper, typename TRequestImplementator = IRequestImplementator>
 class cURLRequest
-    : public Utils::Builder<T, std::shared_ptr<IRequestImplementator>>
+    : public Utils::Builder<T, std::shared_ptr<TRequestImplementator>>
     , public TFileSystem
 {
     using deleterFP = CustomDeleter<decltype(&fclose), fclose>;
 
+    friend class PostData<T>;
+
 private:
-    std::string m_unixSocketPath;
-    std::string m_url;
-    std::string m_userAgent;
-    std::string m_certificate;
+    bool m_hasCertificate {false};
+    std::shared_ptr<const ParsedURL> m_parsedUrl; ///< Kept alive until the request is performed.
     std::unique_ptr<FILE, deleterFP> m_fpHandle;
 
     /**
@@ -81,8 +99,8 @@ private:
      */
     void clientAuth(const std::string& sshCert, const std::string& sshKey)
     {
-        m_requestImplementator->setOption(OPT_SSL_CERT, sshCert);
-        m_requestImplementator->setOption(OPT_SSL_KEY, sshKey);
+        setOption<OPT_SSL_CERT>(sshCert);
+        setOption<OPT_SSL_KEY>(sshKey);
     }
 
     /**
@@ -92,22 +110,91 @@ private:
      */
     void basicAuth(const std::string& basicAuthCreds)
     {
-        m_requestImplementator->setOption(OPT_BASIC_AUTH, basicAuthCreds);
+        setOption<OPT_BASIC_AUTH>(basicAuthCreds);
+    }
+
+    /**
+     * @brief This method sets the TLS and authentication options of the request.
+     *
+     * @param https Whether the URL uses TLS.
+     * @param secureCommunication Secure communication object.
+     */
+    void secure(const bool https, const SecureCommunication& secureCommunication)
+    {
+        // If the URL uses "https", we need set CAINFO option.
+        // Otherwise, we need to set the SSL_VERIFYPEER option to false.
+        if (https)
+        {
+            // If the certificate is not set, we try to find it in the default paths.
+            if (!m_hasCertificate)
+            {
+                const auto caRootCert =
+                    secureCommunication.getParameter(urlrequest::AuthenticationParameter::CA_ROOT_CERTIFICATE);
+                const auto sslKey = secureCommunication.getParameter(urlrequest::AuthenticationParameter::SSL_KEY);
+                const auto sslCert =
+                    secureCommunication.getParameter(urlrequest::AuthenticationParameter::SSL_CERTIFICATE);
+
+                if (!caRootCert.empty())
+                {
+                    certificate(caRootCert);
+                }
+                else
+                {
+                    for (const auto& path : DEFAULT_CAINFO_PATHS)
+                    {
+                        if (TFileSystem::exists(path))
+                        {
+                            certificate(path);
+                            break;
+                        }
+                    }
+                }
+
+                if (!sslKey.empty() && !sslCert.empty())
+                {
+                    clientAuth(sslCert, sslKey);
+                }
+            }
+
+            const auto skipVerify =
+                secureCommunication.getParameter<bool>(urlrequest::AuthenticationParameter::SKIP_PEER_VERIFICATION);
+
+            setOption<OPT_VERIFYPEER>(skipVerify ? 0L : 1L);
+        }
+
+        const auto authCreds = secureCommunication.getParameter(urlrequest::AuthenticationParameter::BASIC_AUTH_CREDS);
+        if (!authCreds.empty())
+        {
+            basicAuth(authCreds);
+        }
     }
 
 protected:
     /**
      * @brief This variable is used to store the request implementator.
      */
-    std::shared_ptr<IRequestImplementator> m_requestImplementator;
+    std::shared_ptr<TRequestImplementator> m_requestImplementator;
     cURLRequest() = default;
 
+    /**
+     * @brief Sets an option of the request implementator, checking at compile time that the value has the type the
+     * option takes.
+     *
+     * @tparam optIndex The option index.
+     * @param value The option value.
+     */
+    template<OPTION_REQUEST_TYPE optIndex, typename TValue>
+    void setOption(TValue&& value)
+    {
+        m_requestImplementator->setOption(optIndex, optionValue<optIndex>(std::forward<TValue>(value)));
+    }
+
     /**
      * @brief Create a cURLRequest object.
      *
      * @param requestImplementator Pointer to the request implementator.
      */
-    explicit cURLRequest(std::shared_ptr<IRequestImplementator> requestImplementator)
+    explicit cURLRequest(std::shared_ptr<TRequestImplementator> requestImplementator)
         : m_requestImplementator {std::move(requestImplementator)}
     {
         if (!m_requestImplementator)
@@ -137,6 +224,24 @@ public:
         return m_requestImplementator->response();
     }
 
+    /**
+     * @brief This method moves the status, headers, body and metrics of the request into a response.
+     * @return The response.
+     */
+    Response takeResponse()
+    {
+        return m_requestImplementator->takeResponse();
+    }
+
+    /**
+     * @brief This method returns the target of the permanent redirects followed by the request.
+     * @return The URL the request was permanently redirected to, or an empty string.
+     */
+    inline const std::string permanentRedirect() const
+    {
+        return m_requestImplementator->permanentRedirect();
+    }
+
     /**
      * @brief This method sets the unix socket path and returns a reference to the object.
      * @param sock Unix socket path.
@@ -144,8 +249,7 @@ public:
      */
     T& unixSocketPath(const std::string& sock)
     {
-        m_unixSocketPath = sock;
-        m_requestImplementator->setOption(OPT_UNIX_SOCKET_PATH, m_unixSocketPath);
+        setOption<OPT_UNIX_SOCKET_PATH>(sock);
 
         return static_cast<T&>(*this);
     }
@@ -158,55 +262,30 @@ public:
      */
     T& url(const std::string& url, const SecureCommunication& secureCommunication = {})
     {
-        m_url = url;
-        m_requestImplementator->setOption(OPT_URL, m_url);
-
-        // If the URL starts with "https", we need set CAINFO option.
-        // Otherwise, we need to set the SSL_VERIFYPEER option to false.
-        if (m_url.find("https") == 0)
-        {
-            // If the certificate is not set, we try to find it in the default paths.
-            if (m_certificate.empty())
-            {
-                const auto caRootCert =
-                    secureCommunication.getParameter(urlrequest::AuthenticationParameter::CA_ROOT_CERTIFICATE);
-                const auto sslKey = secureCommunication.getParameter(urlrequest::AuthenticationParameter::SSL_KEY);
-                const auto sslCert =
-                    secureCommunication.getParameter(urlrequest::AuthenticationParameter::SSL_CERTIFICATE);
+        setOption<OPT_URL>(url);
+        secure(url.find("https") == 0, secureCommunication);
 
-                if (!caRootCert.empty())
-                {
-                    certificate(caRootCert);
-                }
-                else
-                {
-                    for (const auto& path : DEFAULT_CAINFO_PATHS)
-                    {
-                        if (TFileSystem::exists(path))
-                        {
-                            certificate(path);
-                            break;
-                        }
-                    }
-                }
-
-                if (!sslKey.empty() && !sslCert.empty())
-                {
-                    clientAuth(sslCert, sslKey);
-                }
-            }
-
-            const auto skipVerify =
-                secureCommunication.getParameter<bool>(urlrequest::AuthenticationParameter::SKIP_PEER_VERIFICATION);
-
-            m_requestImplementator->setOption(OPT_VERIFYPEER, skipVerify ? 0L : 1L);
-        }
+        return static_cast<T&>(*this);
+    }
 
-        const auto authCreds = secureCommunication.getParameter(urlrequest::AuthenticationParameter::BASIC_AUTH_CREDS);
-        if (!authCreds.empty())
+    /**
+     * @brief This method sets the URL and returns a reference to the object. A parsed URL is given to libcurl as is,
+     * so it isn't parsed again.
+     * @param url Url to set.
+     * @param secureCommunication Secure communication object.
+     * @return A reference to the object.
+     */
+    T& url(const URL& url, const SecureCommunication& secureCommunication = {})
+    {
+        if (!url.parsedUrl())
         {
-            basicAuth(authCreds);
+            return this->url(url.url(), secureCommunication);
         }
+
+        m_parsedUrl = url.parsedUrl();
+        setOption<OPT_CURLU>(m_parsedUrl->handle());
+        secure(m_parsedUrl->isHttps(), secureCommunication);
+
         return static_cast<T&>(*this);
     }
 
@@ -217,8 +296,7 @@ public:
      */
     T& userAgent(const std::string& userAgent)
     {
-        m_userAgent = userAgent;
-        m_requestImplementator->setOption(OPT_USERAGENT, m_userAgent);
+        setOption<OPT_USERAGENT>(userAgent);
 
         return static_cast<T&>(*this);
     }
@@ -247,6 +325,18 @@ public:
         return static_cast<T&>(*this);
     }
 
+    /**
+     * @brief This method sets a compiled set of headers and returns a reference to the object. The headers appended to
+     * the request are sent on top of the set.
+     * @param headers Headers to set.
+     * @return A reference to the object.
+     */
+    T& headers(const HeaderSet& headers)
+    {
+        m_requestImplementator->setHeaders(headers);
+        return static_cast<T&>(*this);
+    }
+
     /**
      * @brief This method sets the timeout in miliseconds and returns a reference to the object.
      * @param timeout Timeout to set.
@@ -254,7 +344,7 @@ public:
      */
     T& timeout(const long timeout)
     {
-        m_requestImplementator->setOption(OPT_TIMEOUT_MS, timeout);
+        setOption<OPT_TIMEOUT_MS>(timeout);
 
         return static_cast<T&>(*this);
     }
@@ -266,12 +356,88 @@ public:
      */
     T& certificate(const std::string& cert)
     {
-        m_certificate = cert;
-        m_requestImplementator->setOption(OPT_CAINFO, m_certificate);
+        m_hasCertificate = true;
+        setOption<OPT_CAINFO>(cert);
+
+        return static_cast<T&>(*this);
+    }
+
+    /**
+     * @brief This method sets the HTTP version used in the request.
+     * @param version HTTP version. 'DEFAULT' leaves the libcurl default.
+     * @return A reference to the object.
+     */
+    T& httpVersion(const HttpVersionEnum version)
+    {
+        if (version != HttpVersionEnum::DEFAULT)
+        {
+            setOption<OPT_HTTP_VERSION>(static_cast<long>(version));
+        }
+
+        return static_cast<T&>(*this);
+    }
+
+    /**
+     * @brief This method sets the file that backs the HSTS cache.
+     * @param path File path. Empty leaves the cache disabled.
+     * @return A reference to the object.
+     */
+    T& hstsCache(const std::string& path)
+    {
+        if (!path.empty())
+        {
+            setOption<OPT_HSTS>(path);
+        }
+
+        return static_cast<T&>(*this);
+    }
+
+    /**
+     * @brief This method sets the file that backs the Alt-Svc cache.
+     * @param path File path. Empty leaves the cache disabled.
+     * @return A reference to the object.
+     */
+    T& altSvcCache(const std::string& path)
+    {
+        if (!path.empty())
+        {
+            setOption<OPT_ALTSVC>(path);
+        }
 
         return static_cast<T&>(*this);
     }
 
+    /**
+     * @brief This method sets the observer of the lifecycle of the request.
+     * @param observer Observer. Empty leaves the global observer, if any.
+     * @return A reference to the object.
+     */
+    T& observer(const std::shared_ptr<IRequestObserver>& observer)
+    {
+        if (observer)
+        {
+            m_requestImplementator->setObserver(observer);
+        }
+
+        return static_cast<T&>(*this);
+    }
+
+    /**
+     * @brief This method sets the options of the configuration parameters that apply to a single request: timeout,
+     * user agent, HSTS and Alt-Svc caches, HTTP version and observer.
+     * @param configurationParameters Configuration parameters.
+     * @return A reference to the object.
+     */
+    T& configuration(const ConfigurationParameters& configurationParameters)
+    {
+        return timeout(configurationParameters.timeout)
+            .userAgent(configurationParameters.userAgent)
+            .hstsCache(configurationParameters.hstsCachePath)
+            .altSvcCache(configurationParameters.altSvcCachePath)
+            .httpVersion(configurationParameters.httpVersion)
+            .observer(configurationParameters.observer);
+    }
+
     /**
      * @brief This method create a file with the path given and returns a reference to the object.
      * @param outputFile Output file path.
@@ -288,9 +454,9 @@ public:
                 throw std::runtime_error("Failed to open output file");
             }
 
-            m_requestImplementator->setOption(OPT_WRITEDATA, m_fpHandle.get());
+            setOption<OPT_WRITEDATA>(m_fpHandle.get());
 
-            m_requestImplementator->setOption(OPT_WRITEFUNCTION, static_cast<long>(0));
+            setOption<OPT_WRITEFUNCTION>(nullptr);
         }
 
         return static_cast<T&>(*this);
@@ -305,20 +471,7 @@ public:
 template<typename T>
 class PostData
 {
-private:
-    std::string m_postDataString;
-    std::shared_ptr<IRequestImplementator> m_handleReference;
-
 public:
-    /**
-     * @brief This constructor initializes the PostData object.
-     * @param handle Shared pointer to the IRequestImplementator.
-     */
-    explicit PostData(std::shared_ptr<IRequestImplementator> handle)
-        : m_handleReference {std::move(handle)}
-    {
-    }
-
     /**
      * @brief This method sets the post data and returns a reference to the object.
      * @param postData Post data to set.
@@ -326,127 +479,178 @@ public:
      */
     T& postData(const std::string& postData)
     {
-        m_handleReference->setOption(OPT_POSTFIELDS, postData);
+        auto& request {static_cast<T&>(*this)};
 
-        m_handleReference->setOption(OPT_POSTFIELDSIZE, postData.size());
+        request.template setOption<OPT_POSTFIELDS>(postData);
 
-        return static_cast<T&>(*this);
+        request.template setOption<OPT_POSTFIELDSIZE>(postData.size());
+
+        return request;
     }
 };
 
 /**
  * @brief This class is a wrapper for curl library. It provides a simple interface to perform HTTP POST requests.
+ *
+ * @tparam TRequestImplementator Request implementator.
  */
-class PostRequest final
-    : public cURLRequest<PostRequest>
-    , public PostData<PostRequest>
+template<typename TRequestImplementator = IRequestImplementator>
+class BasicPostRequest final
+    : public cURLRequest<BasicPostRequest<TRequestImplementator>, FsWrapper, TRequestImplementator>
+    , public PostData<BasicPostRequest<TRequestImplementator>>
 {
 public:
     /**
      * @brief This constructor initializes the PostRequest object.
      * @param requestImplementator Shared pointer to the request implementator.
      */
-    explicit PostRequest(std::shared_ptr<IRequestImplementator> requestImplementator)
-        : cURLRequest<PostRequest>(requestImplementator)
-        , PostData<PostRequest>(requestImplementator)
+    explicit BasicPostRequest(std::shared_ptr<TRequestImplementator> requestImplementator)
+        : cURLRequest<BasicPostRequest, FsWrapper, TRequestImplementator>(std::move(requestImplementator))
     {
-        cURLRequest<PostRequest>::m_requestImplementator->setOption(OPT_CUSTOMREQUEST, METHOD_TYPE_MAP.at(METHOD_POST));
+        this->template setOption<OPT_CUSTOMREQUEST>(METHOD_TYPE_MAP[METHOD_POST].second);
     }
     // LCOV_EXCL_START
-    virtual ~PostRequest() = default;
+    virtual ~BasicPostRequest() = default;
     // LCOV_EXCL_STOP
 };
 
 /**
  * @brief This class is a wrapper for curl library. It provides a simple interface to perform HTTP PUT requests.
+ *
+ * @tparam TRequestImplementator Request implementator.
  */
-class PutRequest final
-    : public cURLRequest<PutRequest>
-    , public PostData<PutRequest>
+template<typename TRequestImplementator = IRequestImplementator>
+class BasicPutRequest final
+    : public cURLRequest<BasicPutRequest<TRequestImplementator>, FsWrapper, TRequestImplementator>
+    , public PostData<BasicPutRequest<TRequestImplementator>>
 {
 public:
     /**
      * @brief This constructor initializes the PutRequest object.
      * @param requestImplementator Shared pointer to the request implementator.
      */
-    explicit PutRequest(std::shared_ptr<IRequestImplementator> requestImplementator)
-        : cURLRequest<PutRequest>(requestImplementator)
-        , PostData<PutRequest>(requestImplementator)
+    explicit BasicPutRequest(std::shared_ptr<TRequestImplementator> requestImplementator)
+        : cURLRequest<BasicPutRequest, FsWrapper, TRequestImplementator>(std::move(requestImplementator))
     {
-        cURLRequest<PutRequest>::m_requestImplementator->setOption(OPT_CUSTOMREQUEST, METHOD_TYPE_MAP.at(METHOD_PUT));
+        this->template setOption<OPT_CUSTOMREQUEST>(METHOD_TYPE_MAP[METHOD_PUT].second);
     }
 
     // LCOV_EXCL_START
-    virtual ~PutRequest() = default;
+    virtual ~BasicPutRequest() = default;
     // LCOV_EXCL_STOP
 };
 
 /**
  * @brief This class is a wrapper for curl library. It provides a simple interface to perform HTTP PATCH requests.
  *
+ * @tparam TRequestImplementator Request implementator.
  */
-class PatchRequest final
-    : public cURLRequest<PatchRequest>
-    , public PostData<PatchRequest>
+template<typename TRequestImplementator = IRequestImplementator>
+class BasicPatchRequest final
+    : public cURLRequest<BasicPatchRequest<TRequestImplementator>, FsWrapper, TRequestImplementator>
+    , public PostData<BasicPatchRequest<TRequestImplementator>>
 {
 public:
     /**
      * @brief This constructor initializes the PatchRequest object.
      * @param requestImplementator Shared pointer to the request implementator.
      */
-    explicit PatchRequest(std::shared_ptr<IRequestImplementator> requestImplementator)
-        : cURLRequest<PatchRequest>(requestImplementator)
-        , PostData<PatchRequest>(requestImplementator)
+    explicit BasicPatchRequest(std::shared_ptr<TRequestImplementator> requestImplementator)
+        : cURLRequest<BasicPatchRequest, FsWrapper, TRequestImplementator>(std::move(requestImplementator))
     {
-        cURLRequest<PatchRequest>::m_requestImplementator->setOption(OPT_CUSTOMREQUEST,
-                                                                     METHOD_TYPE_MAP.at(METHOD_PATCH));
+        this->template setOption<OPT_CUSTOMREQUEST>(METHOD_TYPE_MAP[METHOD_PATCH].second);
     }
 
     // LCOV_EXCL_START
-    virtual ~PatchRequest() = default;
+    virtual ~BasicPatchRequest() = default;
     // LCOV_EXCL_STOP
 };
 
 /**
  * @brief This class is a wrapper for curl library. It provides a simple interface to perform HTTP GET requests.
+ *
+ * @tparam TRequestImplementator Request implementator.
  */
-class GetRequest final : public cURLRequest<GetRequest>
+template<typename TRequestImplementator = IRequestImplementator>
+class BasicGetRequest final
+    : public cURLRequest<BasicGetRequest<TRequestImplementator>, FsWrapper, TRequestImplementator>
 {
 public:
     /**
      * @brief This constructor initializes the GetRequest object.
      * @param requestImplementator Shared pointer to the request implementator.
      */
-    explicit GetRequest(std::shared_ptr<IRequestImplementator> requestImplementator)
-        : cURLRequest<GetRequest>(requestImplementator)
+    explicit BasicGetRequest(std::shared_ptr<TRequestImplementator> requestImplementator)
+        : cURLRequest<BasicGetRequest, FsWrapper, TRequestImplementator>(std::move(requestImplementator))
     {
-        requestImplementator->setOption(OPT_CUSTOMREQUEST, METHOD_TYPE_MAP.at(METHOD_GET).c_str());
+        this->template setOption<OPT_CUSTOMREQUEST>(METHOD_TYPE_MAP[METHOD_GET].second);
     }
 
     // LCOV_EXCL_START
-    virtual ~GetRequest() = default;
+    virtual ~BasicGetRequest() = default;
     // LCOV_EXCL_STOP
 };
 
 /**
  * @brief This class is a wrapper for curl library. It provides a simple interface to perform HTTP DELETE requests.
+ *
+ * @tparam TRequestImplementator Request implementator.
  */
-class DeleteRequest final : public cURLRequest<DeleteRequest>
+template<typename TRequestImplementator = IRequestImplementator>
+class BasicDeleteRequest final
+    : public cURLRequest<BasicDeleteRequest<TRequestImplementator>, FsWrapper, TRequestImplementator>
 {
 public:
     /**
      * @brief This constructor initializes the DeleteRequest object.
      * @param requestImplementator Shared pointer to the request implementator.
      */
-    explicit DeleteRequest(std::shared_ptr<IRequestImplementator> requestImplementator)
-        : cURLRequest<DeleteRequest>(requestImplementator)
+    explicit BasicDeleteRequest(std::shared_ptr<TRequestImplementator> requestImplementator)
+        : cURLRequest<BasicDeleteRequest, FsWrapper, TRequestImplementator>(std::move(requestImplementator))
     {
-        requestImplementator->setOption(OPT_CUSTOMREQUEST, METHOD_TYPE_MAP.at(METHOD_DELETE).c_str());
+        this->template setOption<OPT_CUSTOMREQUEST>(METHOD_TYPE_MAP[METHOD_DELETE].second);
     }
 
     // LCOV_EXCL_START
-    virtual ~DeleteRequest() = default;
+    virtual ~BasicDeleteRequest() = default;
     // LCOV_EXCL_STOP
 };
 
+/**
+ * @brief This class is a wrapper for curl library. It provides a simple interface to perform HTTP HEAD requests, which
+ * receive only the status and the headers of the response. An error status doesn't fail the request: it's what the
+ * request is for, and failing it would close the connection.
+ *
+ * @tparam TRequestImplementator Request implementator.
+ */
+template<typename TRequestImplementator = IRequestImplementator>
+class BasicHeadRequest final
+    : public cURLRequest<BasicHeadRequest<TRequestImplementator>, FsWrapper, TRequestImplementator>
+{
+public:
+    /**
+     * @brief This constructor initializes the HeadRequest object.
+     * @param requestImplementator Shared pointer to the request implementator.
+     */
+    explicit BasicHeadRequest(std::shared_ptr<TRequestImplementator> requestImplementator)
+        : cURLRequest<BasicHeadRequest, FsWrapper, TRequestImplementator>(std::move(requestImplementator))
+    {
+        this->template setOption<OPT_CUSTOMREQUEST>(METHOD_TYPE_MAP[METHOD_HEAD].second);
+        this->template setOption<OPT_NOBODY>(1L);
+        this->template setOption<OPT_FAILONERROR>(0L);
+    }
+
+    // LCOV_EXCL_START
+    virtual ~BasicHeadRequest() = default;
+    // LCOV_EXCL_STOP
+};
+
+// Requests over the IRequestImplementator interface, which accept any implementation.
+using PostRequest = BasicPostRequest<>;
+using PutRequest = BasicPutRequest<>;
+using PatchRequest = BasicPatchRequest<>;
+using GetRequest = BasicGetRequest<>;
+using DeleteRequest = BasicDeleteRequest<>;
+using HeadRequest = BasicHeadRequest<>;
+
 #endif // _CURLWRAPPER_HPP
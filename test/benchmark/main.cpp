@@ -15,26 +15,231 @@
 #pragma GCC diagnostic pop
 
 #include "HTTPRequest.hpp"
+#include "UNIXSocketRequest.hpp"
+#include "allocationCounter.hpp"
+#include "curlWrapper.hpp"
+#include "customDeleter.hpp"
+#include "factoryRequestImplemetator.hpp"
+#include "inFlightRequestTable.hpp"
+#include "requestMetricsRegistry.hpp"
+#include "requestTrace.hpp"
+#include "requestTracer.hpp"
+#include "urlRequest.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <curl/curl.h>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+#include <spawn.h>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+thread_local size_t t_curlAllocations {0};    ///< Allocations made by libcurl in the thread.
+thread_local size_t t_curlAllocatedBytes {0}; ///< Bytes of the allocations made by libcurl in the thread.
 
 /**
- * @brief This class is a simple HTTP server that provides a simple interface to perform HTTP requests.
+ * @brief Counts an allocation made by libcurl.
+ *
+ * @param size Bytes allocated.
  */
-namespace
+void countCurlAllocation(const size_t size)
+{
+    ++t_curlAllocations;
+    t_curlAllocatedBytes += size;
+}
+
+// Allocators given to libcurl, to count its allocations apart from ours.
+void* curlMalloc(size_t size)
+{
+    countCurlAllocation(size);
+    return std::malloc(size);
+}
+
+void curlFree(void* ptr)
+{
+    std::free(ptr);
+}
+
+void* curlRealloc(void* ptr, size_t size)
+{
+    countCurlAllocation(size);
+    return std::realloc(ptr, size);
+}
+
+char* curlStrdup(const char* str)
+{
+    countCurlAllocation(std::strlen(str) + 1);
+    return strdup(str);
+}
+
+void* curlCalloc(size_t nmemb, size_t size)
+{
+    countCurlAllocation(nmemb * size);
+    return std::calloc(nmemb, size);
+}
+
+// The allocators must be set before libcurl is used, which initializes it with the default ones.
+const auto g_curlAllocators {
+    curl_global_init_mem(CURL_GLOBAL_DEFAULT, curlMalloc, curlFree, curlRealloc, curlStrdup, curlCalloc)};
+
+/**
+ * @brief This class generates a self-signed certificate for 'localhost', with its key, for the TLS servers. The files
+ * are removed when it's destroyed.
+ */
+class TestCertificate final
 {
+private:
+    using deleterKey = CustomDeleter<decltype(&EVP_PKEY_free), EVP_PKEY_free>;
+    using deleterCertificate = CustomDeleter<decltype(&X509_free), X509_free>;
+    using deleterFile = CustomDeleter<decltype(&fclose), fclose>;
+
+public:
+    const std::string m_certificatePath {std::filesystem::temp_directory_path() / "urlrequest_benchmark_cert.pem"};
+    const std::string m_keyPath {std::filesystem::temp_directory_path() / "urlrequest_benchmark_key.pem"};
+
+    TestCertificate()
+    {
+        const std::unique_ptr<EVP_PKEY, deleterKey> key {EVP_EC_gen("P-256")};
+        const std::unique_ptr<X509, deleterCertificate> certificate {X509_new()};
+        if (!key || !certificate)
+        {
+            throw std::runtime_error("Couldn't create the test certificate");
+        }
+
+        X509_set_version(certificate.get(), 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(certificate.get()), 1);
+        X509_gmtime_adj(X509_getm_notBefore(certificate.get()), 0);
+        X509_gmtime_adj(X509_getm_notAfter(certificate.get()), 24 * 60 * 60);
+        X509_set_pubkey(certificate.get(), key.get());
+        const auto name {X509_get_subject_name(certificate.get())};
+        X509_NAME_add_entry_by_txt(
+            name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+        X509_set_issuer_name(certificate.get(), name);
+
+        // Without the subject alternative name, libcurl doesn't match the host name.
+        X509V3_CTX context;
+        X509V3_set_ctx_nodb(&context);
+        X509V3_set_ctx(&context, certificate.get(), certificate.get(), nullptr, nullptr, 0);
+        for (const auto& [extension, value] :
+             {std::pair {NID_subject_alt_name, "DNS:localhost"}, std::pair {NID_basic_constraints, "critical,CA:TRUE"}})
+        {
+            const auto entry {X509V3_EXT_conf_nid(nullptr, &context, extension, value)};
+            if (entry == nullptr || X509_add_ext(certificate.get(), entry, -1) != 1)
+            {
+                X509_EXTENSION_free(entry);
+                throw std::runtime_error("Couldn't set the extensions of the test certificate");
+            }
+            X509_EXTENSION_free(entry);
+        }
+
+        if (X509_sign(certificate.get(), key.get(), EVP_sha256()) == 0)
+        {
+            throw std::runtime_error("Couldn't sign the test certificate");
+        }
+
+        const std::unique_ptr<FILE, deleterFile> certificateFile {fopen(m_certificatePath.c_str(), "w")};
+        const std::unique_ptr<FILE, deleterFile> keyFile {fopen(m_keyPath.c_str(), "w")};
+        if (!certificateFile || !keyFile || PEM_write_X509(certificateFile.get(), certificate.get()) != 1 ||
+            PEM_write_PrivateKey(keyFile.get(), key.get(), nullptr, nullptr, 0, nullptr, nullptr) != 1)
+        {
+            throw std::runtime_error("Couldn't write the test certificate");
+        }
+    }
+
+    ~TestCertificate()
+    {
+        std::error_code error;
+        std::filesystem::remove(m_certificatePath, error);
+        std::filesystem::remove(m_keyPath, error);
+    }
+
+    TestCertificate(const TestCertificate&) = delete;
+    TestCertificate& operator=(const TestCertificate&) = delete;
+};
+
+/**
+ * @brief This class is a simple HTTP server that provides a simple interface to perform HTTP requests.
+ */
 class FakeServer final
 {
 private:
-    httplib::Server m_server;
+    std::unique_ptr<httplib::Server> m_server;
+    const int m_port;
+    const bool m_keepAlive;
+    const std::string m_unixSocketPath {};
     std::thread m_thread;
 
+    static std::unique_ptr<httplib::Server> createServer(const TestCertificate* certificate)
+    {
+        if (certificate == nullptr)
+        {
+            return std::make_unique<httplib::Server>();
+        }
+        return std::make_unique<httplib::SSLServer>(certificate->m_certificatePath.c_str(),
+                                                    certificate->m_keyPath.c_str());
+    }
+
 public:
-    FakeServer()
-        : m_thread(&FakeServer::run, this)
+    /**
+     * @brief Starts the server.
+     *
+     * @param port Port.
+     * @param keepAlive Keep the connections open between requests, instead of closing them after each response.
+     * @param certificate Certificate of the server for TLS, nullptr to serve plain HTTP.
+     */
+    explicit FakeServer(const int port = 44441,
+                        const bool keepAlive = false,
+                        const TestCertificate* certificate = nullptr)
+        : m_server {createServer(certificate)}
+        , m_port {port}
+        , m_keepAlive {keepAlive}
+        , m_thread(&FakeServer::run, this)
     {
         // Wait until server is ready
-        while (!m_server.is_running())
+        while (!m_server->is_running())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    /**
+     * @brief Starts the server on a UNIX socket, keeping the connections open between requests.
+     *
+     * @param unixSocketPath Path of the socket, replaced if it exists.
+     */
+    explicit FakeServer(std::string unixSocketPath)
+        : m_server {createServer(nullptr)}
+        , m_port {80}
+        , m_keepAlive {true}
+        , m_unixSocketPath {std::move(unixSocketPath)}
+        , m_thread(&FakeServer::run, this)
+    {
+        while (!m_server->is_running())
         {
             std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
@@ -42,8 +247,13 @@ public:
 
     ~FakeServer()
     {
-        m_server.stop();
+        m_server->stop();
         m_thread.join();
+        if (!m_unixSocketPath.empty())
+        {
+            std::error_code error;
+            std::filesystem::remove(m_unixSocketPath, error);
+        }
     }
 
     /**
@@ -51,30 +261,230 @@ public:
      */
     void run()
     {
-        m_server.Get("/",
-                     [](const httplib::Request& /*req*/, httplib::Response& res)
-                     { res.set_content("Hello World!", "text/json"); });
+        m_server->Get("/",
+                      [](const httplib::Request& /*req*/, httplib::Response& res)
+                      { res.set_content("Hello World!", "text/json"); });
 
-        m_server.Post(
+        m_server->Post(
             "/", [](const httplib::Request& req, httplib::Response& res) { res.set_content(req.body, "text/json"); });
 
-        m_server.Put(
+        m_server->Put(
             "/", [](const httplib::Request& req, httplib::Response& res) { res.set_content(req.body, "text/json"); });
 
-        m_server.Patch(
+        m_server->Patch(
             "/", [](const httplib::Request& req, httplib::Response& res) { res.set_content(req.body, "text/json"); });
 
-        m_server.Delete(R"(/(\d+))",
-                        [](const httplib::Request& req, httplib::Response& res)
-                        { res.set_content(req.matches[1], "text/json"); });
+        m_server->Delete(R"(/(\d+))",
+                         [](const httplib::Request& req, httplib::Response& res)
+                         { res.set_content(req.matches[1], "text/json"); });
+
+        // Payload of the size in the path, streamed so the server doesn't hold it in memory.
+        m_server->Get(R"(/payload/(\d+))",
+                      [](const httplib::Request& req, httplib::Response& res)
+                      {
+                          res.set_content_provider(
+                              std::stoull(req.matches[1]),
+                              "application/octet-stream",
+                              [](size_t /*offset*/, size_t length, httplib::DataSink& sink)
+                              {
+                                  static const std::string chunk(64 * 1024, 'x');
+                                  return sink.write(chunk.data(), std::min(length, chunk.size()));
+                              });
+                      });
 
-        m_server.set_keep_alive_max_count(1);
-        m_server.listen("localhost", 44441);
+        // Discards the body and responds with its size.
+        m_server->Post("/sink",
+                       [](const httplib::Request& /*req*/,
+                          httplib::Response& res,
+                          const httplib::ContentReader& contentReader)
+                       {
+                           size_t size {0};
+                           contentReader(
+                               [&size](const char* /*data*/, size_t length)
+                               {
+                                   size += length;
+                                   return true;
+                               });
+                           res.set_content(std::to_string(size), "text/plain");
+                       });
+
+        m_server->set_payload_max_length(std::numeric_limits<size_t>::max());
+
+        if (!m_keepAlive)
+        {
+            m_server->set_keep_alive_max_count(1);
+        }
+
+        if (!m_unixSocketPath.empty())
+        {
+            std::error_code error;
+            std::filesystem::remove(m_unixSocketPath, error);
+            m_server->set_address_family(AF_UNIX);
+            m_server->listen(m_unixSocketPath, m_port);
+        }
+        else
+        {
+            m_server->listen("localhost", m_port);
+        }
     }
 };
 } // namespace
 
 FakeServer g_server;
+FakeServer g_keepAliveServer {44443, true};
+const TestCertificate g_certificate;
+FakeServer g_tlsKeepAliveServer {44444, true, &g_certificate};
+FakeServer g_tlsServer {44445, false, &g_certificate};
+const std::string g_unixSocketPath {std::filesystem::temp_directory_path() / "urlrequest_benchmark.sock"};
+FakeServer g_unixSocketServer {g_unixSocketPath};
+const std::string g_allocationBudgetDownloadPath {std::filesystem::temp_directory_path() /
+                                                  "urlrequest_benchmark_allocation_budget.txt"};
+
+std::atomic<bool> g_shouldRun {true}; ///< Flag of the handlers that can be interrupted, never cleared.
+std::atomic<bool> g_failed {false};   ///< Set when a benchmark fails a check, so the run exits with an error.
+
+/**
+ * @brief Fails a benchmark that doesn't pass a check: its run is reported with the error, and the process exits with
+ * a failure once all the benchmarks are run. The benchmarks that can't run use SkipWithError alone.
+ *
+ * @param state Benchmark state.
+ * @param error Check that failed.
+ */
+void failBenchmark(benchmark::State& state, const std::string& error)
+{
+    g_failed = true;
+    state.SkipWithError(error.c_str());
+}
+
+/**
+ * @brief Reports the peak resident memory of the process during a benchmark, in MiB, as the 'peak_rss_mib' counter.
+ * The peak is reset when the counter is created, which is only supported by Linux; elsewhere it's the peak since the
+ * process started.
+ */
+class PeakMemoryCounter final
+{
+private:
+    benchmark::State& m_state;
+
+public:
+    explicit PeakMemoryCounter(benchmark::State& state)
+        : m_state {state}
+    {
+        std::ofstream("/proc/self/clear_refs") << "5";
+    }
+
+    ~PeakMemoryCounter()
+    {
+        std::ifstream status {"/proc/self/status"};
+        std::string line;
+        while (std::getline(status, line))
+        {
+            if (line.rfind("VmHWM:", 0) == 0)
+            {
+                m_state.counters["peak_rss_mib"] = std::stod(line.substr(line.find_first_of("0123456789"))) / 1024;
+                break;
+            }
+        }
+    }
+
+    PeakMemoryCounter(const PeakMemoryCounter&) = delete;
+    PeakMemoryCounter& operator=(const PeakMemoryCounter&) = delete;
+};
+
+/**
+ * @brief Reports the throughput and the latency of the requests of a benchmark run by several threads: the
+ * 'requests' rate, the 'p50_us', 'p99_us' and 'p999_us' latency percentiles, and the 'evictions' from the handler
+ * cache per request. Each thread records the latencies of its requests into its own histogram. The histograms are
+ * merged once the threads are done, and the last thread to finish reports the percentiles.
+ */
+class LatencyRecorder final
+{
+private:
+    /**
+     * @brief Latencies of the threads of the current run.
+     */
+    struct Run
+    {
+        std::mutex m_mutex;
+        LatencyHistogram m_latency;
+        int m_finishedThreads {0};
+        uint64_t m_evictions {0}; ///< Handler cache evictions when the run started.
+    };
+
+    static Run& run()
+    {
+        static Run s_run;
+        return s_run;
+    }
+
+    benchmark::State& m_state;
+    LatencyHistogram m_latency;
+
+public:
+    /**
+     * @brief Starts recording the latencies of a thread. The first thread resets the run, before the threads start
+     * iterating.
+     *
+     * @param state Benchmark state.
+     */
+    explicit LatencyRecorder(benchmark::State& state)
+        : m_state {state}
+    {
+        if (m_state.thread_index() == 0)
+        {
+            auto& current {run()};
+            std::lock_guard<std::mutex> lock(current.m_mutex);
+            current.m_latency = {};
+            current.m_finishedThreads = 0;
+            current.m_evictions = RequestMetricsRegistry::instance().snapshot().m_handlerCacheEvictions;
+        }
+    }
+
+    ~LatencyRecorder()
+    {
+        m_state.counters["requests"] =
+            benchmark::Counter(static_cast<double>(m_state.iterations()), benchmark::Counter::kIsRate);
+
+        auto& current {run()};
+        std::lock_guard<std::mutex> lock(current.m_mutex);
+        auto& latency {current.m_latency};
+        for (size_t i = 0; i < latency.m_counts.size(); ++i)
+        {
+            latency.m_counts[i] += m_latency.m_counts[i];
+        }
+        latency.m_count += m_latency.m_count;
+        latency.m_sum += m_latency.m_sum;
+        latency.m_max = std::max(latency.m_max, m_latency.m_max);
+
+        if (++current.m_finishedThreads == m_state.threads())
+        {
+            m_state.counters["p50_us"] = static_cast<double>(latency.percentile(50));
+            m_state.counters["p99_us"] = static_cast<double>(latency.percentile(99));
+            m_state.counters["p999_us"] = static_cast<double>(latency.percentile(99.9));
+            m_state.counters["evictions"] = static_cast<double>(
+                RequestMetricsRegistry::instance().snapshot().m_handlerCacheEvictions - current.m_evictions) /
+                static_cast<double>(std::max<uint64_t>(1, latency.m_count));
+        }
+    }
+
+    LatencyRecorder(const LatencyRecorder&) = delete;
+    LatencyRecorder& operator=(const LatencyRecorder&) = delete;
+
+    /**
+     * @brief Records the latency of a request.
+     *
+     * @param latency Latency.
+     */
+    void record(const std::chrono::steady_clock::duration latency)
+    {
+        const auto value {
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(latency).count())};
+        ++m_latency.m_counts[LatencyHistogram::bucket(value)];
+        ++m_latency.m_count;
+        m_latency.m_sum += value;
+        m_latency.m_max = std::max(m_latency.m_max, value);
+    }
+};
 
 /**
  * @brief This function is a benchmark test for the HTTP GET request.
@@ -83,6 +493,7 @@ FakeServer g_server;
  */
 static void BM_Get(benchmark::State& state)
 {
+    const AllocationCounter allocationCounter {state};
     for (auto _ : state)
     {
         HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")});
@@ -91,123 +502,1269 @@ static void BM_Get(benchmark::State& state)
 BENCHMARK(BM_Get);
 
 /**
- * @brief This function is a benchmark test for the HTTP POST request.
+ * @brief This function is a benchmark test for the HTTP GET request reusing a parsed URL.
  *
  * @param state Benchmark state.
  */
-static void BM_Post(benchmark::State& state)
+static void BM_GetUsingAParsedUrl(benchmark::State& state)
 {
+    const auto url {HttpURL::parse("http://localhost:44441/")};
+    const AllocationCounter allocationCounter {state};
     for (auto _ : state)
     {
-        HTTPRequest::instance().post(
-            RequestParameters {.url = HttpURL("http://localhost:44441/"), .data = R"({"foo": "bar"})"_json});
+        HTTPRequest::instance().get(RequestParameters {.url = url});
     }
 }
-BENCHMARK(BM_Post);
+BENCHMARK(BM_GetUsingAParsedUrl);
 
 /**
- * @brief This function is a benchmark test for the HTTP UPDATE request.
+ * @brief This function is a benchmark test for the HTTP GET request taking the whole response, with its headers and
+ * metrics.
  *
  * @param state Benchmark state.
  */
-static void BM_Update(benchmark::State& state)
+static void BM_GetTakingTheResponse(benchmark::State& state)
 {
+    const auto url {HttpURL::parse("http://localhost:44441/")};
+    const AllocationCounter allocationCounter {state};
     for (auto _ : state)
     {
-        HTTPRequest::instance().put(
-            RequestParameters {.url = HttpURL("http://localhost:44441/"), .data = R"({"foo": "bar"})"_json});
+        HTTPRequest::instance().get(RequestParameters {.url = url},
+                                    PostRequestParameters {.onResponse = [](Response response)
+                                                           { benchmark::DoNotOptimize(response.status()); }});
     }
 }
-BENCHMARK(BM_Update);
+BENCHMARK(BM_GetTakingTheResponse);
 
 /**
- * @brief This function is a benchmark test for the HTTP PATCH request.
+ * @brief This function is a benchmark test for the HTTP GET request with a transfer observer set.
  *
  * @param state Benchmark state.
  */
-static void BM_Patch(benchmark::State& state)
+static void BM_GetWithATransferObserver(benchmark::State& state)
 {
+    const auto url {HttpURL::parse("http://localhost:44441/")};
+    std::chrono::microseconds totalTime {0};
+    TransferObserver::set([&totalTime](std::string_view, long, const TransferMetrics& metrics)
+                          { totalTime += metrics.totalTime; });
     for (auto _ : state)
     {
-        HTTPRequest::instance().patch(
-            RequestParameters {.url = HttpURL("http://localhost:44441/"), .data = R"({"foo": "bar"})"_json});
+        HTTPRequest::instance().get(RequestParameters {.url = url});
     }
+    TransferObserver::set({});
+    state.counters["totalTime"] = benchmark::Counter(totalTime.count(), benchmark::Counter::kAvgIterations);
 }
-BENCHMARK(BM_Patch);
+BENCHMARK(BM_GetWithATransferObserver);
 
 /**
- * @brief This function is a benchmark test for the HTTP DELETE request.
+ * @brief This function is a benchmark test for the HTTP GET request followed by a request observer. Compared to
+ * BM_GetUsingAParsedUrl, it measures the cost of notifying the lifecycle of the request.
  *
  * @param state Benchmark state.
  */
-static void BM_Delete(benchmark::State& state)
+static void BM_GetWithARequestObserver(benchmark::State& state)
 {
+    /**
+     * @brief Observer that counts the events.
+     */
+    class CountingObserver final : public IRequestObserver
+    {
+    public:
+        uint64_t m_events {0};
+
+        void onStart(const RequestEvent&) override
+        {
+            ++m_events;
+        }
+
+        void onFirstByte(const RequestEvent&) override
+        {
+            ++m_events;
+        }
+
+        void onComplete(const RequestEvent&, long, const TransferMetrics&) override
+        {
+            ++m_events;
+        }
+    };
+
+    const auto url {HttpURL::parse("http://localhost:44441/")};
+    const auto observer {std::make_shared<CountingObserver>()};
+    const AllocationCounter allocationCounter {state};
     for (auto _ : state)
     {
-        HTTPRequest::instance().delete_(RequestParameters {.url = HttpURL("http://localhost:44441/12345")});
+        HTTPRequest::instance().get(RequestParameters {.url = url}, {}, ConfigurationParameters {.observer = observer});
     }
+    state.counters["events"] = benchmark::Counter(observer->m_events, benchmark::Counter::kAvgIterations);
 }
+BENCHMARK(BM_GetWithARequestObserver);
 
-BENCHMARK(BM_Delete);
+/**
+ * @brief This function is a benchmark test for the HTTP GET request while the requests are traced. Compared to
+ * BM_GetUsingAParsedUrl, it measures the cost of recording the spans of the request.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_GetWithTracing(benchmark::State& state)
+{
+    const auto url {HttpURL::parse("http://localhost:44441/")};
+    RequestTrace::enable();
+    {
+        const AllocationCounter allocationCounter {state};
+        for (auto _ : state)
+        {
+            HTTPRequest::instance().get(RequestParameters {.url = url});
+        }
+    }
+    RequestTrace::disable();
+    RequestTrace::clear();
+}
+BENCHMARK(BM_GetWithTracing);
 
 /**
- * @brief This function is a benchmark test for the HTTP DOWNLOAD request.
+ * @brief This function is a benchmark test for recording a span, with the tracer disabled (range 0) or enabled
+ * (range 1).
  *
  * @param state Benchmark state.
  */
-static void BM_Download(benchmark::State& state)
+static void BM_TraceSpan(benchmark::State& state)
 {
+    if (state.thread_index() == 0 && state.range(0) != 0)
+    {
+        RequestTracer::instance().enable();
+    }
     for (auto _ : state)
     {
-        HTTPRequest::instance().download(RequestParameters {.url = HttpURL("http://localhost:44441/")},
-                                         PostRequestParameters {.outputFile = "out.txt"});
+        RequestTracer::TraceSpan span {"span", "benchmark"};
+        span.result("done");
+    }
+    if (state.thread_index() == 0)
+    {
+        RequestTracer::instance().disable();
+        RequestTracer::instance().clear();
     }
 }
-BENCHMARK(BM_Download);
+BENCHMARK(BM_TraceSpan)->Arg(0)->Arg(1)->ThreadRange(1, 8);
 
 /**
- * @brief This function is a benchmark test for the HTTP DOWNLOAD request using the single handler.
+ * @brief This function is a benchmark test for tracking a request in the in-flight table while it's performed, which
+ * every request pays once the tracking is enabled.
  *
  * @param state Benchmark state.
  */
-static void BM_DownloadUsingTheSingleHandler(benchmark::State& state)
+static void BM_TrackInFlightRequest(benchmark::State& state)
 {
     for (auto _ : state)
     {
-        HTTPRequest::instance().download(RequestParameters {.url = HttpURL("http://localhost:44441/")},
-                                         PostRequestParameters {.outputFile = "out.txt"},
-                                         ConfigurationParameters {.handlerType = CurlHandlerTypeEnum::SINGLE});
+        InFlightRequestTable::Entry entry {"GET", "http://localhost:44441/", CurlHandlerTypeEnum::SINGLE};
+        entry.progress(12, 0);
     }
 }
-BENCHMARK(BM_DownloadUsingTheSingleHandler);
+BENCHMARK(BM_TrackInFlightRequest)->ThreadRange(1, 8);
 
 /**
- * @brief This function is a benchmark test for the HTTP DOWNLOAD request using the multi handler.
+ * @brief This function is a benchmark test for building a parameterized URL by string concatenation, the URL is parsed
+ * on each request.
  *
  * @param state Benchmark state.
  */
-static void BM_CustomDownloadUsingTheMultiHandler(benchmark::State& state)
+static void BM_BuildQueryByConcatenation(benchmark::State& state)
 {
+    const std::string base {"http://localhost:44441/search"};
     for (auto _ : state)
     {
-        HTTPRequest::instance().download(RequestParameters {.url = HttpURL("http://localhost:44441/")},
-                                         PostRequestParameters {.outputFile = "out.txt"},
-                                         ConfigurationParameters {.handlerType = CurlHandlerTypeEnum::MULTI});
+        const HttpURL url {base + "?name=" + std::to_string(state.iterations()) + "&filter=a%20b"};
+        benchmark::DoNotOptimize(url.url());
     }
 }
-BENCHMARK(BM_CustomDownloadUsingTheMultiHandler);
+BENCHMARK(BM_BuildQueryByConcatenation);
 
-static void BM_ReturnStringByValue(benchmark::State& state)
+/**
+ * @brief This function is a benchmark test for building a parameterized URL from a parsed URL and a query builder.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_BuildQueryUsingTheQueryBuilder(benchmark::State& state)
 {
-    SecureCommunication secureComm;
-    secureComm.sslCertificate("path/to/certificate");
+    const auto base {HttpURL::parse("http://localhost:44441/search")};
+    QueryBuilder query;
+    for (auto _ : state)
+    {
+        query.clear();
+        query.add("name", std::to_string(state.iterations())).add("filter", "a b");
+        const HttpURL url {base, query};
+        benchmark::DoNotOptimize(url.url());
+    }
+}
+BENCHMARK(BM_BuildQueryUsingTheQueryBuilder);
 
+/**
+ * @brief This function is a benchmark test for a prepared HTTP GET request.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_PreparedGet(benchmark::State& state)
+{
+    auto request {
+        HTTPRequest::instance().prepareGet(RequestParameters {.url = HttpURL("http://localhost:44441/")}, g_shouldRun)};
     for (auto _ : state)
     {
-        std::string result = secureComm.getParameter(urlrequest::AuthenticationParameter::SSL_CERTIFICATE);
-        benchmark::DoNotOptimize(result);
+        request.execute();
     }
 }
-BENCHMARK(BM_ReturnStringByValue);
+BENCHMARK(BM_PreparedGet);
+
+/**
+ * @brief This function is a benchmark test for the HTTP POST request.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_Post(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        HTTPRequest::instance().post(
+            RequestParameters {.url = HttpURL("http://localhost:44441/"), .data = R"({"foo": "bar"})"_json});
+    }
+}
+BENCHMARK(BM_Post);
+
+/**
+ * @brief This function is a benchmark test for a prepared HTTP POST request, changing the body on each execution.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_PreparedPost(benchmark::State& state)
+{
+    auto request {HTTPRequest::instance().preparePost(
+        RequestParameters {.url = HttpURL("http://localhost:44441/"), .data = R"({"foo": "bar"})"_json}, g_shouldRun)};
+    std::string body;
+    for (auto _ : state)
+    {
+        body = R"({"event": )" + std::to_string(state.iterations()) + "}";
+        request.execute(body);
+    }
+}
+BENCHMARK(BM_PreparedPost);
 
-BENCHMARK_MAIN();
+/**
+ * @brief This function is a benchmark test for the HTTP UPDATE request.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_Update(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        HTTPRequest::instance().put(
+            RequestParameters {.url = HttpURL("http://localhost:44441/"), .data = R"({"foo": "bar"})"_json});
+    }
+}
+BENCHMARK(BM_Update);
+
+/**
+ * @brief This function is a benchmark test for the HTTP PATCH request.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_Patch(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        HTTPRequest::instance().patch(
+            RequestParameters {.url = HttpURL("http://localhost:44441/"), .data = R"({"foo": "bar"})"_json});
+    }
+}
+BENCHMARK(BM_Patch);
+
+/**
+ * @brief This function is a benchmark test for the HTTP DELETE request.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_Delete(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        HTTPRequest::instance().delete_(RequestParameters {.url = HttpURL("http://localhost:44441/12345")});
+    }
+}
+
+BENCHMARK(BM_Delete);
+
+/**
+ * @brief This function is a benchmark test for the HTTP DOWNLOAD request.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_Download(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        HTTPRequest::instance().download(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                         PostRequestParameters {.outputFile = "out.txt"});
+    }
+}
+BENCHMARK(BM_Download);
+
+/**
+ * @brief This function is a benchmark test for the HTTP DOWNLOAD request using the single handler.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_DownloadUsingTheSingleHandler(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        HTTPRequest::instance().download(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                         PostRequestParameters {.outputFile = "out.txt"},
+                                         ConfigurationParameters {.handlerType = CurlHandlerTypeEnum::SINGLE});
+    }
+}
+BENCHMARK(BM_DownloadUsingTheSingleHandler);
+
+/**
+ * @brief This function is a benchmark test for the HTTP DOWNLOAD request using the multi handler.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_CustomDownloadUsingTheMultiHandler(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        HTTPRequest::instance().download(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                         PostRequestParameters {.outputFile = "out.txt"},
+                                         ConfigurationParameters {.handlerType = CurlHandlerTypeEnum::MULTI});
+    }
+}
+BENCHMARK(BM_CustomDownloadUsingTheMultiHandler);
+
+// Largest payload of the payload benchmarks by default. The sizes up to 1 GiB take minutes and as much memory.
+constexpr int64_t DEFAULT_MAX_PAYLOAD_SIZE {1 << 22};
+
+/**
+ * @brief Sets the payload sizes of a payload benchmark, from 1 KiB to DEFAULT_MAX_PAYLOAD_SIZE, or to the size in bytes
+ * in URLREQUEST_BENCHMARK_MAX_PAYLOAD_SIZE when it's set, like 1073741824 for 1 GiB.
+ *
+ * @param benchmark Benchmark.
+ */
+static void payloadSizes(benchmark::internal::Benchmark* benchmark)
+{
+    const auto maxSize {std::getenv("URLREQUEST_BENCHMARK_MAX_PAYLOAD_SIZE")};
+    benchmark->RangeMultiplier(32)->Range(1 << 10, maxSize != nullptr ? std::stoll(maxSize) : DEFAULT_MAX_PAYLOAD_SIZE);
+}
+
+/**
+ * @brief This function is a benchmark test for the HTTP GET request of a response of the size given by the argument,
+ * received into memory.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_GetPayload(benchmark::State& state)
+{
+    const HttpURL url {"http://localhost:44441/payload/" + std::to_string(state.range(0))};
+    const AllocationCounter allocationCounter {state};
+    const PeakMemoryCounter peakMemoryCounter {state};
+    for (auto _ : state)
+    {
+        HTTPRequest::instance().get(RequestParameters {.url = url},
+                                    PostRequestParameters {.onSuccess = [](const std::string& response)
+                                                           { benchmark::DoNotOptimize(response.data()); }});
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetPayload)->Apply(payloadSizes)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief This function is a benchmark test for the HTTP DOWNLOAD request of a file of the size given by the argument.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_DownloadPayload(benchmark::State& state)
+{
+    const HttpURL url {"http://localhost:44441/payload/" + std::to_string(state.range(0))};
+    const AllocationCounter allocationCounter {state};
+    const PeakMemoryCounter peakMemoryCounter {state};
+    for (auto _ : state)
+    {
+        HTTPRequest::instance().download(RequestParameters {.url = url},
+                                         PostRequestParameters {.outputFile = "out.txt"});
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DownloadPayload)->Apply(payloadSizes)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief This function is a benchmark test for the HTTP POST request of a string body of the size given by the
+ * argument.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_PostPayload(benchmark::State& state)
+{
+    const HttpURL url {"http://localhost:44441/sink"};
+    const std::string body(state.range(0), 'x');
+    const AllocationCounter allocationCounter {state};
+    const PeakMemoryCounter peakMemoryCounter {state};
+    for (auto _ : state)
+    {
+        HTTPRequest::instance().post(RequestParameters {.url = url, .data = body});
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PostPayload)->Apply(payloadSizes)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief This function is a benchmark test for the HTTP POST request of a JSON body of about the size given by the
+ * argument, which is serialized by the request.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_PostJsonPayload(benchmark::State& state)
+{
+    const HttpURL url {"http://localhost:44441/sink"};
+    const nlohmann::json body = {{"data", std::string(state.range(0), 'x')}};
+    const AllocationCounter allocationCounter {state};
+    const PeakMemoryCounter peakMemoryCounter {state};
+    for (auto _ : state)
+    {
+        HTTPRequest::instance().post(RequestParameters {.url = url, .data = body});
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PostJsonPayload)->Apply(payloadSizes)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief This function is a benchmark test for concurrent HTTP GET requests using the single handler.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_GetConcurrently(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")});
+    }
+}
+BENCHMARK(BM_GetConcurrently)->ThreadRange(1, 16)->UseRealTime();
+
+/**
+ * @brief This function is a benchmark test for concurrent HTTP GET requests using the shared multi handler.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_GetConcurrentlyUsingTheSharedMultiHandler(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                    {},
+                                    ConfigurationParameters {.handlerType = CurlHandlerTypeEnum::SHARED_MULTI});
+    }
+}
+BENCHMARK(BM_GetConcurrentlyUsingTheSharedMultiHandler)->ThreadRange(1, 16)->UseRealTime();
+
+/**
+ * @brief This function is a benchmark test for concurrent HTTP/2 GET requests multiplexed over one connection. The
+ * fake server only speaks HTTP/1.1, so it runs against the cleartext HTTP/2 server set in the
+ * 'URLREQUEST_H2_BENCHMARK_URL' environment variable (e.g. 'nghttpd --no-tls 44442').
+ *
+ * @param state Benchmark state.
+ */
+static void BM_GetHttp2UsingTheSharedMultiHandler(benchmark::State& state)
+{
+    const auto url {std::getenv("URLREQUEST_H2_BENCHMARK_URL")};
+    if (url == nullptr)
+    {
+        state.SkipWithError("URLREQUEST_H2_BENCHMARK_URL not set");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        HTTPRequest::instance().get(RequestParameters {.url = HttpURL(url)},
+                                    {},
+                                    ConfigurationParameters {.handlerType = CurlHandlerTypeEnum::SHARED_MULTI,
+                                                             .httpVersion = HttpVersionEnum::HTTP_2_PRIOR_KNOWLEDGE});
+    }
+}
+BENCHMARK(BM_GetHttp2UsingTheSharedMultiHandler)->ThreadRange(1, 16)->UseRealTime();
+
+/**
+ * @brief This function is a benchmark test for the scaling of concurrent HTTP GET requests with the number of threads,
+ * for a type of handler. Past QUEUE_MAX_SIZE threads, the handlers of the threads evict each other from the handler
+ * cache, which the 'evictions' counter shows.
+ *
+ * @param state Benchmark state.
+ * @param handlerType Type of the handler.
+ */
+static void BM_GetScaling(benchmark::State& state, const CurlHandlerTypeEnum handlerType)
+{
+    const HttpURL url {"http://localhost:44441/"};
+    LatencyRecorder latencyRecorder {state};
+    for (auto _ : state)
+    {
+        const auto start {std::chrono::steady_clock::now()};
+        HTTPRequest::instance().get(RequestParameters {.url = url},
+                                    {},
+                                    ConfigurationParameters {.handlerType = handlerType, .shouldRun = g_shouldRun});
+        latencyRecorder.record(std::chrono::steady_clock::now() - start);
+    }
+}
+BENCHMARK_CAPTURE(BM_GetScaling, single, CurlHandlerTypeEnum::SINGLE)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_CAPTURE(BM_GetScaling, multi, CurlHandlerTypeEnum::MULTI)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_CAPTURE(BM_GetScaling, shared_multi, CurlHandlerTypeEnum::SHARED_MULTI)->ThreadRange(1, 64)->UseRealTime();
+
+/**
+ * @brief Verb of the connection and transport benchmarks: the methods that perform and prepare its request, the path
+ * it's sent to and whether it has a body.
+ */
+struct BenchmarkVerb
+{
+    std::string_view name;
+    void (IURLRequest::*perform)(RequestParameters, PostRequestParameters, ConfigurationParameters);
+    PreparedRequest (HTTPRequest::*prepare)(RequestParameters, const std::atomic<bool>&, ConfigurationParameters);
+    std::string_view path;
+    bool hasBody;
+};
+
+constexpr std::array<BenchmarkVerb, 5> BENCHMARK_VERBS {
+    {{"GET", &IURLRequest::get, &HTTPRequest::prepareGet, "/", false},
+     {"POST", &IURLRequest::post, &HTTPRequest::preparePost, "/", true},
+     {"PUT", &IURLRequest::put, &HTTPRequest::preparePut, "/", true},
+     {"PATCH", &IURLRequest::patch, &HTTPRequest::preparePatch, "/", true},
+     {"DELETE", &IURLRequest::delete_, &HTTPRequest::prepareDelete, "/1", false}}};
+
+/**
+ * @brief How the connection benchmarks connect to the server: whether the server keeps the connections open, whether
+ * they use TLS and whether the TLS sessions are resumed. A new handle is used for each request to not resume them.
+ */
+struct ConnectionMode
+{
+    std::string_view name;
+    int port;
+    bool tls;
+    bool newHandle;
+};
+
+constexpr std::array<ConnectionMode, 5> CONNECTION_MODES {{{"reconnect", 44441, false, false},
+                                                          {"keep_alive", 44443, false, false},
+                                                          {"tls_full_handshake", 44445, true, true},
+                                                          {"tls_session_reuse", 44445, true, false},
+                                                          {"tls_keep_alive", 44444, true, false}}};
+
+/**
+ * @brief This function is a benchmark test for a verb under a connection mode, to measure what reusing the
+ * connections and the TLS sessions is worth. It reports the 'connections' opened per request, as given by libcurl.
+ *
+ * @param state Benchmark state.
+ * @param verb Verb of the requests.
+ * @param mode Connection mode.
+ */
+static void BM_Connection(benchmark::State& state, const BenchmarkVerb& verb, const ConnectionMode& mode)
+{
+    /**
+     * @brief Observer that counts the connections opened.
+     */
+    class ConnectionCounter final : public IRequestObserver
+    {
+    public:
+        long m_connections {0};
+
+        void onComplete(const RequestEvent&, long, const TransferMetrics& metrics) override
+        {
+            m_connections += metrics.connections;
+        }
+    };
+
+    const HttpURL url {std::string(mode.tls ? "https" : "http") + "://localhost:" + std::to_string(mode.port) +
+                       std::string(verb.path)};
+    const auto secureCommunication {SecureCommunication::builder().caRootCertificate(g_certificate.m_certificatePath)};
+    const auto counter {std::make_shared<ConnectionCounter>()};
+    const auto prepare {[&]()
+                        {
+                            return (HTTPRequest::instance().*verb.prepare)(
+                                RequestParameters {.url = url,
+                                                   .data = std::string(R"({"hello":"world"})"),
+                                                   .secureCommunication =
+                                                       mode.tls ? secureCommunication : SecureCommunication {}},
+                                g_shouldRun,
+                                ConfigurationParameters {.observer = counter});
+                        }};
+
+    auto request {prepare()};
+    for (auto _ : state)
+    {
+        if (mode.newHandle)
+        {
+            request = prepare();
+        }
+        request.execute();
+    }
+    state.counters["connections"] =
+        benchmark::Counter(static_cast<double>(counter->m_connections), benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * @brief Registers BM_Connection for each verb and connection mode, as 'BM_Connection/<verb>/<mode>'.
+ */
+const auto g_connectionBenchmarks {[]()
+                                   {
+                                       for (const auto& verb : BENCHMARK_VERBS)
+                                       {
+                                           for (const auto& mode : CONNECTION_MODES)
+                                           {
+                                               const auto name {"BM_Connection/" + std::string(verb.name) + "/" +
+                                                                std::string(mode.name)};
+                                               benchmark::RegisterBenchmark(name.c_str(), BM_Connection, verb, mode)
+                                                   ->UseRealTime();
+                                           }
+                                       }
+                                       return true;
+                                   }()};
+
+/**
+ * @brief This function is a benchmark test for a verb over a UNIX socket, with UNIXSocketRequest, or over TCP loopback,
+ * with HTTPRequest, both with the connections kept open. The argument is the size of the payload: the response of a
+ * GET, and the body of the verbs that have one, which the server echoes. Besides the latency percentiles, the
+ * 'evictions' counter shows whether the handler cache behaves the same for both transports.
+ *
+ * @param state Benchmark state.
+ * @param verb Verb of the requests.
+ * @param unixSocket Whether the requests go over the UNIX socket.
+ */
+static void BM_Transport(benchmark::State& state, const BenchmarkVerb& verb, const bool unixSocket)
+{
+    const auto size {static_cast<size_t>(state.range(0))};
+    const auto path {verb.name == "GET" ? "/payload/" + std::to_string(size) : std::string(verb.path)};
+    const auto url {unixSocket ? std::unique_ptr<URL>(std::make_unique<HttpUnixSocketURL>(g_unixSocketPath,
+                                                                                          "http://localhost" + path))
+                               : std::make_unique<HttpURL>("http://localhost:44443" + path)};
+    auto& request {unixSocket ? static_cast<IURLRequest&>(UNIXSocketRequest::instance())
+                              : static_cast<IURLRequest&>(HTTPRequest::instance())};
+    const std::string body(verb.hasBody ? size : 0, 'x');
+
+    LatencyRecorder latencyRecorder {state};
+    for (auto _ : state)
+    {
+        const auto start {std::chrono::steady_clock::now()};
+        (request.*verb.perform)(RequestParameters {.url = *url, .data = body},
+                                PostRequestParameters {.onSuccess = [](const std::string& response)
+                                                       { benchmark::DoNotOptimize(response.data()); }},
+                                {});
+        latencyRecorder.record(std::chrono::steady_clock::now() - start);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(verb.name == "DELETE" ? 0 : size));
+}
+
+/**
+ * @brief Registers BM_Transport for each verb over each transport, as 'BM_Transport/<verb>/<unix|tcp>', from 1 to 16
+ * threads and for payloads of 1 KiB, 32 KiB and 1 MiB.
+ */
+const auto g_transportBenchmarks {[]()
+                                  {
+                                      for (const auto& verb : BENCHMARK_VERBS)
+                                      {
+                                          for (const auto unixSocket : {true, false})
+                                          {
+                                              const auto name {"BM_Transport/" + std::string(verb.name) +
+                                                               (unixSocket ? "/unix" : "/tcp")};
+                                              auto benchmark {benchmark::RegisterBenchmark(
+                                                  name.c_str(), BM_Transport, verb, unixSocket)};
+                                              if (verb.name == "DELETE")
+                                              {
+                                                  benchmark->Arg(0);
+                                              }
+                                              else
+                                              {
+                                                  benchmark->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+                                              }
+                                              benchmark->ThreadRange(1, 16)->UseRealTime();
+                                          }
+                                      }
+                                      return true;
+                                  }()};
+
+/**
+ * @brief Allocations allowed per request on a hot path, made by our code through operator new and by libcurl. Ours are
+ * the counts measured when the budgets were recorded; libcurl's have some room, since they depend on the headers sent
+ * by the server. A change that allocates more on the path fails its benchmark, and a change that allocates less
+ * should lower the budget.
+ */
+struct AllocationBudget
+{
+    std::string_view name;
+    void (*request)();
+    size_t allocations;
+    size_t curlAllocations;
+};
+
+constexpr std::array<AllocationBudget, 3> ALLOCATION_BUDGETS {
+    {{"get",
+      []()
+      {
+          HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44443/")},
+                                      PostRequestParameters {.onSuccess = [](const std::string& response)
+                                                             { benchmark::DoNotOptimize(response.data()); }});
+      },
+      5,
+      56},
+     {"post",
+      []()
+      {
+          HTTPRequest::instance().post(
+              RequestParameters {.url = HttpURL("http://localhost:44443/"), .data = std::string(R"({"foo": "bar"})")});
+      },
+      5,
+      56},
+     {"download",
+      []()
+      {
+          HTTPRequest::instance().download(RequestParameters {.url = HttpURL("http://localhost:44443/")},
+                                           PostRequestParameters {.outputFile = g_allocationBudgetDownloadPath});
+      },
+      5,
+      56}}};
+
+/**
+ * @brief This function is a benchmark test for the allocations of a request on a hot path, over a kept-alive
+ * connection. It reports the 'allocations' and 'allocated_bytes' of our code and the 'curl_allocations' and
+ * 'curl_allocated_bytes' of libcurl per request, and fails if they are over the budget.
+ *
+ * @param state Benchmark state.
+ * @param budget Request and its budget.
+ */
+static void BM_AllocationBudget(benchmark::State& state, const AllocationBudget& budget)
+{
+    // The first request creates the handler and connects.
+    budget.request();
+
+    const auto allocations {t_allocations};
+    const auto allocatedBytes {t_allocatedBytes};
+    const auto curlAllocations {t_curlAllocations};
+    const auto curlAllocatedBytes {t_curlAllocatedBytes};
+    for (auto _ : state)
+    {
+        budget.request();
+    }
+
+    const auto perRequest {[&state](const size_t count)
+                           { return static_cast<double>(count) / static_cast<double>(state.iterations()); }};
+    state.counters["allocations"] = perRequest(t_allocations - allocations);
+    state.counters["allocated_bytes"] = perRequest(t_allocatedBytes - allocatedBytes);
+    state.counters["curl_allocations"] = perRequest(t_curlAllocations - curlAllocations);
+    state.counters["curl_allocated_bytes"] = perRequest(t_curlAllocatedBytes - curlAllocatedBytes);
+    // Written by the download budget.
+    std::filesystem::remove(g_allocationBudgetDownloadPath);
+
+    if (state.counters["allocations"] > static_cast<double>(budget.allocations) ||
+        state.counters["curl_allocations"] > static_cast<double>(budget.curlAllocations))
+    {
+        const auto error {"Over the allocation budget of " + std::to_string(budget.allocations) + " allocations and " +
+                          std::to_string(budget.curlAllocations) + " libcurl allocations per request"};
+        failBenchmark(state, error);
+    }
+}
+
+/**
+ * @brief Registers BM_AllocationBudget for each budget, as 'BM_AllocationBudget/<name>'.
+ */
+const auto g_allocationBudgetBenchmarks {[]()
+                                         {
+                                             for (const auto& budget : ALLOCATION_BUDGETS)
+                                             {
+                                                 benchmark::RegisterBenchmark(
+                                                     ("BM_AllocationBudget/" + std::string(budget.name)).c_str(),
+                                                     BM_AllocationBudget,
+                                                     budget);
+                                             }
+                                             return true;
+                                         }()};
+
+/**
+ * @brief This function is a benchmark test for the first request of a process, which the short-lived CLI tools pay on
+ * each run: the test tool is run to get a URL, and the time until it exits is measured. It takes the start of the
+ * process, the global initialization of libcurl, the creation of the handler, the name resolution and the connection
+ * and, over HTTPS, the loading of the CA certificate and the TLS handshake.
+ *
+ * @param state Benchmark state.
+ * @param arguments Arguments of the test tool.
+ */
+static void BM_ColdStart(benchmark::State& state, std::vector<std::string> arguments)
+{
+    std::vector<char*> argv {const_cast<char*>(URLREQUEST_TESTTOOL_PATH)};
+    for (auto& argument : arguments)
+    {
+        argv.push_back(argument.data());
+    }
+    argv.push_back(nullptr);
+
+    // The response isn't printed.
+    posix_spawn_file_actions_t fileActions;
+    posix_spawn_file_actions_init(&fileActions);
+    posix_spawn_file_actions_addopen(&fileActions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+
+    for (auto _ : state)
+    {
+        const auto start {std::chrono::steady_clock::now()};
+        pid_t pid;
+        auto status {0};
+        if (posix_spawn(&pid, URLREQUEST_TESTTOOL_PATH, &fileActions, nullptr, argv.data(), environ) != 0 ||
+            waitpid(pid, &status, 0) != pid)
+        {
+            state.SkipWithError("The test tool couldn't be run");
+            break;
+        }
+        const std::chrono::duration<double> elapsed {std::chrono::steady_clock::now() - start};
+
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            state.SkipWithError("The request of the test tool failed");
+            break;
+        }
+        state.SetIterationTime(elapsed.count());
+    }
+
+    posix_spawn_file_actions_destroy(&fileActions);
+}
+BENCHMARK_CAPTURE(BM_ColdStart, http, {"-u", "http://localhost:44441/", "-t", "get"})
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(
+    BM_ColdStart, https, {"-u", "https://localhost:44445/", "-t", "get", "--cacert", g_certificate.m_certificatePath})
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Operation of the soak benchmark, performed with the given handler type.
+ */
+struct SoakOperation
+{
+    std::string_view name;
+    void (*perform)(const CurlHandlerTypeEnum& handlerType);
+};
+
+const std::atomic<bool> g_interrupted {false}; ///< Flag of the interrupted requests of the soak benchmark.
+
+// Errors are part of the soak traffic, they're given to a callback that ignores them.
+const auto g_ignoreError {[](const std::string& /*error*/, const long /*statusCode*/) {}};
+
+constexpr std::array<SoakOperation, 9> SOAK_OPERATIONS {
+    {{"verbs",
+      [](const CurlHandlerTypeEnum& handlerType)
+      {
+          for (const auto& verb : BENCHMARK_VERBS)
+          {
+              (HTTPRequest::instance().*verb.perform)(
+                  RequestParameters {.url = HttpURL("http://localhost:44443" + std::string(verb.path)),
+                                     .data = std::string(verb.hasBody ? R"({"foo": "bar"})" : "")},
+                  PostRequestParameters {.onError = g_ignoreError},
+                  ConfigurationParameters {.handlerType = handlerType, .shouldRun = g_shouldRun});
+          }
+      }},
+     {"reconnect",
+      [](const CurlHandlerTypeEnum& handlerType)
+      {
+          HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                      PostRequestParameters {.onError = g_ignoreError},
+                                      ConfigurationParameters {.handlerType = handlerType, .shouldRun = g_shouldRun});
+      }},
+     {"payload",
+      [](const CurlHandlerTypeEnum& handlerType)
+      {
+          HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44443/payload/1048576")},
+                                      PostRequestParameters {.onError = g_ignoreError},
+                                      ConfigurationParameters {.handlerType = handlerType, .shouldRun = g_shouldRun});
+      }},
+     {"download",
+      [](const CurlHandlerTypeEnum& handlerType)
+      {
+          const auto outputFile {std::filesystem::temp_directory_path() /
+                                 ("urlrequest_soak_" +
+                                  std::to_string(std::hash<std::thread::id> {}(std::this_thread::get_id())))};
+          HTTPRequest::instance().download(
+              RequestParameters {.url = HttpURL("http://localhost:44443/payload/65536")},
+              PostRequestParameters {.onError = g_ignoreError, .outputFile = outputFile},
+              ConfigurationParameters {.handlerType = handlerType, .shouldRun = g_shouldRun});
+          std::error_code error;
+          std::filesystem::remove(outputFile, error);
+      }},
+     {"not_found",
+      [](const CurlHandlerTypeEnum& handlerType)
+      {
+          HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44443/not-found")},
+                                      PostRequestParameters {.onError = g_ignoreError},
+                                      ConfigurationParameters {.handlerType = handlerType, .shouldRun = g_shouldRun});
+      }},
+     {"refused",
+      [](const CurlHandlerTypeEnum& handlerType)
+      {
+          HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:1/")},
+                                      PostRequestParameters {.onError = g_ignoreError},
+                                      ConfigurationParameters {.handlerType = handlerType, .shouldRun = g_shouldRun});
+      }},
+     {"interrupted",
+      [](const CurlHandlerTypeEnum& handlerType)
+      {
+          // The single handler can't be interrupted. A handler of the cache stays bound to the flag of its first
+          // request, so the interrupted request gets its own.
+          const auto request {std::make_shared<cURLWrapper>(cURLHandlerCache::createCurlHandler(
+              handlerType == CurlHandlerTypeEnum::SINGLE ? CurlHandlerTypeEnum::MULTI : handlerType, g_interrupted))};
+          try
+          {
+              GetRequest::builder(request).url("http://localhost:44443/").execute();
+          }
+          catch (const std::exception&)
+          {
+              // The request is interrupted.
+          }
+      }},
+     {"prepared",
+      [](const CurlHandlerTypeEnum& handlerType)
+      {
+          auto request {
+              HTTPRequest::instance().prepareGet(RequestParameters {.url = HttpURL("http://localhost:44443/")},
+                                                 g_shouldRun,
+                                                 ConfigurationParameters {.handlerType = handlerType})};
+          request.execute(PostRequestParameters {.onError = g_ignoreError});
+          request.execute(PostRequestParameters {.onError = g_ignoreError});
+      }},
+     {"unix_socket",
+      [](const CurlHandlerTypeEnum& handlerType)
+      {
+          UNIXSocketRequest::instance().get(
+              RequestParameters {.url = HttpUnixSocketURL(g_unixSocketPath, "http://localhost/")},
+              PostRequestParameters {.onError = g_ignoreError},
+              ConfigurationParameters {.handlerType = handlerType, .shouldRun = g_shouldRun});
+      }}}};
+
+constexpr std::array<CurlHandlerTypeEnum, 3> SOAK_HANDLER_TYPES {
+    CurlHandlerTypeEnum::SINGLE, CurlHandlerTypeEnum::MULTI, CurlHandlerTypeEnum::SHARED_MULTI};
+
+// Threads of the soak benchmark performing requests at once, more than the handlers kept by the handler cache.
+constexpr size_t SOAK_THREADS {QUEUE_MAX_SIZE + 3};
+
+// Operations performed by each thread before it exits and another thread takes its place.
+constexpr size_t SOAK_OPERATIONS_PER_THREAD {64};
+
+// Samples of the resources taken during the soak benchmark.
+constexpr size_t SOAK_SAMPLES {60};
+
+/**
+ * @brief Performs the operations of a thread of the soak benchmark, with the handler types in turn.
+ *
+ * @param first Index of the first operation.
+ * @param deadline Time when the operations stop.
+ * @return size_t Operations performed, SOAK_OPERATIONS_PER_THREAD unless the deadline is reached.
+ */
+size_t performSoakOperations(const size_t first, const std::chrono::steady_clock::time_point deadline)
+{
+    size_t performed {0};
+    for (; performed < SOAK_OPERATIONS_PER_THREAD && std::chrono::steady_clock::now() < deadline; ++performed)
+    {
+        const auto next {first + performed};
+        const auto& operation {SOAK_OPERATIONS[next % SOAK_OPERATIONS.size()]};
+        try
+        {
+            operation.perform(SOAK_HANDLER_TYPES[next % SOAK_HANDLER_TYPES.size()]);
+        }
+        catch (const std::exception& e)
+        {
+            // The failed requests are reported to their callbacks, an exception is unexpected.
+            std::cerr << "Soak operation '" << operation.name << "' threw: " << e.what() << std::endl;
+        }
+    }
+    return performed;
+}
+
+/**
+ * @brief Resource sampled by the soak benchmark, with the growth allowed to its median between the first and the
+ * second half of the run.
+ */
+struct SoakResource
+{
+    std::string_view name;
+    double (*sample)();
+    double allowedGrowth;
+};
+
+constexpr std::array<SoakResource, 3> SOAK_RESOURCES {
+    {{"rss_mib",
+      []()
+      {
+          std::ifstream status {"/proc/self/status"};
+          std::string line;
+          while (std::getline(status, line))
+          {
+              if (line.rfind("VmRSS:", 0) == 0)
+              {
+                  return std::stod(line.substr(line.find_first_of("0123456789"))) / 1024;
+              }
+          }
+          return 0.0;
+      },
+      16},
+     {"open_fds",
+      []()
+      {
+          const std::filesystem::directory_iterator descriptors {"/proc/self/fd"};
+          return static_cast<double>(std::distance(begin(descriptors), end(descriptors)));
+      },
+      SOAK_THREADS},
+     {"live_handles",
+      []() { return static_cast<double>(RequestMetricsRegistry::instance().snapshot().m_liveHandles); },
+      SOAK_THREADS}}};
+
+/**
+ * @brief This function is a benchmark test for the resources of a long-running process. Mixed traffic is performed for
+ * the given time: all the verbs, downloads, large responses, errors, interrupted requests, prepared requests and
+ * requests over a UNIX socket, with every handler type. The threads exit after a few requests and are replaced, so the
+ * handler cache keeps evicting handlers. The resident memory, the open descriptors and the cURL handles alive are
+ * sampled meanwhile, and the benchmark fails if their median over the second half of the run is higher than over the
+ * first half by more than the allowed growth: a bounded working set levels off, while a leak keeps raising it. The
+ * first tenth of the run, when they grow to their working set, isn't compared.
+ *
+ * The samples are written to the CSV file given by URLREQUEST_BENCHMARK_SOAK_SAMPLES, if set.
+ *
+ * @param state Benchmark state.
+ * @param duration Time the traffic runs for.
+ */
+static void BM_Soak(benchmark::State& state, const std::chrono::seconds duration)
+{
+    const auto interval {std::max<std::chrono::milliseconds>(std::chrono::milliseconds(1),
+                                                             std::chrono::milliseconds(duration) / SOAK_SAMPLES)};
+    std::vector<std::array<double, SOAK_RESOURCES.size()>> samples;
+    std::atomic<uint64_t> operations {0};
+
+    for (auto _ : state)
+    {
+        const auto start {std::chrono::steady_clock::now()};
+        const auto deadline {start + duration};
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < SOAK_THREADS; ++i)
+        {
+            threads.emplace_back(
+                [&operations, deadline, i]()
+                {
+                    // Each thread is replaced by a new one once its operations are done.
+                    for (auto next {i}; std::chrono::steady_clock::now() < deadline; next += SOAK_OPERATIONS_PER_THREAD)
+                    {
+                        std::thread worker {[&operations, next, deadline]()
+                                            { operations += performSoakOperations(next, deadline); }};
+                        worker.join();
+                    }
+                });
+        }
+
+        for (auto next {start + interval}; next <= deadline; next += interval)
+        {
+            std::this_thread::sleep_until(next);
+            auto& sample {samples.emplace_back()};
+            std::transform(SOAK_RESOURCES.begin(),
+                           SOAK_RESOURCES.end(),
+                           sample.begin(),
+                           [](const SoakResource& resource) { return resource.sample(); });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    if (const auto path {std::getenv("URLREQUEST_BENCHMARK_SOAK_SAMPLES")}; path != nullptr)
+    {
+        std::ofstream file {path};
+        file << "seconds";
+        for (const auto& resource : SOAK_RESOURCES)
+        {
+            file << ',' << resource.name;
+        }
+        file << '\n';
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            file << std::chrono::duration<double>(interval * (i + 1)).count();
+            for (const auto value : samples[i])
+            {
+                file << ',' << value;
+            }
+            file << '\n';
+        }
+    }
+
+    state.counters["operations"] = benchmark::Counter(static_cast<double>(operations), benchmark::Counter::kIsRate);
+    const auto warmup {samples.size() / 10};
+    const auto half {warmup + (samples.size() - warmup) / 2};
+    for (size_t i = 0; i < SOAK_RESOURCES.size(); ++i)
+    {
+        const auto& resource {SOAK_RESOURCES[i]};
+        const auto median {[&samples, i](const size_t first, const size_t last)
+                           {
+                               std::vector<double> values;
+                               std::transform(samples.begin() + first,
+                                              samples.begin() + last,
+                                              std::back_inserter(values),
+                                              [i](const auto& sample) { return sample[i]; });
+                               std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+                               return values.empty() ? 0.0 : values[values.size() / 2];
+                           }};
+        const auto growth {median(half, samples.size()) - median(warmup, half)};
+        state.counters[std::string(resource.name)] = samples.empty() ? 0.0 : samples.back()[i];
+        state.counters[std::string(resource.name) + "_growth"] = growth;
+        if (growth > resource.allowedGrowth)
+        {
+            const auto error {std::string(resource.name) + " grew by " + std::to_string(growth) +
+                              " over the second half of the run"};
+            failBenchmark(state, error);
+        }
+    }
+}
+
+/**
+ * @brief Registers BM_Soak when URLREQUEST_BENCHMARK_SOAK_SECONDS is set to the time it runs for, since it's meant to
+ * run for hours.
+ */
+const auto g_soakBenchmark {[]()
+                            {
+                                if (const auto seconds {std::getenv("URLREQUEST_BENCHMARK_SOAK_SECONDS")};
+                                    seconds != nullptr)
+                                {
+                                    benchmark::RegisterBenchmark(
+                                        "BM_Soak", BM_Soak, std::chrono::seconds(std::stol(seconds)))
+                                        ->Iterations(1)
+                                        ->UseRealTime()
+                                        ->Unit(benchmark::kSecond);
+                                }
+                                return true;
+                            }()};
+
+/**
+ * @brief This function is a benchmark test for the builder path of a request: the options are set on the handle, but
+ * the request isn't performed. Each request creates its wrapper and calls it through the IRequestImplementator
+ * interface.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_BuilderPath(benchmark::State& state)
+{
+    const std::string url {"http://localhost:44441/"};
+    const std::string data {R"({"foo": "bar"})"};
+    const std::string userAgent {"urlrequest-benchmark"};
+    const AllocationCounter allocationCounter {state};
+    for (auto _ : state)
+    {
+        PostRequest::builder(FactoryRequestWrapper<cURLWrapper>::create())
+            .url(url)
+            .postData(data)
+            .appendHeaders(DEFAULT_HEADERS)
+            .timeout(1000)
+            .userAgent(userAgent);
+    }
+}
+BENCHMARK(BM_BuilderPath);
+
+/**
+ * @brief This function is a benchmark test for the builder path of a request over a wrapper of the thread pool, called
+ * without virtual calls.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_BuilderPathUsingThePool(benchmark::State& state)
+{
+    const std::string url {"http://localhost:44441/"};
+    const std::string data {R"({"foo": "bar"})"};
+    const std::string userAgent {"urlrequest-benchmark"};
+    const AllocationCounter allocationCounter {state};
+    for (auto _ : state)
+    {
+        BasicPostRequest<cURLWrapper>::builder(FactoryRequestWrapper<cURLWrapper>::acquire())
+            .url(url)
+            .postData(data)
+            .appendHeaders(DEFAULT_HEADERS)
+            .timeout(1000)
+            .userAgent(userAgent);
+    }
+}
+BENCHMARK(BM_BuilderPathUsingThePool);
+
+/**
+ * @brief This function is a benchmark test for recording a request in the request metrics.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_RecordRequestMetrics(benchmark::State& state)
+{
+    auto& requestMetrics {RequestMetricsRegistry::instance()};
+    const TransferMetrics metrics {.totalTime = std::chrono::microseconds(1500), .bytesReceived = 512};
+    for (auto _ : state)
+    {
+        requestMetrics.requestStarted();
+        requestMetrics.requestFinished({"GET", 200, "localhost"}, metrics);
+    }
+}
+BENCHMARK(BM_RecordRequestMetrics)->ThreadRange(1, 8);
+
+/**
+ * @brief This function is a benchmark test for setting the headers of a request by appending them one by one, as a
+ * new header list.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_AppendHeaders(benchmark::State& state)
+{
+    const AllocationCounter allocationCounter {state};
+    for (auto _ : state)
+    {
+        BasicGetRequest<cURLWrapper>::builder(FactoryRequestWrapper<cURLWrapper>::acquire())
+            .appendHeaders(DEFAULT_HEADERS)
+            .appendHeader("X-Trace: 1");
+    }
+}
+BENCHMARK(BM_AppendHeaders);
+
+/**
+ * @brief This function is a benchmark test for setting the headers of a request from a compiled header set, with a
+ * header appended on top of it.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_SetHeaderSet(benchmark::State& state)
+{
+    const auto& headers {HeaderSet::defaults()};
+    const AllocationCounter allocationCounter {state};
+    for (auto _ : state)
+    {
+        BasicGetRequest<cURLWrapper>::builder(FactoryRequestWrapper<cURLWrapper>::acquire())
+            .headers(headers)
+            .appendHeader("X-Trace: 1");
+    }
+}
+BENCHMARK(BM_SetHeaderSet);
+
+static void BM_ReturnStringByValue(benchmark::State& state)
+{
+    SecureCommunication secureComm;
+    secureComm.sslCertificate("path/to/certificate");
+
+    for (auto _ : state)
+    {
+        std::string result = secureComm.getParameter(urlrequest::AuthenticationParameter::SSL_CERTIFICATE);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_ReturnStringByValue);
+
+/**
+ * @brief Runs the benchmarks, like BENCHMARK_MAIN, but exits with a failure when a benchmark fails a check.
+ */
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return EXIT_FAILURE;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return g_failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
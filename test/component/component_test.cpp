@@ -13,10 +13,18 @@
 #include "curlHandlerCache.hpp"
 #include "curlWrapper.hpp"
 #include "factoryRequestImplemetator.hpp"
+#include "inFlightRequests.hpp"
+#include "requestMetrics.hpp"
+#include "requestTrace.hpp"
 #include "urlRequest.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <map>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <utility>
+#include <vector>
 
 auto constexpr TEST_NET_IP {"192.0.2.1"};
 
@@ -59,6 +67,68 @@ void checkEmptyFile(const std::string& file)
     ASSERT_EQ(fileSize, 0) << "File is not empty: " << file;
 }
 
+/**
+ * @brief Request observer that records the events it receives.
+ */
+class RecordingObserver final : public IRequestObserver
+{
+public:
+    std::vector<std::pair<std::string, RequestEvent>> m_events; ///< Hook and event, the views of the event dangle.
+    long m_status {0};                                           ///< Status of the last completed or failed request.
+
+    void onStart(const RequestEvent& event) override
+    {
+        m_events.emplace_back("start", event);
+    }
+
+    void onDnsDone(const RequestEvent& event) override
+    {
+        m_events.emplace_back("dns", event);
+    }
+
+    void onConnected(const RequestEvent& event) override
+    {
+        m_events.emplace_back("connected", event);
+    }
+
+    void onTlsDone(const RequestEvent& event) override
+    {
+        m_events.emplace_back("tls", event);
+    }
+
+    void onFirstByte(const RequestEvent& event) override
+    {
+        m_events.emplace_back("firstByte", event);
+    }
+
+    void onComplete(const RequestEvent& event, const long status, const TransferMetrics& metrics) override
+    {
+        EXPECT_EQ(event.elapsed, metrics.totalTime);
+        m_events.emplace_back("complete", event);
+        m_status = status;
+    }
+
+    void onError(const RequestEvent& event, std::string_view message, const long status) override
+    {
+        EXPECT_FALSE(message.empty());
+        m_events.emplace_back("error", event);
+        m_status = status;
+    }
+
+    /**
+     * @brief Returns the hooks called, in order.
+     */
+    std::vector<std::string> hooks() const
+    {
+        std::vector<std::string> result;
+        for (const auto& [hook, event] : m_events)
+        {
+            result.push_back(hook);
+        }
+        return result;
+    }
+};
+
 /* Tests */
 
 /**
@@ -91,6 +161,202 @@ TEST_F(ComponentTestInterface, GetHelloWorldRedirection)
     EXPECT_TRUE(m_callbackComplete);
 }
 
+/**
+ * @brief Test that the permanent redirects are cached, and the following requests skip them.
+ */
+TEST_F(ComponentTestInterface, GetUsingThePermanentRedirectsCache)
+{
+    const std::string redirectCachePath {TEST_REDIRECT_CACHE_FILE};
+    std::string firstResult;
+    std::string secondResult;
+
+    HTTPRequest::instance().get(
+        RequestParameters {.url = HttpURL("http://localhost:44441/permanent-redirect")},
+        PostRequestParameters {.onSuccess = [&](const std::string& result) { firstResult = result; }},
+        ConfigurationParameters {.cachePermanentRedirects = true, .redirectCachePath = redirectCachePath});
+
+    HTTPRequest::instance().get(
+        RequestParameters {.url = HttpURL("http://localhost:44441/permanent-redirect")},
+        PostRequestParameters {.onSuccess = [&](const std::string& result) { secondResult = result; }},
+        ConfigurationParameters {.cachePermanentRedirects = true, .redirectCachePath = redirectCachePath});
+
+    EXPECT_FALSE(firstResult.empty());
+    // The second request went straight to the target.
+    EXPECT_EQ(firstResult, secondResult);
+    EXPECT_EQ(PermanentRedirectCacheRegistry::instance()
+                  .getCache(redirectCachePath)
+                  ->resolve("http://localhost:44441/permanent-redirect"),
+              "http://localhost:44441/redirect-counter");
+    EXPECT_TRUE(std::filesystem::exists(TEST_REDIRECT_CACHE_FILE));
+
+    // Without the cache, the request follows the redirect again.
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/permanent-redirect")},
+                                PostRequestParameters {.onSuccess = [&](const std::string& result)
+                                                       {
+                                                           EXPECT_NE(result, firstResult);
+                                                           m_callbackComplete = true;
+                                                       }});
+
+    EXPECT_TRUE(m_callbackComplete);
+}
+
+/**
+ * @brief Test that a cached redirect whose target fails is dropped, and the request is retried on the original URL.
+ */
+TEST_F(ComponentTestInterface, GetWithAStalePermanentRedirect)
+{
+    PermanentRedirectCacheRegistry::instance().getCache()->insert("http://localhost:44441/",
+                                                                  "http://localhost:44441/not-found");
+
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                PostRequestParameters {.onSuccess = [&](const std::string& result)
+                                                       {
+                                                           EXPECT_EQ(result, "Hello World!");
+                                                           m_callbackComplete = true;
+                                                       }},
+                                ConfigurationParameters {.cachePermanentRedirects = true});
+
+    EXPECT_TRUE(m_callbackComplete);
+    EXPECT_EQ(PermanentRedirectCacheRegistry::instance().getCache()->resolve("http://localhost:44441/"),
+              "http://localhost:44441/");
+}
+
+/**
+ * @brief Test that a cached redirect whose target answers with a server error is dropped, and the request is retried on
+ * the original URL.
+ */
+TEST_F(ComponentTestInterface, GetWithAPermanentRedirectTargetFailing)
+{
+    PermanentRedirectCacheRegistry::instance().getCache()->insert("http://localhost:44441/",
+                                                                  "http://localhost:44441/server-error");
+
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                PostRequestParameters {.onSuccess = [&](const std::string& result)
+                                                       {
+                                                           EXPECT_EQ(result, "Hello World!");
+                                                           m_callbackComplete = true;
+                                                       }},
+                                ConfigurationParameters {.cachePermanentRedirects = true});
+
+    EXPECT_TRUE(m_callbackComplete);
+    EXPECT_EQ(PermanentRedirectCacheRegistry::instance().getCache()->resolve("http://localhost:44441/"),
+              "http://localhost:44441/");
+}
+
+/**
+ * @brief Test that a cached redirect whose target can't be reached in time isn't retried on the original URL.
+ */
+TEST_F(ComponentTestInterface, GetWithAPermanentRedirectTargetTimingOut)
+{
+    PermanentRedirectCacheRegistry::instance().getCache()->insert("http://localhost:44441/",
+                                                                  "http://localhost:44441/sleep/1000");
+
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                PostRequestParameters {.onSuccess = [](const std::string& result) { FAIL() << result; },
+                                                       .onError = [&](const std::string&, const long /*responseCode*/)
+                                                       { m_callbackComplete = true; }},
+                                ConfigurationParameters {.timeout = 100, .cachePermanentRedirects = true});
+
+    EXPECT_TRUE(m_callbackComplete);
+    EXPECT_EQ(PermanentRedirectCacheRegistry::instance().getCache()->resolve("http://localhost:44441/"),
+              "http://localhost:44441/sleep/1000");
+}
+
+/**
+ * @brief Test that a permanent redirect to another host is cached, and that the requests sent straight to its target
+ * don't carry the credentials of the original request.
+ */
+TEST_F(ComponentTestInterface, GetUsingACrossHostPermanentRedirect)
+{
+    std::vector<TransferMetrics> transfers;
+    TransferObserver::set([&transfers](std::string_view /*url*/, const long /*status*/, const TransferMetrics& metrics)
+                          { transfers.emplace_back(metrics); });
+
+    for (int i = 0; i < 2; ++i)
+    {
+        HTTPRequest::instance().get(
+            RequestParameters {.url = HttpURL("http://localhost:44441/cross-host-redirect"),
+                               .secureCommunication = SecureCommunication::builder().basicAuth("user:password"),
+                               .httpHeaders = {"Authorization: Bearer token", "Cookie: session=1", "X-Custom: 1"}},
+            PostRequestParameters {.onSuccess = [](const std::string& result)
+                                   {
+                                       const auto headers {nlohmann::json::parse(result)};
+                                       EXPECT_FALSE(headers.contains("Authorization"));
+                                       EXPECT_FALSE(headers.contains("Cookie"));
+                                       EXPECT_EQ(headers.value("X-Custom", ""), "1");
+                                   }},
+            ConfigurationParameters {.cachePermanentRedirects = true});
+    }
+    TransferObserver::set({});
+
+    EXPECT_EQ(PermanentRedirectCacheRegistry::instance().getCache()->resolve(
+                  "http://localhost:44441/cross-host-redirect"),
+              "http://127.0.0.1:44441/check-headers");
+    ASSERT_EQ(transfers.size(), 2);
+    EXPECT_EQ(transfers.front().redirectCount, 1);
+    // The second request went straight to the target.
+    EXPECT_EQ(transfers.back().redirectCount, 0);
+}
+
+/**
+ * @brief Test that the HSTS cache upgrades the request to HTTPS locally, and is written back when the handle is
+ * released. The test server doesn't speak TLS, so the upgraded request fails.
+ */
+TEST_F(ComponentTestInterface, GetUsingTheHstsCache)
+{
+    const std::string hstsCachePath {TEST_HSTS_CACHE_FILE};
+    std::ofstream(TEST_HSTS_CACHE_FILE) << "localhost \"20991231 00:00:00\"\n";
+
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                PostRequestParameters {.onSuccess = [](const std::string& result)
+                                                       { FAIL() << "Request not upgraded: " << result; },
+                                                       .onError = [&](const std::string& /*result*/, const long)
+                                                       { m_callbackComplete = true; }},
+                                ConfigurationParameters {.hstsCachePath = hstsCachePath});
+
+    EXPECT_TRUE(m_callbackComplete);
+
+    // The cache file is rewritten by libcurl when the handle is cleaned up.
+    cURLHandlerCache::instance().clear();
+    std::ifstream cacheFile(TEST_HSTS_CACHE_FILE);
+    const std::string content {std::istreambuf_iterator<char>(cacheFile), std::istreambuf_iterator<char>()};
+    EXPECT_NE(content.find("libcurl"), std::string::npos);
+    EXPECT_NE(content.find("localhost"), std::string::npos);
+}
+
+/**
+ * @brief Test the get request using the shared response cache. The second request must be served from the cache.
+ */
+TEST_F(ComponentTestInterface, GetUsingTheSharedCache)
+{
+    const std::string sharedCachePath {TEST_SHARED_CACHE_FILE};
+    std::string firstResult;
+    std::string secondResult;
+
+    HTTPRequest::instance().get(
+        RequestParameters {.url = HttpURL("http://localhost:44441/counter")},
+        PostRequestParameters {.onSuccess = [&](const std::string& result) { firstResult = result; }},
+        ConfigurationParameters {.sharedCacheTTL = 60, .sharedCachePath = sharedCachePath});
+
+    HTTPRequest::instance().get(
+        RequestParameters {.url = HttpURL("http://localhost:44441/counter")},
+        PostRequestParameters {.onSuccess = [&](const std::string& result) { secondResult = result; }},
+        ConfigurationParameters {.sharedCacheTTL = 60, .sharedCachePath = sharedCachePath});
+
+    EXPECT_FALSE(firstResult.empty());
+    EXPECT_EQ(firstResult, secondResult);
+
+    // Without the cache, the request reaches the server again.
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/counter")},
+                                PostRequestParameters {.onSuccess = [&](const std::string& result)
+                                                       {
+                                                           EXPECT_NE(result, firstResult);
+                                                           m_callbackComplete = true;
+                                                       }});
+
+    EXPECT_TRUE(m_callbackComplete);
+}
+
 /**
  * @brief Test the post request.
  */
@@ -151,6 +417,79 @@ TEST_F(ComponentTestInterface, DownloadFile)
     checkFileContent(TEST_FILE_1, "Hello World!");
 }
 
+/**
+ * @brief Test the download request using the download store. The second download must be cloned from the store.
+ */
+TEST_F(ComponentTestInterface, DownloadFileUsingTheDownloadStore)
+{
+    const std::string downloadStorePath {TEST_DOWNLOAD_STORE_DIR};
+    const std::string contentValidator {"v1"};
+
+    HTTPRequest::instance().download(
+        RequestParameters {.url = HttpURL("http://localhost:44441/"), .contentValidator = contentValidator},
+        PostRequestParameters {.outputFile = TEST_FILE_1},
+        ConfigurationParameters {.downloadStorePath = downloadStorePath});
+    checkFileContent(TEST_FILE_1, "Hello World!");
+
+    // Mark the stored entry, so the second output shows where it comes from.
+    for (const auto& entry : std::filesystem::directory_iterator(downloadStorePath))
+    {
+        if (entry.path().extension().empty())
+        {
+            std::ofstream(entry.path()) << "Stored content";
+        }
+    }
+
+    HTTPRequest::instance().download(
+        RequestParameters {.url = HttpURL("http://localhost:44441/"), .contentValidator = contentValidator},
+        PostRequestParameters {.outputFile = TEST_FILE_2},
+        ConfigurationParameters {.downloadStorePath = downloadStorePath});
+
+    checkFileContent(TEST_FILE_1, "Hello World!");
+    checkFileContent(TEST_FILE_2, "Stored content");
+    // The outputs don't share their inode with the store entry.
+    EXPECT_FALSE(std::filesystem::equivalent(TEST_FILE_1, TEST_FILE_2));
+}
+
+/**
+ * @brief Test the delta update of a file when the server doesn't offer a patch: the full file is downloaded.
+ */
+TEST_F(ComponentTestInterface, DownloadFileDeltaUpdateWithoutPatch)
+{
+    std::ofstream(TEST_FILE_1) << "Old content";
+    // SHA-256 of "Hello World!".
+    const std::string expectedDigest {"7f83b1657ff1fc53b92dc18148a1d65dfc2d4b1fa3d677284addd200126d9069"};
+
+    HTTPRequest::instance().download(
+        RequestParameters {.url = HttpURL("http://localhost:44441/"), .expectedDigest = expectedDigest},
+        PostRequestParameters {.onError = [](const std::string& result, const long) { FAIL() << result; },
+                               .outputFile = TEST_FILE_1},
+        ConfigurationParameters {.deltaUpdate = true});
+
+    checkFileContent(TEST_FILE_1, "Hello World!");
+}
+
+/**
+ * @brief Test the download request with a digest that doesn't match the content.
+ */
+TEST_F(ComponentTestInterface, DownloadFileDigestMismatch)
+{
+    const std::string expectedDigest {"0000000000000000000000000000000000000000000000000000000000000000"};
+
+    HTTPRequest::instance().download(
+        RequestParameters {.url = HttpURL("http://localhost:44441/"), .expectedDigest = expectedDigest},
+        PostRequestParameters {.onError =
+                                   [&](const std::string& result, const long responseCode)
+                               {
+                                   EXPECT_EQ(result, "Downloaded file digest mismatch");
+                                   EXPECT_EQ(responseCode, -1);
+                                   m_callbackComplete = true;
+                               },
+                               .outputFile = TEST_FILE_1});
+
+    EXPECT_TRUE(m_callbackComplete);
+}
+
 /**
  * @brief Test the download request with empty URL.
  */
@@ -259,6 +598,241 @@ TEST_F(ComponentTestInterface, DownloadFileUsingTheMultiHandler)
     checkFileContent(TEST_FILE_1, "Hello World!");
 }
 
+/**
+ * @brief Test concurrent GET requests from several threads using the shared multi handler.
+ */
+TEST_F(ComponentTestInterface, GetHelloWorldConcurrentlyUsingTheSharedMultiHandler)
+{
+    constexpr auto THREADS {4};
+    constexpr auto REQUESTS_PER_THREAD {5};
+    std::atomic<int> responses {0};
+
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < THREADS; ++i)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                for (auto j = 0; j < REQUESTS_PER_THREAD; ++j)
+                {
+                    HTTPRequest::instance().get(
+                        RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                        PostRequestParameters {.onSuccess =
+                                                   [&](const std::string& result)
+                                               {
+                                                   EXPECT_EQ(result, "Hello World!");
+                                                   ++responses;
+                                               }},
+                        ConfigurationParameters {.handlerType = CurlHandlerTypeEnum::SHARED_MULTI,
+                                                 .shouldRun = m_shouldRun});
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(responses, THREADS * REQUESTS_PER_THREAD);
+}
+
+/**
+ * @brief Test the custom download request using the shared multi handler and interrupt the handler.
+ */
+TEST_F(ComponentTestInterface, InterruptSharedMultiHandler)
+{
+    m_shouldRun.store(false);
+
+    HTTPRequest::instance().download(
+        RequestParameters {.url = HttpURL("http://localhost:44441/")},
+        PostRequestParameters {.outputFile = TEST_FILE_1},
+        ConfigurationParameters {.handlerType = CurlHandlerTypeEnum::SHARED_MULTI, .shouldRun = m_shouldRun});
+
+    checkEmptyFile(TEST_FILE_1);
+}
+
+/**
+ * @brief Test GET requests built from a parsed URL and a query.
+ */
+TEST_F(ComponentTestInterface, GetWithAQueryOnAParsedUrl)
+{
+    const auto base {HttpURL::parse("http://localhost:44441/check-query")};
+    QueryBuilder query;
+
+    for (const auto& value : {"first value", "second&value=/?"})
+    {
+        query.clear();
+        query.add("key", value).add("id", "1");
+
+        m_callbackComplete = false;
+        HTTPRequest::instance().get(RequestParameters {.url = HttpURL(base, query)},
+                                    PostRequestParameters {.onSuccess =
+                                                               [&](const std::string& result)
+                                                           {
+                                                               const auto params = nlohmann::json::parse(result);
+                                                               EXPECT_EQ(params.at("key"), value);
+                                                               EXPECT_EQ(params.at("id"), "1");
+                                                               m_callbackComplete = true;
+                                                           }});
+
+        EXPECT_TRUE(m_callbackComplete);
+    }
+}
+
+/**
+ * @brief Test a prepared GET request performed several times.
+ */
+TEST_F(ComponentTestInterface, PreparedGetExecutedSeveralTimes)
+{
+    auto request {HTTPRequest::instance().prepareGet(
+        RequestParameters {.url = HttpURL("http://localhost:44441/counter")}, m_shouldRun)};
+
+    std::vector<std::string> responses;
+    for (auto i = 0; i < 3; ++i)
+    {
+        request.execute(
+            PostRequestParameters {.onSuccess = [&](const std::string& result) { responses.push_back(result); }});
+    }
+
+    ASSERT_EQ(responses.size(), 3);
+    EXPECT_LT(std::stoi(responses[0]), std::stoi(responses[1]));
+    EXPECT_LT(std::stoi(responses[1]), std::stoi(responses[2]));
+}
+
+/**
+ * @brief Test a prepared POST request performed with different bodies.
+ */
+TEST_F(ComponentTestInterface, PreparedPostWithDifferentBodies)
+{
+    auto request {HTTPRequest::instance().preparePost(
+        RequestParameters {.url = HttpURL("http://localhost:44441/"), .data = R"({"default":"body"})"_json},
+        m_shouldRun)};
+
+    const auto checkResponse {[&](const std::string& expected)
+                              {
+                                  return PostRequestParameters {.onSuccess = [&, expected](const std::string& result)
+                                                                {
+                                                                    EXPECT_EQ(result, expected);
+                                                                    m_callbackComplete = true;
+                                                                }};
+                              }};
+
+    request.execute(R"({"first":"body"})", checkResponse(R"({"first":"body"})"));
+    EXPECT_TRUE(m_callbackComplete);
+
+    m_callbackComplete = false;
+    request.execute(checkResponse(R"({"default":"body"})"));
+    EXPECT_TRUE(m_callbackComplete);
+
+    m_callbackComplete = false;
+    request.execute(std::string(1024, 'x'), checkResponse(std::string(1024, 'x')));
+    EXPECT_TRUE(m_callbackComplete);
+}
+
+/**
+ * @brief Test a prepared GET request performed with and without a query.
+ */
+TEST_F(ComponentTestInterface, PreparedGetWithAQuery)
+{
+    auto request {HTTPRequest::instance().prepareGet(
+        RequestParameters {.url = HttpURL("http://localhost:44441/check-query")}, m_shouldRun)};
+
+    QueryBuilder query;
+    query.add("key", "some value");
+    request.execute(query,
+                    PostRequestParameters {.onSuccess =
+                                               [&](const std::string& result)
+                                           {
+                                               EXPECT_EQ(nlohmann::json::parse(result), R"({"key":"some value"})"_json);
+                                               m_callbackComplete = true;
+                                           }});
+    EXPECT_TRUE(m_callbackComplete);
+
+    // The prepared URL is used again without the query.
+    m_callbackComplete = false;
+    request.execute(PostRequestParameters {.onSuccess =
+                                               [&](const std::string& result)
+                                           {
+                                               EXPECT_EQ(nlohmann::json::parse(result), nlohmann::json::object());
+                                               m_callbackComplete = true;
+                                           }});
+    EXPECT_TRUE(m_callbackComplete);
+}
+
+/**
+ * @brief Test that a prepared request reports the errors and can be performed again.
+ */
+TEST_F(ComponentTestInterface, PreparedGetAfterAnError)
+{
+    auto request {
+        HTTPRequest::instance().prepareGet(RequestParameters {.url = HttpURL("http://localhost:44441/")}, m_shouldRun)};
+
+    request.execute(PostRequestParameters {.onSuccess = [&](const std::string& result)
+                                           { EXPECT_EQ(result, "Hello World!"); }});
+
+    auto errors {0};
+    PostRequestParameters countErrors {.onSuccess = [](const std::string& result) { FAIL() << result; },
+                                       .onError = [&](const std::string& /*result*/, const long responseCode)
+                                       {
+                                           EXPECT_EQ(responseCode, 404);
+                                           ++errors;
+                                       }};
+    auto wrongRequest {HTTPRequest::instance().prepareGet(
+        RequestParameters {.url = HttpURL("http://localhost:44441/not-found")}, m_shouldRun)};
+    wrongRequest.execute(countErrors);
+    wrongRequest.execute(countErrors);
+    EXPECT_EQ(errors, 2);
+
+    request.execute(PostRequestParameters {.onSuccess =
+                                               [&](const std::string& result)
+                                           {
+                                               EXPECT_EQ(result, "Hello World!");
+                                               m_callbackComplete = true;
+                                           }});
+    EXPECT_TRUE(m_callbackComplete);
+}
+
+/**
+ * @brief Test that a prepared request with the multi handler is interrupted through the flag it was prepared with.
+ */
+TEST_F(ComponentTestInterface, PreparedGetInterrupted)
+{
+    auto request {HTTPRequest::instance().prepareGet(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                                     m_shouldRun,
+                                                     ConfigurationParameters {.handlerType = CurlHandlerTypeEnum::MULTI})};
+
+    m_shouldRun.store(false);
+    request.execute(PostRequestParameters {.onSuccess = [&](const std::string& result) { EXPECT_TRUE(result.empty()); },
+                                           .onError = [](const std::string& /*result*/, const long /*code*/) {}});
+
+    m_shouldRun.store(true);
+    request.execute(PostRequestParameters {.onSuccess =
+                                               [&](const std::string& result)
+                                           {
+                                               EXPECT_EQ(result, "Hello World!");
+                                               m_callbackComplete = true;
+                                           }});
+    EXPECT_TRUE(m_callbackComplete);
+}
+
+/**
+ * @brief Test the GET request forcing HTTP/1.1.
+ */
+TEST_F(ComponentTestInterface, GetHelloWorldUsingHttp11)
+{
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                PostRequestParameters {.onSuccess =
+                                                           [&](const std::string& result)
+                                                       {
+                                                           EXPECT_EQ(result, "Hello World!");
+                                                           m_callbackComplete = true;
+                                                       }},
+                                ConfigurationParameters {.httpVersion = HttpVersionEnum::HTTP_1_1});
+
+    EXPECT_TRUE(m_callbackComplete);
+}
+
 /**
  * @brief Test the custom download request using the multi handler and interrupt the handler.
  */
@@ -857,6 +1431,362 @@ TEST_F(ComponentTestInterface, PutWithCustomHeaders)
     EXPECT_TRUE(m_callbackComplete);
 }
 
+/**
+ * @brief Test GET requests reusing a compiled set of headers. The headers are expected to be on the server response of
+ * each request.
+ *
+ */
+TEST_F(ComponentTestInterface, GetWithAReusedHeaderSet)
+{
+    const HeaderSet headers {"Custom-Key: Custom-Value", "Accept: text/plain"};
+
+    for (auto i = 0; i < 2; ++i)
+    {
+        m_callbackComplete = false;
+        HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/check-headers"),
+                                                       .httpHeaders = headers},
+                                    PostRequestParameters {.onSuccess = [&](const std::string& result)
+                                                           {
+                                                               const auto response = nlohmann::json::parse(result);
+
+                                                               ASSERT_EQ(response.at("Custom-Key"), "Custom-Value");
+                                                               ASSERT_EQ(response.at("Accept"), "text/plain");
+                                                               m_callbackComplete = true;
+                                                           }});
+
+        EXPECT_TRUE(m_callbackComplete);
+    }
+}
+
+/**
+ * @brief Test a GET request that takes the whole response.
+ *
+ */
+TEST_F(ComponentTestInterface, GetTakingTheResponse)
+{
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                PostRequestParameters {.onResponse = [&](Response response)
+                                                       {
+                                                           EXPECT_EQ(response.status(), 200);
+                                                           EXPECT_EQ(response.headers().value("content-type"),
+                                                                     "text/json");
+                                                           EXPECT_EQ(response.body(), "Hello World!");
+                                                           EXPECT_EQ(response.metrics().bytesReceived, 12);
+                                                           EXPECT_EQ(response.metrics().httpVersion, 11);
+                                                           m_callbackComplete = true;
+                                                       }});
+
+    EXPECT_TRUE(m_callbackComplete);
+}
+
+/**
+ * @brief Test that the response of a redirected request has the headers of the last hop.
+ *
+ */
+TEST_F(ComponentTestInterface, GetTakingTheResponseOfARedirect)
+{
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/redirect")},
+                                PostRequestParameters {.onResponse = [&](Response response)
+                                                       {
+                                                           EXPECT_EQ(response.status(), 200);
+                                                           EXPECT_FALSE(response.headers().contains("Location"));
+                                                           EXPECT_EQ(response.takeBody(), "Hello World!");
+                                                           EXPECT_EQ(response.metrics().redirectCount, 1);
+                                                           m_callbackComplete = true;
+                                                       }});
+
+    EXPECT_TRUE(m_callbackComplete);
+}
+
+/**
+ * @brief Test a POST request that takes the whole response.
+ *
+ */
+TEST_F(ComponentTestInterface, PostTakingTheResponse)
+{
+    const std::string postData {R"({"hello":"world"})"};
+
+    HTTPRequest::instance().post(RequestParameters {.url = HttpURL("http://localhost:44441/"), .data = postData},
+                                 PostRequestParameters {.onResponse = [&](Response response)
+                                                        {
+                                                            EXPECT_EQ(response.status(), 200);
+                                                            EXPECT_EQ(response.body(), postData);
+                                                            EXPECT_EQ(response.metrics().bytesSent, postData.size());
+                                                            m_callbackComplete = true;
+                                                        }});
+
+    EXPECT_TRUE(m_callbackComplete);
+}
+
+/**
+ * @brief Test that the transfer observer receives the timing breakdown of each transfer.
+ *
+ */
+TEST_F(ComponentTestInterface, TransferObserverReceivesTheMetrics)
+{
+    std::vector<std::pair<long, TransferMetrics>> transfers;
+    TransferObserver::set(
+        [&transfers](std::string_view url, const long status, const TransferMetrics& metrics)
+        {
+            EXPECT_EQ(url, "http://localhost:44441/");
+            transfers.emplace_back(status, metrics);
+        });
+
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")});
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")});
+    TransferObserver::set({});
+
+    ASSERT_EQ(transfers.size(), 2);
+    for (const auto& [status, metrics] : transfers)
+    {
+        EXPECT_EQ(status, 200);
+        EXPECT_LE(metrics.nameLookupTime, metrics.connectTime);
+        EXPECT_LE(metrics.connectTime, metrics.startTransferTime);
+        EXPECT_LE(metrics.startTransferTime, metrics.totalTime);
+        EXPECT_EQ(metrics.bytesReceived, 12);
+        EXPECT_GT(metrics.headerBytesReceived, 0);
+    }
+    EXPECT_TRUE(transfers.back().second.connectionReused);
+}
+
+/**
+ * @brief Test that the requests made after a warmup reuse the connection to the preconnected host.
+ *
+ */
+TEST_F(ComponentTestInterface, WarmupPreconnectsTheHosts)
+{
+    EXPECT_EQ(HTTPRequest::instance().warmup({"http://localhost:44441/", "http://localhost:1/"}).get(), 1);
+
+    std::vector<TransferMetrics> transfers;
+    TransferObserver::set([&transfers](std::string_view /*url*/, const long /*status*/, const TransferMetrics& metrics)
+                          { transfers.emplace_back(metrics); });
+
+    HTTPRequest::instance().get(
+        RequestParameters {.url = HttpURL("http://localhost:44441/")},
+        PostRequestParameters {.onSuccess = [&](const std::string& result)
+                               {
+                                   EXPECT_EQ(result, "Hello World!");
+                                   m_callbackComplete = true;
+                               }},
+        ConfigurationParameters {.handlerType = CurlHandlerTypeEnum::SHARED_MULTI, .shouldRun = m_shouldRun});
+    TransferObserver::set({});
+
+    EXPECT_TRUE(m_callbackComplete);
+    ASSERT_EQ(transfers.size(), 1);
+    EXPECT_TRUE(transfers.front().connectionReused);
+}
+
+/**
+ * @brief Test that a warmup whose future is dropped doesn't block the caller until it's done.
+ *
+ */
+TEST_F(ComponentTestInterface, WarmupDoesntBlockWhenItsFutureIsDropped)
+{
+    const auto start {std::chrono::steady_clock::now()};
+    HTTPRequest::instance().warmup({"http://localhost:44441/sleep/1000"});
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+}
+
+/**
+ * @brief Test that a request on the cached handler of a preconnect gets a body, after its HEAD request.
+ *
+ */
+TEST_F(ComponentTestInterface, PreconnectedHandlerGetsTheBody)
+{
+    EXPECT_EQ(HTTPRequest::instance().preconnect({"http://localhost:44441/"}, m_shouldRun), 1);
+
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                PostRequestParameters {.onSuccess = [&](const std::string& result)
+                                                       {
+                                                           EXPECT_EQ(result, "Hello World!");
+                                                           m_callbackComplete = true;
+                                                       }},
+                                ConfigurationParameters {.shouldRun = m_shouldRun});
+
+    EXPECT_TRUE(m_callbackComplete);
+}
+
+/**
+ * @brief Test that the observer of a request follows its lifecycle.
+ *
+ */
+TEST_F(ComponentTestInterface, RequestObserverFollowsTheLifecycle)
+{
+    const auto observer {std::make_shared<RecordingObserver>()};
+
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                PostRequestParameters {},
+                                ConfigurationParameters {.observer = observer});
+
+    ASSERT_GE(observer->m_events.size(), 3);
+    const auto hooks {observer->hooks()};
+    EXPECT_EQ(hooks.front(), "start");
+    EXPECT_EQ(hooks.back(), "complete");
+    EXPECT_NE(std::find(hooks.cbegin(), hooks.cend(), "firstByte"), hooks.cend());
+    EXPECT_EQ(std::find(hooks.cbegin(), hooks.cend(), "tls"), hooks.cend());
+    EXPECT_EQ(observer->m_status, 200);
+
+    const auto firstEvent {observer->m_events.front().second};
+    EXPECT_EQ(firstEvent.elapsed.count(), 0);
+    for (const auto& [hook, event] : observer->m_events)
+    {
+        EXPECT_EQ(event.id, firstEvent.id);
+        EXPECT_GE(event.elapsed, firstEvent.elapsed);
+    }
+    EXPECT_TRUE(std::is_sorted(observer->m_events.cbegin(),
+                               observer->m_events.cend(),
+                               [](const auto& a, const auto& b) { return a.second.elapsed < b.second.elapsed; }));
+}
+
+/**
+ * @brief Test that the global observer follows the requests without an observer of their own, including the failed
+ * ones.
+ *
+ */
+TEST_F(ComponentTestInterface, GlobalRequestObserverReceivesTheErrors)
+{
+    const auto globalObserver {std::make_shared<RecordingObserver>()};
+    const auto observer {std::make_shared<RecordingObserver>()};
+    IRequestObserver::setGlobal(globalObserver);
+
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/invalid_file")},
+                                PostRequestParameters {.onError = [](const std::string&, const long) {}});
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                PostRequestParameters {},
+                                ConfigurationParameters {.observer = observer});
+    IRequestObserver::setGlobal(nullptr);
+
+    const auto hooks {globalObserver->hooks()};
+    ASSERT_FALSE(hooks.empty());
+    EXPECT_EQ(hooks.front(), "start");
+    EXPECT_EQ(hooks.back(), "error");
+    EXPECT_EQ(std::count(hooks.cbegin(), hooks.cend(), "start"), 1);
+    EXPECT_EQ(globalObserver->m_status, 404);
+    EXPECT_EQ(observer->hooks().back(), "complete");
+    EXPECT_NE(observer->m_events.front().second.id, globalObserver->m_events.front().second.id);
+}
+
+/**
+ * @brief Test that the requests are recorded in the request metrics.
+ *
+ */
+TEST_F(ComponentTestInterface, RequestMetricsRecordTheRequests)
+{
+    RequestMetrics::reset();
+
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")});
+    HTTPRequest::instance().post(
+        RequestParameters {.url = HttpURL("http://localhost:44441/"), .data = R"({"hello":"world"})"_json});
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/invalid_file")},
+                                PostRequestParameters {.onError = [](const std::string&, const long) {}});
+
+    const auto metrics = RequestMetrics::json();
+    const auto& requests {metrics.at("requests")};
+    EXPECT_EQ(requests.at("total"), 3);
+    EXPECT_EQ(requests.at("in_flight"), 0);
+    EXPECT_EQ(requests.at("by_label"),
+              R"([{"method":"GET","status":200,"host":"localhost","count":1},
+                  {"method":"GET","status":404,"host":"localhost","count":1},
+                  {"method":"POST","status":200,"host":"localhost","count":1}])"_json);
+    EXPECT_EQ(metrics.at("bytes").at("sent"), 17);
+    EXPECT_EQ(metrics.at("latency_us").at("count"), 3);
+    EXPECT_GE(metrics.at("handler_cache").at("hits").get<uint64_t>() +
+                  metrics.at("handler_cache").at("misses").get<uint64_t>(),
+              3);
+}
+
+/**
+ * @brief Test that the trace holds the spans of a request: the handler cache lookup, the transfer and its phases,
+ * and the callback.
+ *
+ */
+TEST_F(ComponentTestInterface, RequestTraceRecordsTheSpans)
+{
+    RequestTrace::enable();
+    RequestTrace::clear();
+    HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/")},
+                                PostRequestParameters {.onSuccess = [](const std::string&) {}});
+    RequestTrace::disable();
+
+    const auto trace = RequestTrace::json();
+    RequestTrace::clear();
+
+    std::map<std::string, nlohmann::json> spans;
+    for (const auto& event : trace.at("traceEvents"))
+    {
+        EXPECT_EQ(event.at("ph"), "X");
+        spans.emplace(event.at("cat").get<std::string>() + "/" + event.at("name").get<std::string>(), event);
+    }
+
+    ASSERT_TRUE(spans.count("transfer/GET"));
+    const auto& transfer {spans.at("transfer/GET")};
+    EXPECT_EQ(transfer.at("args").at("url"), "http://localhost:44441/");
+    EXPECT_EQ(transfer.at("args").at("status"), 200);
+    EXPECT_TRUE(spans.count("phase/receive") || spans.count("phase/wait"));
+    EXPECT_TRUE(spans.count("handler cache/handler cache lookup"));
+    EXPECT_TRUE(spans.count("callback/callback"));
+    EXPECT_GE(spans.at("callback/callback").at("ts"),
+              transfer.at("ts").get<int64_t>() + transfer.at("dur").get<int64_t>());
+}
+
+/**
+ * @brief Test that a request interrupted with the multi handler is listed as in flight until it's interrupted.
+ *
+ */
+TEST_F(ComponentTestInterface, InFlightRequestsListTheStuckRequests)
+{
+    InFlightRequests::enable();
+    std::thread thread(
+        [&]()
+        {
+            HTTPRequest::instance().get(
+                RequestParameters {.url = HttpURL("http://localhost:44441/sleep/1000")},
+                PostRequestParameters {.onError = [](const std::string&, const long) {}},
+                ConfigurationParameters {.handlerType = CurlHandlerTypeEnum::MULTI, .shouldRun = m_shouldRun});
+        });
+
+    nlohmann::json requests;
+    for (auto i {0}; i < 500 && requests.empty(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        requests = InFlightRequests::json().at("requests");
+    }
+    m_shouldRun.store(false);
+    thread.join();
+
+    InFlightRequests::disable();
+
+    ASSERT_EQ(requests.size(), 1);
+    EXPECT_EQ(requests.at(0).at("method"), "GET");
+    EXPECT_EQ(requests.at(0).at("handler"), "multi");
+    EXPECT_EQ(requests.at(0).at("bytes_received"), 0);
+    EXPECT_TRUE(InFlightRequests::json().at("requests").empty());
+}
+
+/**
+ * @brief Test that the requests aren't listed as in flight unless the tracking is enabled.
+ *
+ */
+TEST_F(ComponentTestInterface, InFlightRequestsNotTrackedByDefault)
+{
+    std::atomic<bool> started {false};
+    std::thread thread(
+        [&]()
+        {
+            started.store(true);
+            HTTPRequest::instance().get(RequestParameters {.url = HttpURL("http://localhost:44441/sleep/100")});
+        });
+
+    while (!started.load())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_TRUE(InFlightRequests::json().at("requests").empty());
+    thread.join();
+}
+
 /**
  * @brief Test the basic functionality of a PATCH request.
  *
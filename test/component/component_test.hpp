@@ -14,6 +14,8 @@
 
 #include "IURLRequest.hpp"
 #include "curlHandlerCache.hpp"
+#include "permanentRedirectCache.hpp"
+#include "sharedResponseCache.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include <algorithm>
@@ -24,6 +26,10 @@
 
 auto constexpr TEST_FILE_1 {"test1.txt"};
 auto constexpr TEST_FILE_2 {"test2.txt"};
+auto constexpr TEST_SHARED_CACHE_FILE {"/tmp/urlrequest_component_shared_cache"};
+auto constexpr TEST_DOWNLOAD_STORE_DIR {"/tmp/urlrequest_component_download_store"};
+auto constexpr TEST_REDIRECT_CACHE_FILE {"/tmp/urlrequest_component_redirect_cache.json"};
+auto constexpr TEST_HSTS_CACHE_FILE {"/tmp/urlrequest_component_hsts_cache.txt"};
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wformat-nonliteral"
@@ -42,6 +48,8 @@ class FakeServer final
 private:
     httplib::Server m_server;
     std::thread m_thread;
+    std::atomic<int> m_counter {0};
+    std::atomic<int> m_redirectCounter {0};
 
 public:
     FakeServer()
@@ -81,14 +89,51 @@ public:
                      [](const httplib::Request& /*req*/, httplib::Response& res)
                      { res.set_content("Hello World!", "text/json"); });
 
+        // Every request to this endpoint returns a different value.
+        m_server.Get("/counter",
+                     [this](const httplib::Request& /*req*/, httplib::Response& res)
+                     { res.set_content(std::to_string(++m_counter), "text/json"); });
+
         m_server.Get("/redirect",
                      [](const httplib::Request& /*req*/, httplib::Response& res)
                      { res.set_redirect("http://localhost:44441/", 301); });
 
+        // Counts the requests that go through the permanent redirect.
+        m_server.Get("/permanent-redirect",
+                     [this](const httplib::Request& /*req*/, httplib::Response& res)
+                     {
+                         ++m_redirectCounter;
+                         res.set_redirect("/redirect-counter", 308);
+                     });
+
+        // Permanent redirect to another host name of the server.
+        m_server.Get("/cross-host-redirect",
+                     [](const httplib::Request& /*req*/, httplib::Response& res)
+                     { res.set_redirect("http://127.0.0.1:44441/check-headers", 308); });
+
+        m_server.Get("/redirect-counter",
+                     [this](const httplib::Request& /*req*/, httplib::Response& res)
+                     { res.set_content(std::to_string(m_redirectCounter), "text/json"); });
+
+        m_server.Get("/server-error",
+                     [](const httplib::Request& /*req*/, httplib::Response& res) { res.status = 500; });
+
         m_server.Get("/check-headers",
                      [&getHttpHeaders](const httplib::Request& req, httplib::Response& res)
                      { res.set_content(getHttpHeaders(req).dump(), "text/json"); });
 
+        // Returns the decoded query parameters.
+        m_server.Get("/check-query",
+                     [](const httplib::Request& req, httplib::Response& res)
+                     {
+                         nlohmann::json params;
+                         for (const auto& [key, value] : req.params)
+                         {
+                             params[key] = value;
+                         }
+                         res.set_content(params.dump(), "text/json");
+                     });
+
         m_server.Post(
             "/", [](const httplib::Request& req, httplib::Response& res) { res.set_content(req.body, "text/json"); });
 
@@ -179,7 +224,14 @@ protected:
         m_shouldRun.store(false);
         std::filesystem::remove(TEST_FILE_1);
         std::filesystem::remove(TEST_FILE_2);
+        std::filesystem::remove(TEST_SHARED_CACHE_FILE);
+        std::filesystem::remove_all(TEST_DOWNLOAD_STORE_DIR);
+        std::filesystem::remove(TEST_REDIRECT_CACHE_FILE);
+        SharedResponseCacheRegistry::instance().clear();
+        PermanentRedirectCacheRegistry::instance().clear();
         cURLHandlerCache::instance().clear();
+        // Removed after the handles, which write it back when cleaned up.
+        std::filesystem::remove(TEST_HSTS_CACHE_FILE);
     }
 
     /**
@@ -0,0 +1,256 @@
+/*
+ * Wazuh urlRequest test component
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "HTTPRequest.hpp"
+#include "IRequestImplementator.hpp"
+#include "allocationCounter.hpp"
+#include "curlException.hpp"
+#include "curlWrapper.hpp"
+#include "customDeleter.hpp"
+#include "factoryRequestImplemetator.hpp"
+#include "urlRequest.hpp"
+#include <benchmark/benchmark.h>
+#include <curl/curl.h>
+#include <memory>
+#include <string>
+
+namespace
+{
+/**
+ * @brief Request implementator that performs the requests in process, without a transport, so the benchmarks only
+ * measure the library. It keeps the headers in a curl list, as cURLWrapper does, and responds with a fixed body. Like
+ * cURLWrapper, it's final, so the requests built over it don't make virtual calls.
+ */
+class StubRequestImplementator final : public IRequestImplementator
+{
+private:
+    using deleterSlist = CustomDeleter<decltype(&curl_slist_free_all), curl_slist_free_all>;
+
+    std::unique_ptr<curl_slist, deleterSlist> m_headers;
+    HeaderSet m_headerSet;
+    std::shared_ptr<IRequestObserver> m_observer;
+    size_t m_options {0};
+    bool m_fail {false};
+
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param fail Whether the requests fail, to measure the error path.
+     */
+    explicit StubRequestImplementator(const bool fail = false)
+        : m_fail {fail}
+    {
+    }
+
+    void setOption(const OPTION_REQUEST_TYPE /*optIndex*/, void* /*ptr*/) override
+    {
+        ++m_options;
+    }
+
+    void setOption(const OPTION_REQUEST_TYPE /*optIndex*/, const std::string& opt) override
+    {
+        benchmark::DoNotOptimize(opt.data());
+        ++m_options;
+    }
+
+    void setOption(const OPTION_REQUEST_TYPE /*optIndex*/, const long /*opt*/) override
+    {
+        ++m_options;
+    }
+
+    void execute() override
+    {
+        benchmark::DoNotOptimize(m_options);
+        if (m_fail)
+        {
+            throw Curl::CurlException("Couldn't connect to server", 0);
+        }
+    }
+
+    const std::string response() override
+    {
+        return R"({"hello":"world"})";
+    }
+
+    Response takeResponse() override
+    {
+        return {200, ResponseHeaders {}, response(), TransferMetrics {}};
+    }
+
+    void appendHeader(const std::string& header) override
+    {
+        if (!m_headers)
+        {
+            m_headers.reset(curl_slist_append(nullptr, header.c_str()));
+        }
+        else
+        {
+            curl_slist_append(m_headers.get(), header.c_str());
+        }
+    }
+
+    void setHeaders(const HeaderSet& headers) override
+    {
+        m_headerSet = headers;
+    }
+
+    const std::string permanentRedirect() override
+    {
+        return {};
+    }
+
+    void setObserver(std::shared_ptr<IRequestObserver> observer) override
+    {
+        m_observer = std::move(observer);
+    }
+};
+} // namespace
+
+/**
+ * @brief This function is a benchmark test for creating a request over a new wrapper, and a request builder over it.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_CreateRequest(benchmark::State& state)
+{
+    const AllocationCounter allocationCounter {state};
+    for (auto _ : state)
+    {
+        auto request {GetRequest::builder(FactoryRequestWrapper<cURLWrapper>::create())};
+        benchmark::DoNotOptimize(request);
+    }
+}
+BENCHMARK(BM_CreateRequest);
+
+/**
+ * @brief This function is a benchmark test for taking a request from the wrapper pool of the thread, as HTTPRequest
+ * does, and a request builder over it.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_AcquireRequest(benchmark::State& state)
+{
+    const AllocationCounter allocationCounter {state};
+    for (auto _ : state)
+    {
+        auto request {BasicGetRequest<cURLWrapper>::builder(FactoryRequestWrapper<cURLWrapper>::acquire())};
+        benchmark::DoNotOptimize(request);
+    }
+}
+BENCHMARK(BM_AcquireRequest);
+
+/**
+ * @brief This function is a benchmark test for the builder chain of a GET request, as built by HTTPRequest::get().
+ *
+ * @param state Benchmark state.
+ */
+static void BM_GetBuilderChain(benchmark::State& state)
+{
+    const HttpURL url {"http://localhost:44441/"};
+    const SecureCommunication secureCommunication;
+    const std::string userAgent {"urlrequest-benchmark"};
+    const ConfigurationParameters configurationParameters {.timeout = 1000, .userAgent = userAgent};
+    const AllocationCounter allocationCounter {state};
+    for (auto _ : state)
+    {
+        auto request {BasicGetRequest<StubRequestImplementator>::builder(std::make_shared<StubRequestImplementator>())};
+        request.url(url, secureCommunication)
+            .headers(HeaderSet::defaults())
+            .configuration(configurationParameters)
+            .outputFile({})
+            .execute();
+        benchmark::DoNotOptimize(request.response());
+    }
+}
+BENCHMARK(BM_GetBuilderChain);
+
+/**
+ * @brief This function is a benchmark test for the builder chain of a POST request, as built by HTTPRequest::post().
+ *
+ * @param state Benchmark state.
+ */
+static void BM_PostBuilderChain(benchmark::State& state)
+{
+    const HttpURL url {"http://localhost:44441/"};
+    const SecureCommunication secureCommunication;
+    const std::string data {R"({"foo": "bar"})"};
+    const std::string userAgent {"urlrequest-benchmark"};
+    const ConfigurationParameters configurationParameters {.timeout = 1000, .userAgent = userAgent};
+    const AllocationCounter allocationCounter {state};
+    for (auto _ : state)
+    {
+        auto request {
+            BasicPostRequest<StubRequestImplementator>::builder(std::make_shared<StubRequestImplementator>())};
+        request.url(url, secureCommunication)
+            .postData(data)
+            .headers(HeaderSet::defaults())
+            .configuration(configurationParameters)
+            .outputFile({})
+            .execute();
+        benchmark::DoNotOptimize(request.response());
+    }
+}
+BENCHMARK(BM_PostBuilderChain);
+
+/**
+ * @brief This function is a benchmark test for the secure communication lookups of an HTTPS request. With the argument
+ * set, the CA certificate isn't given and the default paths are probed for it.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_SecureCommunicationLookup(benchmark::State& state)
+{
+    const HttpURL url {"https://localhost:44441/"};
+    const auto secureCommunication {
+        state.range(0) == 0 ? SecureCommunication::builder().caRootCertificate("/etc/ssl/certs/ca-certificates.crt")
+                            : SecureCommunication::builder()};
+    const AllocationCounter allocationCounter {state};
+    for (auto _ : state)
+    {
+        BasicGetRequest<StubRequestImplementator>::builder(std::make_shared<StubRequestImplementator>())
+            .url(url, secureCommunication);
+    }
+}
+BENCHMARK(BM_SecureCommunicationLookup)->Arg(0)->Arg(1);
+
+/**
+ * @brief This function is a benchmark test for a failed request, from the exception thrown by the implementator to
+ * the error callback, as HTTPRequest::get() reports it.
+ *
+ * @param state Benchmark state.
+ */
+static void BM_ExceptionPath(benchmark::State& state)
+{
+    const HttpURL url {"http://localhost:44441/"};
+    const auto onError {[](const std::string& error, const long statusCode)
+                        {
+                            benchmark::DoNotOptimize(error.data());
+                            benchmark::DoNotOptimize(statusCode);
+                        }};
+    const AllocationCounter allocationCounter {state};
+    for (auto _ : state)
+    {
+        try
+        {
+            BasicGetRequest<StubRequestImplementator>::builder(std::make_shared<StubRequestImplementator>(true))
+                .url(url)
+                .execute();
+        }
+        catch (const Curl::CurlException& ex)
+        {
+            onError(ex.what(), ex.responseCode());
+        }
+    }
+}
+BENCHMARK(BM_ExceptionPath);
+
+BENCHMARK_MAIN();
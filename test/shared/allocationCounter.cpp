@@ -0,0 +1,38 @@
+/*
+ * Wazuh urlRequest test component
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "allocationCounter.hpp"
+#include <cstdlib>
+#include <new>
+
+thread_local size_t t_allocations {0};
+thread_local size_t t_allocatedBytes {0};
+
+void* operator new(std::size_t size)
+{
+    ++t_allocations;
+    t_allocatedBytes += size;
+    if (const auto ptr {std::malloc(size == 0 ? 1 : size)}; ptr != nullptr)
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept
+{
+    std::free(ptr);
+}
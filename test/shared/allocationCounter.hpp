@@ -0,0 +1,53 @@
+/*
+ * Wazuh urlRequest test component
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _ALLOCATION_COUNTER_HPP
+#define _ALLOCATION_COUNTER_HPP
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+
+extern thread_local size_t t_allocations;    ///< Heap allocations made by the thread through operator new.
+extern thread_local size_t t_allocatedBytes; ///< Bytes of the heap allocations made by the thread.
+
+/**
+ * @brief Reports the heap allocations made through operator new per iteration of a benchmark, as the 'allocations'
+ * and 'allocated_bytes' counters. The allocations are counted by the operator new of allocationCounter.cpp, which
+ * replaces the global one in the benchmarks linked with it.
+ */
+class AllocationCounter final
+{
+private:
+    benchmark::State& m_state;
+    const size_t m_allocations;
+    const size_t m_allocatedBytes;
+
+public:
+    explicit AllocationCounter(benchmark::State& state)
+        : m_state {state}
+        , m_allocations {t_allocations}
+        , m_allocatedBytes {t_allocatedBytes}
+    {
+    }
+
+    ~AllocationCounter()
+    {
+        m_state.counters["allocations"] = benchmark::Counter(static_cast<double>(t_allocations - m_allocations),
+                                                             benchmark::Counter::kAvgIterations);
+        m_state.counters["allocated_bytes"] = benchmark::Counter(
+            static_cast<double>(t_allocatedBytes - m_allocatedBytes), benchmark::Counter::kAvgIterations);
+    }
+
+    AllocationCounter(const AllocationCounter&) = delete;
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+};
+
+#endif // _ALLOCATION_COUNTER_HPP
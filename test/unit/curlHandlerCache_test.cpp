@@ -11,9 +11,14 @@
 #include "curlHandlerCache_test.hpp"
 #include "curlHandlerCache.hpp"
 #include "curlMultiHandler.hpp"
+#include "curlSharedMultiHandler.hpp"
 #include "curlSingleHandler.hpp"
 #include "curlWrapper.hpp"
+#include "factoryRequestImplemetator.hpp"
+#include "requestMetricsRegistry.hpp"
+#include <filesystem>
 #include <memory>
+#include <thread>
 
 /*
  * @brief Test the creation of the Single handler.
@@ -35,6 +40,82 @@ TEST_F(cURLHandlerCacheTest, MultiHandlerCreation)
         cURLHandlerCache::instance().getCurlHandler(CurlHandlerTypeEnum::MULTI)));
 }
 
+/*
+ * @brief Test the creation of the shared multi handler.
+ */
+TEST_F(cURLHandlerCacheTest, SharedMultiHandlerCreation)
+{
+    // Create the cURL handler and check that it is a shared multi handler.
+    EXPECT_TRUE(std::dynamic_pointer_cast<cURLSharedMultiHandler>(
+        cURLHandlerCache::instance().getCurlHandler(CurlHandlerTypeEnum::SHARED_MULTI)));
+}
+
+/*
+ * @brief Test that the handlers created for requests that own their handle aren't cached.
+ */
+TEST_F(cURLHandlerCacheTest, HandlerCreationWithoutCache)
+{
+    const std::atomic<bool> shouldRun {true};
+    EXPECT_TRUE(std::dynamic_pointer_cast<cURLSingleHandler>(
+        cURLHandlerCache::createCurlHandler(CurlHandlerTypeEnum::SINGLE, shouldRun)));
+    EXPECT_TRUE(std::dynamic_pointer_cast<cURLMultiHandler>(
+        cURLHandlerCache::createCurlHandler(CurlHandlerTypeEnum::MULTI, shouldRun)));
+    EXPECT_EQ(cURLHandlerCache::instance().size(), 0);
+}
+
+/*
+ * @brief Test that the handles alive are counted until their handlers, cached or not, are released.
+ */
+TEST_F(cURLHandlerCacheTest, LiveHandlesAreCounted)
+{
+    const std::atomic<bool> shouldRun {true};
+    const auto liveHandles {[]() { return RequestMetricsRegistry::instance().snapshot().m_liveHandles; }};
+    const auto initialHandles {liveHandles()};
+    {
+        const auto single {cURLHandlerCache::createCurlHandler(CurlHandlerTypeEnum::SINGLE, shouldRun)};
+        const auto multi {cURLHandlerCache::createCurlHandler(CurlHandlerTypeEnum::MULTI, shouldRun)};
+        const auto sharedMulti {cURLHandlerCache::createCurlHandler(CurlHandlerTypeEnum::SHARED_MULTI, shouldRun)};
+        cURLHandlerCache::instance().getCurlHandler(CurlHandlerTypeEnum::SINGLE);
+        EXPECT_EQ(liveHandles(), initialHandles + 4);
+    }
+    EXPECT_EQ(liveHandles(), initialHandles + 1);
+
+    cURLHandlerCache::instance().clear();
+    EXPECT_EQ(liveHandles(), initialHandles);
+}
+
+/*
+ * @brief Test that the options of a handle are kept after a transfer when requested.
+ */
+TEST_F(cURLHandlerCacheTest, KeepOptionsAfterExecution)
+{
+    const std::atomic<bool> shouldRun {true};
+    const auto handler {cURLHandlerCache::createCurlHandler(CurlHandlerTypeEnum::SINGLE, shouldRun)};
+    curl_easy_setopt(handler->getHandler().get(), CURLOPT_URL, "http://127.0.0.1:1/");
+
+    const auto executionError {[&handler]() -> std::string
+                               {
+                                   try
+                                   {
+                                       handler->execute();
+                                   }
+                                   catch (const std::runtime_error& e)
+                                   {
+                                       return e.what();
+                                   }
+                                   return {};
+                               }};
+
+    // Once the options are reset, the transfer fails because the URL is missing.
+    handler->keepOptions(true);
+    EXPECT_EQ(executionError(), curl_easy_strerror(CURLE_COULDNT_CONNECT));
+    EXPECT_EQ(executionError(), curl_easy_strerror(CURLE_COULDNT_CONNECT));
+
+    handler->keepOptions(false);
+    EXPECT_EQ(executionError(), curl_easy_strerror(CURLE_COULDNT_CONNECT));
+    EXPECT_EQ(executionError(), curl_easy_strerror(CURLE_URL_MALFORMAT));
+}
+
 /**
  * @brief This test checks the behavior of the single-handler in multiple threads
  */
@@ -137,3 +218,101 @@ TEST_F(cURLHandlerCacheTest, TwoMultiHandlerInTheSameThread)
 
     EXPECT_NO_THROW(thread1.join());
 }
+
+/**
+ * @brief This test checks that the wrappers of the pool are only reused once the requests that use them are destroyed.
+ */
+TEST_F(cURLHandlerCacheTest, WrapperPoolReusesFreeWrappers)
+{
+    std::thread thread1(
+        []()
+        {
+            auto first {FactoryRequestWrapper<cURLWrapper>::acquire()};
+            const auto firstPointer {first.get()};
+
+            // The first wrapper is in use, so another one is created over the same handler.
+            const auto second {FactoryRequestWrapper<cURLWrapper>::acquire()};
+            EXPECT_NE(second.get(), firstPointer);
+            EXPECT_EQ(second->curlHandler(), first->curlHandler());
+
+            first.reset();
+            EXPECT_EQ(FactoryRequestWrapper<cURLWrapper>::acquire().get(), firstPointer);
+        });
+
+    EXPECT_NO_THROW(thread1.join());
+}
+
+/**
+ * @brief This test checks that the wrappers of the pool aren't reused over a handler that was evicted from the cache.
+ */
+TEST_F(cURLHandlerCacheTest, WrapperPoolDoesntReuseEvictedHandlers)
+{
+    std::thread thread1(
+        []()
+        {
+            const auto evictedHandler {FactoryRequestWrapper<cURLWrapper>::acquire()->curlHandler()};
+            cURLHandlerCache::instance().clear();
+
+            const auto wrapper {FactoryRequestWrapper<cURLWrapper>::acquire()};
+            EXPECT_NE(wrapper->curlHandler(), evictedHandler);
+            EXPECT_EQ(wrapper->curlHandler(), cURLHandlerCache::instance().getCurlHandler(CurlHandlerTypeEnum::SINGLE));
+        });
+
+    EXPECT_NO_THROW(thread1.join());
+}
+
+/**
+ * @brief This test checks that the free wrappers of the pool don't keep a handler evicted from the cache alive.
+ */
+TEST_F(cURLHandlerCacheTest, WrapperPoolReleasesEvictedHandlers)
+{
+    std::thread thread1(
+        []()
+        {
+            std::weak_ptr<ICURLHandler> evictedHandler;
+            {
+                const auto wrapper {FactoryRequestWrapper<cURLWrapper>::acquire()};
+                evictedHandler = wrapper->curlHandler();
+            }
+            cURLHandlerCache::instance().clear();
+
+            EXPECT_TRUE(evictedHandler.expired());
+        });
+
+    EXPECT_NO_THROW(thread1.join());
+}
+
+/**
+ * @brief This test checks that a handler with an HSTS cache loaded is only given to the requests that use the same
+ * cache file.
+ */
+TEST_F(cURLHandlerCacheTest, HandlerWithCacheFilesOnlyReusedForTheSameFiles)
+{
+    const std::string hstsCachePath {"/tmp/curlHandlerCache_test_hsts.txt"};
+    std::thread thread1(
+        [&hstsCachePath]()
+        {
+            const std::atomic<bool> shouldRun {true};
+            auto& cache {cURLHandlerCache::instance()};
+            const auto withCache {
+                FactoryRequestWrapper<cURLWrapper>::acquire(CurlHandlerTypeEnum::SINGLE, shouldRun, hstsCachePath)};
+            withCache->setOption(OPT_HSTS, hstsCachePath);
+            EXPECT_TRUE(withCache->curlHandler()->usesCacheFiles(hstsCachePath, {}));
+
+            // The requests that don't use the same files get another handler.
+            const auto plain {cache.getCurlHandler(CurlHandlerTypeEnum::SINGLE, shouldRun)};
+            EXPECT_NE(plain, withCache->curlHandler());
+            EXPECT_TRUE(plain->usesCacheFiles({}, {}));
+            EXPECT_NE(cache.getCurlHandler(CurlHandlerTypeEnum::SINGLE, shouldRun, {}, hstsCachePath),
+                      withCache->curlHandler());
+
+            EXPECT_EQ(cache.getCurlHandler(CurlHandlerTypeEnum::SINGLE, shouldRun, hstsCachePath),
+                      withCache->curlHandler());
+        });
+
+    EXPECT_NO_THROW(thread1.join());
+
+    // The handles write the cache back to the file when they're cleaned up.
+    cURLHandlerCache::instance().clear();
+    std::filesystem::remove(hstsCachePath);
+}
@@ -0,0 +1,192 @@
+/*
+ * Wazuh DeltaPatcher unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "deltaPatcher_test.hpp"
+#include "deltaPatcher.hpp"
+#include <fstream>
+#include <string>
+
+namespace
+{
+// SHA-256 of "Hello World!".
+auto constexpr HELLO_WORLD_DIGEST {"7f83b1657ff1fc53b92dc18148a1d65dfc2d4b1fa3d677284addd200126d9069"};
+
+void writeFile(const std::string& path, const std::string& content)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+std::string readFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+/**
+ * @brief Builds the same patch as 'zstd --patch-from=<base>'.
+ */
+std::string makePatch(const std::string& base, const std::string& target)
+{
+    std::unique_ptr<ZSTD_CCtx, CustomDeleter<decltype(&ZSTD_freeCCtx), ZSTD_freeCCtx>> context {ZSTD_createCCtx()};
+    ZSTD_CCtx_setParameter(context.get(), ZSTD_c_windowLog, 27);
+    ZSTD_CCtx_refPrefix(context.get(), base.data(), base.size());
+
+    std::string patch(ZSTD_compressBound(target.size()), '\0');
+    const auto size {ZSTD_compress2(context.get(), patch.data(), patch.size(), target.data(), target.size())};
+    patch.resize(ZSTD_isError(size) ? 0 : size);
+    return patch;
+}
+
+std::string makeContent(const size_t lines, const std::string& marker)
+{
+    std::string content;
+    for (size_t i = 0; i < lines; ++i)
+    {
+        content += "line " + std::to_string(i) + (i % 1000 == 0 ? marker : "") + "\n";
+    }
+    return content;
+}
+} // namespace
+
+/**
+ * @brief Test the digest of a file.
+ */
+TEST_F(DeltaPatcherTest, FileDigest)
+{
+    writeFile(DELTA_PATCHER_TEST_BASE, "Hello World!");
+
+    EXPECT_EQ(Sha256Hasher::fileDigest(DELTA_PATCHER_TEST_BASE), HELLO_WORLD_DIGEST);
+}
+
+/**
+ * @brief Test that the digests are compared ignoring the case.
+ */
+TEST_F(DeltaPatcherTest, DigestComparison)
+{
+    EXPECT_TRUE(Sha256Hasher::equal("7F83B1", "7f83b1"));
+    EXPECT_FALSE(Sha256Hasher::equal("7f83b1", "7f83b2"));
+    EXPECT_FALSE(Sha256Hasher::equal("7f83b1", "7f83b"));
+}
+
+/**
+ * @brief Test the URL where the patch for a given local copy is published.
+ */
+TEST_F(DeltaPatcherTest, PatchUrl)
+{
+    EXPECT_EQ(DeltaPatcher::patchUrl("http://localhost/file.db", "abc"), "http://localhost/file.db.abc.patch.zst");
+}
+
+/**
+ * @brief Test that a patch rebuilds the new version and returns its digest.
+ */
+TEST_F(DeltaPatcherTest, ApplyPatch)
+{
+    const auto base {makeContent(100000, " v1")};
+    const auto target {makeContent(100000, " v2")};
+    const auto patch {makePatch(base, target)};
+    ASSERT_FALSE(patch.empty());
+    // Only the changes are transferred.
+    EXPECT_LT(patch.size(), target.size() / 10);
+
+    writeFile(DELTA_PATCHER_TEST_BASE, base);
+    writeFile(DELTA_PATCHER_TEST_PATCH, patch);
+    writeFile(DELTA_PATCHER_TEST_OUTPUT, target);
+    const auto expectedDigest {Sha256Hasher::fileDigest(DELTA_PATCHER_TEST_OUTPUT)};
+
+    std::string digest;
+    EXPECT_NO_THROW(digest = DeltaPatcher::apply(DELTA_PATCHER_TEST_BASE, DELTA_PATCHER_TEST_PATCH,
+                                                 DELTA_PATCHER_TEST_OUTPUT));
+    EXPECT_EQ(digest, expectedDigest);
+    EXPECT_EQ(readFile(DELTA_PATCHER_TEST_OUTPUT), target);
+}
+
+/**
+ * @brief Test that a patch created from another base file is rejected.
+ */
+TEST_F(DeltaPatcherTest, ApplyPatchWrongBase)
+{
+    const auto base {makeContent(100000, " v1")};
+    const auto target {makeContent(100000, " v2")};
+    writeFile(DELTA_PATCHER_TEST_BASE, std::string(base.rbegin(), base.rend()));
+    writeFile(DELTA_PATCHER_TEST_PATCH, makePatch(base, target));
+
+    Sha256Hasher hasher;
+    hasher.update(target.data(), target.size());
+    const auto targetDigest {hasher.hexDigest()};
+
+    std::string digest;
+    try
+    {
+        digest = DeltaPatcher::apply(DELTA_PATCHER_TEST_BASE, DELTA_PATCHER_TEST_PATCH, DELTA_PATCHER_TEST_OUTPUT);
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+    // Either the decoder detects it or the digest doesn't match the new version.
+    EXPECT_FALSE(Sha256Hasher::equal(digest, targetDigest));
+}
+
+/**
+ * @brief Test that a truncated patch is rejected.
+ */
+TEST_F(DeltaPatcherTest, ApplyTruncatedPatch)
+{
+    const auto base {makeContent(100000, " v1")};
+    const auto patch {makePatch(base, makeContent(100000, " v2"))};
+    writeFile(DELTA_PATCHER_TEST_BASE, base);
+    writeFile(DELTA_PATCHER_TEST_PATCH, patch.substr(0, patch.size() / 2));
+
+    EXPECT_THROW(DeltaPatcher::apply(DELTA_PATCHER_TEST_BASE, DELTA_PATCHER_TEST_PATCH, DELTA_PATCHER_TEST_OUTPUT),
+                 std::runtime_error);
+}
+
+/**
+ * @brief Test that a file that isn't a patch is rejected.
+ */
+TEST_F(DeltaPatcherTest, ApplyInvalidPatch)
+{
+    writeFile(DELTA_PATCHER_TEST_BASE, "Hello World!");
+    writeFile(DELTA_PATCHER_TEST_PATCH, "Not a patch");
+
+    EXPECT_THROW(DeltaPatcher::apply(DELTA_PATCHER_TEST_BASE, DELTA_PATCHER_TEST_PATCH, DELTA_PATCHER_TEST_OUTPUT),
+                 std::runtime_error);
+}
+
+/**
+ * @brief Test that a patch that needs a window bigger than the limit is rejected before the decoder allocates it.
+ */
+TEST_F(DeltaPatcherTest, ApplyPatchWindowTooBig)
+{
+    const auto base {makeContent(100000, " v1")};
+    writeFile(DELTA_PATCHER_TEST_BASE, base);
+    writeFile(DELTA_PATCHER_TEST_PATCH, makePatch(base, makeContent(100000, " v2")));
+
+    // The patch references the whole base file, about 1 MiB.
+    EXPECT_THROW(DeltaPatcher::apply(DELTA_PATCHER_TEST_BASE, DELTA_PATCHER_TEST_PATCH, DELTA_PATCHER_TEST_OUTPUT, 16),
+                 std::runtime_error);
+}
+
+/**
+ * @brief Test that a missing patch is remembered only for the version it should produce.
+ */
+TEST_F(DeltaPatcherTest, MissingPatches)
+{
+    MissingPatches::instance().clear();
+    MissingPatches::instance().insert("http://localhost/file.db.abc.patch.zst", "v2");
+
+    EXPECT_TRUE(MissingPatches::instance().contains("http://localhost/file.db.abc.patch.zst", "v2"));
+    EXPECT_FALSE(MissingPatches::instance().contains("http://localhost/file.db.abc.patch.zst", "v3"));
+    EXPECT_FALSE(MissingPatches::instance().contains("http://localhost/file.db.def.patch.zst", "v2"));
+
+    MissingPatches::instance().clear();
+    EXPECT_FALSE(MissingPatches::instance().contains("http://localhost/file.db.abc.patch.zst", "v2"));
+}
@@ -0,0 +1,43 @@
+/*
+ * Wazuh DeltaPatcher unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _DELTA_PATCHER_TEST_HPP
+#define _DELTA_PATCHER_TEST_HPP
+
+#include "gtest/gtest.h"
+#include <filesystem>
+
+auto constexpr DELTA_PATCHER_TEST_BASE {"/tmp/urlrequest_delta_patcher_test_base.txt"};
+auto constexpr DELTA_PATCHER_TEST_PATCH {"/tmp/urlrequest_delta_patcher_test.patch.zst"};
+auto constexpr DELTA_PATCHER_TEST_OUTPUT {"/tmp/urlrequest_delta_patcher_test_output.txt"};
+
+/**
+ * @brief Runs unit tests for DeltaPatcher and Sha256Hasher classes
+ */
+class DeltaPatcherTest : public ::testing::Test
+{
+protected:
+    DeltaPatcherTest() = default;
+    ~DeltaPatcherTest() override = default;
+
+    /**
+     * @brief Cleans the test environment
+     *
+     */
+    void TearDown() override
+    {
+        std::filesystem::remove(DELTA_PATCHER_TEST_BASE);
+        std::filesystem::remove(DELTA_PATCHER_TEST_PATCH);
+        std::filesystem::remove(DELTA_PATCHER_TEST_OUTPUT);
+    }
+};
+
+#endif // _DELTA_PATCHER_TEST_HPP
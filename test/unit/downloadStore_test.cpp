@@ -0,0 +1,145 @@
+/*
+ * Wazuh DownloadStore unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "downloadStore_test.hpp"
+#include "downloadStore.hpp"
+#include <chrono>
+#include <fstream>
+#include <string>
+
+namespace
+{
+void writeFile(const std::string& path, const std::string& content)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+std::string readFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+} // namespace
+
+/**
+ * @brief Test that nothing is served before the content is stored.
+ */
+TEST_F(DownloadStoreTest, FetchMiss)
+{
+    DownloadStore store(DOWNLOAD_STORE_TEST_DIR, 1024);
+
+    EXPECT_FALSE(store.fetch("http://localhost/file", "v1", DOWNLOAD_STORE_TEST_OUTPUT_1));
+    EXPECT_FALSE(std::filesystem::exists(DOWNLOAD_STORE_TEST_OUTPUT_1));
+}
+
+/**
+ * @brief Test that a stored download is cloned into another output file.
+ */
+TEST_F(DownloadStoreTest, StoreAndFetch)
+{
+    DownloadStore store(DOWNLOAD_STORE_TEST_DIR, 1024);
+    writeFile(DOWNLOAD_STORE_TEST_OUTPUT_1, "Hello World!");
+
+    EXPECT_TRUE(store.store("http://localhost/file", "v1", DOWNLOAD_STORE_TEST_OUTPUT_1));
+    EXPECT_TRUE(store.fetch("http://localhost/file", "v1", DOWNLOAD_STORE_TEST_OUTPUT_2));
+
+    EXPECT_EQ(readFile(DOWNLOAD_STORE_TEST_OUTPUT_2), "Hello World!");
+    // The outputs never share their inode with the entry.
+    EXPECT_EQ(std::filesystem::hard_link_count(DOWNLOAD_STORE_TEST_OUTPUT_1), 1);
+    EXPECT_EQ(std::filesystem::hard_link_count(DOWNLOAD_STORE_TEST_OUTPUT_2), 1);
+}
+
+/**
+ * @brief Test that modifying a fetched output in place doesn't change the entry, and that a fetch doesn't change the
+ * modification time of the outputs.
+ */
+TEST_F(DownloadStoreTest, FetchedOutputIsIndependent)
+{
+    DownloadStore store(DOWNLOAD_STORE_TEST_DIR, 1024);
+    writeFile(DOWNLOAD_STORE_TEST_OUTPUT_1, "Hello World!");
+    EXPECT_TRUE(store.store("http://localhost/file", "v1", DOWNLOAD_STORE_TEST_OUTPUT_1));
+
+    const auto lastWrite {std::filesystem::file_time_type::clock::now() - std::chrono::hours(1)};
+    std::filesystem::last_write_time(DOWNLOAD_STORE_TEST_OUTPUT_1, lastWrite);
+    EXPECT_TRUE(store.fetch("http://localhost/file", "v1", DOWNLOAD_STORE_TEST_OUTPUT_2));
+    EXPECT_EQ(std::filesystem::last_write_time(DOWNLOAD_STORE_TEST_OUTPUT_1), lastWrite);
+
+    {
+        std::ofstream file(DOWNLOAD_STORE_TEST_OUTPUT_2, std::ios::binary | std::ios::app);
+        file << " Appended";
+    }
+    EXPECT_EQ(readFile(store.entryPath("http://localhost/file", "v1")), "Hello World!");
+    EXPECT_TRUE(store.fetch("http://localhost/file", "v1", DOWNLOAD_STORE_TEST_OUTPUT_1));
+    EXPECT_EQ(readFile(DOWNLOAD_STORE_TEST_OUTPUT_1), "Hello World!");
+}
+
+/**
+ * @brief Test that a fetch replaces an existing output file.
+ */
+TEST_F(DownloadStoreTest, FetchReplacesOutput)
+{
+    DownloadStore store(DOWNLOAD_STORE_TEST_DIR, 1024);
+    writeFile(DOWNLOAD_STORE_TEST_OUTPUT_1, "Hello World!");
+    writeFile(DOWNLOAD_STORE_TEST_OUTPUT_2, "Old content");
+
+    EXPECT_TRUE(store.store("http://localhost/file", "v1", DOWNLOAD_STORE_TEST_OUTPUT_1));
+    EXPECT_TRUE(store.fetch("http://localhost/file", "v1", DOWNLOAD_STORE_TEST_OUTPUT_2));
+
+    EXPECT_EQ(readFile(DOWNLOAD_STORE_TEST_OUTPUT_2), "Hello World!");
+}
+
+/**
+ * @brief Test that the validator is part of the entry key.
+ */
+TEST_F(DownloadStoreTest, DifferentValidator)
+{
+    DownloadStore store(DOWNLOAD_STORE_TEST_DIR, 1024);
+    writeFile(DOWNLOAD_STORE_TEST_OUTPUT_1, "Hello World!");
+
+    EXPECT_TRUE(store.store("http://localhost/file", "v1", DOWNLOAD_STORE_TEST_OUTPUT_1));
+
+    EXPECT_NE(store.entryPath("http://localhost/file", "v1"), store.entryPath("http://localhost/file", "v2"));
+    EXPECT_FALSE(store.fetch("http://localhost/file", "v2", DOWNLOAD_STORE_TEST_OUTPUT_2));
+    EXPECT_FALSE(store.fetch("http://localhost/other", "v1", DOWNLOAD_STORE_TEST_OUTPUT_2));
+}
+
+/**
+ * @brief Test that the least recently used entries are removed when the store is full.
+ */
+TEST_F(DownloadStoreTest, GarbageCollection)
+{
+    DownloadStore store(DOWNLOAD_STORE_TEST_DIR, 20);
+
+    for (const auto& version : {"v1", "v2", "v3"})
+    {
+        std::filesystem::remove(DOWNLOAD_STORE_TEST_OUTPUT_1);
+        writeFile(DOWNLOAD_STORE_TEST_OUTPUT_1, "0123456789");
+        EXPECT_TRUE(store.store("http://localhost/file", version, DOWNLOAD_STORE_TEST_OUTPUT_1));
+
+        if (std::string(version) == "v1")
+        {
+            auto sidecar {store.entryPath("http://localhost/file", version)};
+            sidecar += DOWNLOAD_STORE_USE_SUFFIX;
+            std::filesystem::last_write_time(sidecar,
+                                             std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+        }
+    }
+
+    EXPECT_FALSE(std::filesystem::exists(store.entryPath("http://localhost/file", "v1")));
+    EXPECT_TRUE(std::filesystem::exists(store.entryPath("http://localhost/file", "v2")));
+    EXPECT_TRUE(std::filesystem::exists(store.entryPath("http://localhost/file", "v3")));
+    auto sidecar {store.entryPath("http://localhost/file", "v1")};
+    sidecar += DOWNLOAD_STORE_USE_SUFFIX;
+    EXPECT_FALSE(std::filesystem::exists(sidecar));
+    // Removing an entry doesn't affect the outputs cloned from it.
+    EXPECT_EQ(readFile(DOWNLOAD_STORE_TEST_OUTPUT_1), "0123456789");
+}
@@ -0,0 +1,43 @@
+/*
+ * Wazuh DownloadStore unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _DOWNLOAD_STORE_TEST_HPP
+#define _DOWNLOAD_STORE_TEST_HPP
+
+#include "gtest/gtest.h"
+#include <filesystem>
+
+auto constexpr DOWNLOAD_STORE_TEST_DIR {"/tmp/urlrequest_download_store_test"};
+auto constexpr DOWNLOAD_STORE_TEST_OUTPUT_1 {"/tmp/urlrequest_download_store_test_1.txt"};
+auto constexpr DOWNLOAD_STORE_TEST_OUTPUT_2 {"/tmp/urlrequest_download_store_test_2.txt"};
+
+/**
+ * @brief Runs unit tests for DownloadStore class
+ */
+class DownloadStoreTest : public ::testing::Test
+{
+protected:
+    DownloadStoreTest() = default;
+    ~DownloadStoreTest() override = default;
+
+    /**
+     * @brief Cleans the test environment
+     *
+     */
+    void TearDown() override
+    {
+        std::filesystem::remove_all(DOWNLOAD_STORE_TEST_DIR);
+        std::filesystem::remove(DOWNLOAD_STORE_TEST_OUTPUT_1);
+        std::filesystem::remove(DOWNLOAD_STORE_TEST_OUTPUT_2);
+    }
+};
+
+#endif // _DOWNLOAD_STORE_TEST_HPP
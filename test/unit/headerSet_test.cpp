@@ -0,0 +1,103 @@
+/*
+ * Wazuh HeaderSet unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "headerSet_test.hpp"
+#include <curl/curl.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Test that the compiled list has every header once.
+ */
+TEST_F(HeaderSetTest, CompiledListHasEveryHeaderOnce)
+{
+    const HeaderSet headers {"X-Trace: 1", "Accept: text/plain", "X-Trace: 1"};
+
+    std::vector<std::string> list;
+    for (auto node {headers.list()}; node != nullptr; node = node->next)
+    {
+        list.emplace_back(node->data);
+    }
+
+    EXPECT_EQ(headers.size(), 2);
+    EXPECT_EQ(list, (std::vector<std::string> {"Accept: text/plain", "X-Trace: 1"}));
+}
+
+/**
+ * @brief Test that headers are looked up by name regardless of its case.
+ */
+TEST_F(HeaderSetTest, LookupIsCaseInsensitive)
+{
+    const HeaderSet headers {"Content-Type: application/json", "x-empty;"};
+
+    EXPECT_TRUE(headers.contains("content-type"));
+    EXPECT_EQ(headers.value("CONTENT-TYPE"), "application/json");
+    EXPECT_TRUE(headers.contains("X-Empty"));
+    EXPECT_EQ(headers.value("X-Empty"), "");
+    EXPECT_FALSE(headers.contains("Content"));
+    EXPECT_EQ(headers.value("Accept"), "");
+}
+
+/**
+ * @brief Test that the key of a set doesn't depend on the order of its headers.
+ */
+TEST_F(HeaderSetTest, KeyDoesntDependOnTheOrder)
+{
+    const HeaderSet headers {"B: 2", "A: 1"};
+
+    EXPECT_EQ(headers.key(), "\nA: 1\nB: 2");
+    EXPECT_EQ(headers.key(), HeaderSet({"A: 1", "B: 2"}).key());
+}
+
+/**
+ * @brief Test that an empty set has no list.
+ */
+TEST_F(HeaderSetTest, EmptySet)
+{
+    const HeaderSet headers;
+
+    EXPECT_EQ(headers.size(), 0);
+    EXPECT_EQ(headers.list(), nullptr);
+    EXPECT_EQ(headers.key(), "");
+    EXPECT_FALSE(headers.contains("Accept"));
+}
+
+/**
+ * @brief Test that the default set has the default headers and is compiled once.
+ */
+TEST_F(HeaderSetTest, DefaultHeaders)
+{
+    EXPECT_EQ(HeaderSet::defaults().size(), DEFAULT_HEADERS.size());
+    EXPECT_EQ(HeaderSet::defaults().value("Accept"), "application/json");
+    EXPECT_EQ(HeaderSet::defaults().list(), HeaderSet::defaults().list());
+}
+
+/**
+ * @brief Test that the copies of a set share its compiled list.
+ */
+TEST_F(HeaderSetTest, CopiesShareTheCompiledList)
+{
+    const HeaderSet headers {"Accept: text/plain"};
+    const auto copy {headers};
+
+    EXPECT_EQ(copy.list(), headers.list());
+}
+
+/**
+ * @brief Test that the name of a header is extracted without the separator and the trailing spaces.
+ */
+TEST_F(HeaderSetTest, HeaderName)
+{
+    EXPECT_EQ(HeaderSet::name("Accept: text/plain"), "Accept");
+    EXPECT_EQ(HeaderSet::name("Accept :text/plain"), "Accept");
+    EXPECT_EQ(HeaderSet::name("X-Empty;"), "X-Empty");
+    EXPECT_EQ(HeaderSet::name("Invalid"), "Invalid");
+}
@@ -0,0 +1,28 @@
+/*
+ * Wazuh HeaderSet unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _HEADER_SET_TEST_HPP
+#define _HEADER_SET_TEST_HPP
+
+#include "IURLRequest.hpp"
+#include "gtest/gtest.h"
+
+/**
+ * @brief Runs unit tests for HeaderSet class
+ */
+class HeaderSetTest : public ::testing::Test
+{
+protected:
+    HeaderSetTest() = default;
+    ~HeaderSetTest() override = default;
+};
+
+#endif // _HEADER_SET_TEST_HPP
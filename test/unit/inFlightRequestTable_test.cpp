@@ -0,0 +1,205 @@
+/*
+ * Wazuh InFlightRequestTable unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "inFlightRequestTable_test.hpp"
+#include "inFlightRequests.hpp"
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief Test that a request is listed while it's performed.
+ */
+TEST_F(InFlightRequestTableTest, ListsTheRequestsPerformed)
+{
+    {
+        InFlightRequestTable::Entry entry {"POST", "http://localhost:44441/", CurlHandlerTypeEnum::MULTI};
+        entry.progress(12, 17);
+
+        std::vector<InFlightRequest> requests;
+        std::string method;
+        std::string url;
+        InFlightRequestTable::instance().read(
+            [&](const InFlightRequest& request)
+            {
+                requests.push_back(request);
+                method = request.method;
+                url = request.url;
+            });
+
+        ASSERT_EQ(requests.size(), 1);
+        EXPECT_EQ(method, "POST");
+        EXPECT_EQ(url, "http://localhost:44441/");
+        EXPECT_EQ(requests[0].handlerType, CurlHandlerTypeEnum::MULTI);
+        EXPECT_EQ(requests[0].threadId, gettid());
+        EXPECT_GT(requests[0].start.count(), 0);
+        EXPECT_EQ(requests[0].bytesReceived, 12);
+        EXPECT_EQ(requests[0].bytesSent, 17);
+    }
+
+    EXPECT_TRUE(urls().empty());
+}
+
+/**
+ * @brief Test that the URL of a request can be set once it's known, and only once.
+ */
+TEST_F(InFlightRequestTableTest, SetsTheUrlOnce)
+{
+    InFlightRequestTable::Entry entry {"", "", CurlHandlerTypeEnum::SINGLE};
+    EXPECT_TRUE(entry.needsUrl());
+    EXPECT_EQ(urls(), std::vector<std::string>({""}));
+
+    entry.url("http://localhost:44441/");
+    EXPECT_FALSE(entry.needsUrl());
+    entry.url("http://localhost:44441/moved");
+    EXPECT_EQ(urls(), std::vector<std::string>({"http://localhost:44441/"}));
+}
+
+/**
+ * @brief Test that the query of a URL isn't kept, and that a long URL isn't cut in the middle of a UTF-8 character.
+ */
+TEST_F(InFlightRequestTableTest, KeepsTheUrlWithoutItsQuery)
+{
+    {
+        const InFlightRequestTable::Entry entry {
+            "GET", "http://localhost:44441/path?token=secret#fragment", CurlHandlerTypeEnum::SINGLE};
+        EXPECT_EQ(urls(), std::vector<std::string>({"http://localhost:44441/path"}));
+    }
+
+    // The 2-byte character starts at the last byte of the URL.
+    const std::string prefix(IN_FLIGHT_URL_WORDS * sizeof(uint64_t) - 1, 'a');
+    InFlightRequestTable::Entry entry {"GET", "", CurlHandlerTypeEnum::SINGLE};
+    entry.url(prefix + "\u00e9?token=secret");
+    EXPECT_EQ(urls(), std::vector<std::string>({prefix}));
+}
+
+/**
+ * @brief Test that the tracking of the requests is switched on and off.
+ */
+TEST_F(InFlightRequestTableTest, EnableAndDisable)
+{
+    EXPECT_FALSE(InFlightRequests::enabled());
+    InFlightRequests::enable();
+    EXPECT_TRUE(InFlightRequestTable::enabled());
+    InFlightRequests::disable();
+    EXPECT_FALSE(InFlightRequests::enabled());
+}
+
+/**
+ * @brief Test that the requests started while the table is full are only counted.
+ */
+TEST_F(InFlightRequestTableTest, FullTable)
+{
+    const auto untracked {InFlightRequestTable::instance().untracked()};
+    std::vector<std::unique_ptr<InFlightRequestTable::Entry>> entries;
+    for (size_t i = 0; i < IN_FLIGHT_CAPACITY + 1; ++i)
+    {
+        entries.push_back(std::make_unique<InFlightRequestTable::Entry>("GET", "", CurlHandlerTypeEnum::SINGLE));
+    }
+
+    EXPECT_EQ(urls().size(), IN_FLIGHT_CAPACITY);
+    EXPECT_EQ(InFlightRequestTable::instance().untracked(), untracked + 1);
+    EXPECT_FALSE(entries.back()->needsUrl());
+
+    entries.clear();
+    EXPECT_TRUE(urls().empty());
+}
+
+/**
+ * @brief Test that the requests of several threads are listed.
+ */
+TEST_F(InFlightRequestTableTest, SeveralThreads)
+{
+    std::atomic<bool> done {false};
+    std::atomic<int> started {0};
+    std::vector<std::thread> threads;
+    for (auto i {0}; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                const InFlightRequestTable::Entry entry {"GET", "http://localhost:44441/", CurlHandlerTypeEnum::SINGLE};
+                ++started;
+                while (!done)
+                {
+                    std::this_thread::sleep_for(1ms);
+                }
+            });
+    }
+    while (started < 4)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    EXPECT_EQ(urls().size(), 4);
+    done = true;
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_TRUE(urls().empty());
+}
+
+/**
+ * @brief Test that the requests are exported as JSON, from the oldest one.
+ */
+TEST_F(InFlightRequestTableTest, ExportJson)
+{
+    const InFlightRequestTable::Entry first {"GET", "http://localhost:44441/first", CurlHandlerTypeEnum::SINGLE};
+    std::this_thread::sleep_for(1ms);
+    const InFlightRequestTable::Entry second {
+        "PUT", "http://localhost:44441/second", CurlHandlerTypeEnum::SHARED_MULTI};
+
+    const auto requests = InFlightRequests::json();
+    ASSERT_EQ(requests.at("requests").size(), 2);
+    const auto& oldest {requests.at("requests").at(0)};
+    EXPECT_EQ(oldest.at("method"), "GET");
+    EXPECT_EQ(oldest.at("url"), "http://localhost:44441/first");
+    EXPECT_EQ(oldest.at("handler"), "single");
+    EXPECT_EQ(oldest.at("thread"), gettid());
+    EXPECT_GE(oldest.at("elapsed_us").get<int64_t>(), 1000);
+    EXPECT_EQ(requests.at("requests").at(1).at("handler"), "shared_multi");
+    EXPECT_TRUE(requests.contains("untracked"));
+}
+
+/**
+ * @brief Test that the requests are written to a file when the process receives the signal.
+ */
+TEST_F(InFlightRequestTableTest, WriteOnSignal)
+{
+    const std::string path {"/tmp/urlrequest_unit_in_flight.json"};
+    std::filesystem::remove(path);
+    InFlightRequests::writeOnSignal(SIGUSR2, path);
+
+    const InFlightRequestTable::Entry entry {"GET", "http://localhost:44441/", CurlHandlerTypeEnum::MULTI};
+    ASSERT_EQ(raise(SIGUSR2), 0);
+    for (auto i {0}; i < 1000 && !std::filesystem::exists(path); ++i)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    ASSERT_TRUE(std::filesystem::exists(path));
+    std::ifstream file {path};
+    const auto requests = nlohmann::json::parse(file);
+    ASSERT_EQ(requests.at("requests").size(), 1);
+    EXPECT_EQ(requests.at("requests").at(0).at("handler"), "multi");
+    EXPECT_TRUE(InFlightRequests::enabled());
+    std::filesystem::remove(path);
+    signal(SIGUSR2, SIG_DFL);
+    InFlightRequests::disable();
+}
@@ -0,0 +1,43 @@
+/*
+ * Wazuh InFlightRequestTable unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _IN_FLIGHT_REQUEST_TABLE_TEST_HPP
+#define _IN_FLIGHT_REQUEST_TABLE_TEST_HPP
+
+#include "inFlightRequestTable.hpp"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Runs unit tests for InFlightRequestTable and InFlightRequests classes
+ */
+class InFlightRequestTableTest : public ::testing::Test
+{
+protected:
+    InFlightRequestTableTest() = default;
+    ~InFlightRequestTableTest() override = default;
+
+    /**
+     * @brief Returns the URLs of the requests being performed.
+     *
+     * @return std::vector<std::string> URLs.
+     */
+    static std::vector<std::string> urls()
+    {
+        std::vector<std::string> result;
+        InFlightRequestTable::instance().read([&result](const InFlightRequest& request)
+                                              { result.emplace_back(request.url); });
+        return result;
+    }
+};
+
+#endif // _IN_FLIGHT_REQUEST_TABLE_TEST_HPP
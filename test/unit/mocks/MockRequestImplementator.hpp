@@ -13,6 +13,7 @@
 #define _MOCKREQUESTIMPLEMENTATOR_HPP
 
 #include "IRequestImplementator.hpp"
+#include "IURLRequest.hpp"
 #include "gmock/gmock.h"
 /**
  * @brief This class is a wrapper to perform requests.
@@ -43,10 +44,26 @@ public:
      * @brief Mock method to get the response.
      */
     MOCK_METHOD(const std::string, response, (), (override));
+    /**
+     * @brief Mock method to take the whole response.
+     */
+    MOCK_METHOD(Response, takeResponse, (), (override));
     /**
      * @brief Mock method to append a header.
      */
     MOCK_METHOD(void, appendHeader, (const std::string& header), (override));
+    /**
+     * @brief Mock method to set a set of headers.
+     */
+    MOCK_METHOD(void, setHeaders, (const HeaderSet& headers), (override));
+    /**
+     * @brief Mock method to get the permanent redirect target.
+     */
+    MOCK_METHOD(const std::string, permanentRedirect, (), (override));
+    /**
+     * @brief Mock method to set the observer of the request.
+     */
+    MOCK_METHOD(void, setObserver, (std::shared_ptr<IRequestObserver> observer), (override));
 };
 
 #endif // _MOCKREQUESTIMPLEMENTATOR_HPP
@@ -0,0 +1,149 @@
+/*
+ * Wazuh ParsedURL unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "parsedURL_test.hpp"
+#include <string>
+
+/**
+ * @brief Test that a URL is split into its components.
+ */
+TEST_F(ParsedURLTest, ParseComponents)
+{
+    const auto parsedUrl {ParsedURL::parse("HTTPS://example.com:8443/api/v1?limit=10")};
+    ASSERT_TRUE(parsedUrl);
+
+    EXPECT_EQ(parsedUrl->scheme(), "https");
+    EXPECT_EQ(parsedUrl->host(), "example.com");
+    EXPECT_EQ(parsedUrl->port(), 8443);
+    EXPECT_EQ(parsedUrl->path(), "/api/v1");
+    EXPECT_EQ(parsedUrl->query(), "limit=10");
+    EXPECT_TRUE(parsedUrl->isHttps());
+    EXPECT_EQ(parsedUrl->url(), "https://example.com:8443/api/v1?limit=10");
+}
+
+/**
+ * @brief Test that the default port of the scheme is used when the URL doesn't set it.
+ */
+TEST_F(ParsedURLTest, ParseDefaultPort)
+{
+    const auto parsedUrl {ParsedURL::parse("http://localhost")};
+    ASSERT_TRUE(parsedUrl);
+
+    EXPECT_EQ(parsedUrl->port(), 80);
+    EXPECT_EQ(parsedUrl->path(), "/");
+    EXPECT_TRUE(parsedUrl->query().empty());
+    EXPECT_FALSE(parsedUrl->isHttps());
+}
+
+/**
+ * @brief Test that invalid URLs aren't parsed, so libcurl reports the error on the request.
+ */
+TEST_F(ParsedURLTest, ParseInvalidUrl)
+{
+    EXPECT_FALSE(ParsedURL::parse(""));
+    EXPECT_FALSE(ParsedURL::parse("http://"));
+    EXPECT_FALSE(ParsedURL::parse("localhost:44441/"));
+}
+
+/**
+ * @brief Test that a query is appended to the existing one.
+ */
+TEST_F(ParsedURLTest, WithQuery)
+{
+    const auto parsedUrl {ParsedURL::parse("http://localhost/search")};
+    ASSERT_TRUE(parsedUrl);
+
+    const auto withQuery {parsedUrl->withQuery("a=1")};
+    ASSERT_TRUE(withQuery);
+    EXPECT_EQ(withQuery->url(), "http://localhost/search?a=1");
+
+    const auto appended {withQuery->withQuery("b=2")};
+    ASSERT_TRUE(appended);
+    EXPECT_EQ(appended->url(), "http://localhost/search?a=1&b=2");
+
+    // The original URL isn't modified.
+    EXPECT_EQ(parsedUrl->url(), "http://localhost/search");
+}
+
+/**
+ * @brief Test the percent-encoding of the query parameters.
+ */
+TEST_F(ParsedURLTest, QueryBuilderEncoding)
+{
+    QueryBuilder query;
+    query.add("q", "a b&c=d/é").add("safe-._~", "AZaz09");
+
+    EXPECT_EQ(query.str(), "q=a%20b%26c%3Dd%2F%C3%A9&safe-._~=AZaz09");
+}
+
+/**
+ * @brief Test that a cleared query builder keeps its buffer.
+ */
+TEST_F(ParsedURLTest, QueryBuilderClearKeepsCapacity)
+{
+    QueryBuilder query {16};
+    query.add("key", std::string(100, 'x'));
+    const auto data {query.str().data()};
+
+    query.clear();
+    EXPECT_TRUE(query.str().empty());
+
+    query.add("key", std::string(100, 'y'));
+    EXPECT_EQ(query.str().data(), data);
+}
+
+/**
+ * @brief Test that an HttpURL is only parsed when requested.
+ */
+TEST_F(ParsedURLTest, HttpURLParsedOnlyWhenRequested)
+{
+    const HttpURL url {"http://localhost:44441/search"};
+    EXPECT_FALSE(url.parsedUrl());
+
+    const auto parsedUrl {HttpURL::parse("http://localhost:44441/search")};
+    ASSERT_TRUE(parsedUrl.parsedUrl());
+    EXPECT_EQ(parsedUrl.url(), url.url());
+
+    // An unparsed base is extended as a string.
+    QueryBuilder query;
+    query.add("name", "john doe");
+    const HttpURL withQuery {url, query};
+    EXPECT_FALSE(withQuery.parsedUrl());
+    EXPECT_EQ(withQuery.url(), "http://localhost:44441/search?name=john%20doe");
+
+    // The query goes before the fragment, as with a parsed base.
+    const HttpURL withFragment {HttpURL("http://localhost:44441/search?a=1#results"), query};
+    EXPECT_EQ(withFragment.url(), "http://localhost:44441/search?a=1&name=john%20doe#results");
+    const HttpURL parsedWithFragment {HttpURL::parse("http://localhost:44441/search?a=1#results"), query};
+    EXPECT_EQ(parsedWithFragment.url(), withFragment.url());
+}
+
+/**
+ * @brief Test the HttpURL built from a parsed URL and a query.
+ */
+TEST_F(ParsedURLTest, HttpURLWithQuery)
+{
+    const auto base {HttpURL::parse("http://localhost:44441/search")};
+    ASSERT_TRUE(base.parsedUrl());
+
+    QueryBuilder query;
+    query.add("name", "john doe");
+    const HttpURL url {base, query};
+
+    ASSERT_TRUE(url.parsedUrl());
+    EXPECT_EQ(url.url(), "http://localhost:44441/search?name=john%20doe");
+    EXPECT_EQ(url.parsedUrl()->port(), 44441);
+
+    // Invalid URLs keep working as strings.
+    const HttpURL invalid {HttpURL::parse("localhost:44441/search?a=1"), query};
+    EXPECT_FALSE(invalid.parsedUrl());
+    EXPECT_EQ(invalid.url(), "localhost:44441/search?a=1&name=john%20doe");
+}
@@ -0,0 +1,29 @@
+/*
+ * Wazuh ParsedURL unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PARSED_URL_TEST_HPP
+#define _PARSED_URL_TEST_HPP
+
+#include "IURLRequest.hpp"
+#include "parsedURL.hpp"
+#include "gtest/gtest.h"
+
+/**
+ * @brief Runs unit tests for ParsedURL and QueryBuilder classes
+ */
+class ParsedURLTest : public ::testing::Test
+{
+protected:
+    ParsedURLTest() = default;
+    ~ParsedURLTest() override = default;
+};
+
+#endif // _PARSED_URL_TEST_HPP
@@ -0,0 +1,153 @@
+/*
+ * Wazuh PermanentRedirectCache unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "permanentRedirectCache_test.hpp"
+#include <fstream>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Test that URLs without a cached redirect are resolved to themselves.
+ */
+TEST_F(PermanentRedirectCacheTest, ResolveMiss)
+{
+    EXPECT_EQ(PermanentRedirectCache().resolve("http://localhost/"), "http://localhost/");
+}
+
+/**
+ * @brief Test that a cached redirect is resolved to its target.
+ */
+TEST_F(PermanentRedirectCacheTest, InsertAndResolve)
+{
+    PermanentRedirectCache cache;
+    cache.insert("http://localhost/", "http://localhost/v1/");
+
+    EXPECT_EQ(cache.resolve("http://localhost/"), "http://localhost/v1/");
+
+    cache.insert("http://localhost/", "http://LOCALHOST:80/v2/");
+    EXPECT_EQ(cache.resolve("http://localhost/"), "http://LOCALHOST:80/v2/");
+}
+
+/**
+ * @brief Test that redirects to another scheme, host or port are cached, and that invalid targets are not.
+ */
+TEST_F(PermanentRedirectCacheTest, CrossOriginCached)
+{
+    PermanentRedirectCache cache;
+    cache.insert("http://localhost/a", "https://localhost/a");
+    cache.insert("http://localhost/b", "http://cdn.localhost/b");
+    cache.insert("http://localhost/c", "http://localhost:8080/c");
+    cache.insert("http://localhost/d", "not a url");
+
+    EXPECT_EQ(cache.resolve("http://localhost/a"), "https://localhost/a");
+    EXPECT_EQ(cache.resolve("http://localhost/b"), "http://cdn.localhost/b");
+    EXPECT_EQ(cache.resolve("http://localhost/c"), "http://localhost:8080/c");
+    EXPECT_EQ(cache.resolve("http://localhost/d"), "http://localhost/d");
+}
+
+/**
+ * @brief Test the origin comparison used to drop the credentials of the requests to a cached target.
+ */
+TEST_F(PermanentRedirectCacheTest, SameOrigin)
+{
+    EXPECT_TRUE(PermanentRedirectCache::sameOrigin("http://localhost/a", "http://LOCALHOST:80/b"));
+    EXPECT_FALSE(PermanentRedirectCache::sameOrigin("http://localhost/a", "https://localhost/a"));
+    EXPECT_FALSE(PermanentRedirectCache::sameOrigin("http://localhost/a", "http://cdn.localhost/a"));
+    EXPECT_FALSE(PermanentRedirectCache::sameOrigin("http://localhost/a", "http://localhost:8080/a"));
+    EXPECT_FALSE(PermanentRedirectCache::sameOrigin("http://localhost/a", "not a url"));
+}
+
+/**
+ * @brief Test that an invalidated redirect is no longer resolved.
+ */
+TEST_F(PermanentRedirectCacheTest, Invalidate)
+{
+    PermanentRedirectCache cache;
+    cache.insert("http://localhost/", "http://localhost/v1/");
+    cache.invalidate("http://localhost/");
+
+    EXPECT_EQ(cache.resolve("http://localhost/"), "http://localhost/");
+}
+
+/**
+ * @brief Test that the number of entries is bounded.
+ */
+TEST_F(PermanentRedirectCacheTest, MaxEntries)
+{
+    PermanentRedirectCache cache;
+    for (size_t i = 0; i <= PERMANENT_REDIRECT_CACHE_MAX_ENTRIES; ++i)
+    {
+        cache.insert("http://localhost/" + std::to_string(i), "http://localhost/v1/" + std::to_string(i));
+    }
+
+    size_t cached {0};
+    for (size_t i = 0; i <= PERMANENT_REDIRECT_CACHE_MAX_ENTRIES; ++i)
+    {
+        const auto url {"http://localhost/" + std::to_string(i)};
+        cached += cache.resolve(url) != url ? 1 : 0;
+    }
+    EXPECT_EQ(cached, PERMANENT_REDIRECT_CACHE_MAX_ENTRIES);
+    // The last redirect is always kept.
+    EXPECT_EQ(cache.resolve("http://localhost/" + std::to_string(PERMANENT_REDIRECT_CACHE_MAX_ENTRIES)),
+              "http://localhost/v1/" + std::to_string(PERMANENT_REDIRECT_CACHE_MAX_ENTRIES));
+}
+
+/**
+ * @brief Test that the redirects are persisted and loaded back.
+ */
+TEST_F(PermanentRedirectCacheTest, Persistence)
+{
+    auto& registry {PermanentRedirectCacheRegistry::instance()};
+    registry.getCache(PERMANENT_REDIRECT_CACHE_TEST_FILE)->insert("http://localhost/", "http://localhost/v1/");
+    ASSERT_TRUE(std::filesystem::exists(PERMANENT_REDIRECT_CACHE_TEST_FILE));
+
+    registry.clear();
+    EXPECT_EQ(registry.getCache()->resolve("http://localhost/"), "http://localhost/");
+    EXPECT_EQ(registry.getCache(PERMANENT_REDIRECT_CACHE_TEST_FILE)->resolve("http://localhost/"),
+              "http://localhost/v1/");
+}
+
+/**
+ * @brief Test that caches persisted in different files are kept apart.
+ */
+TEST_F(PermanentRedirectCacheTest, CachePerPersistenceFile)
+{
+    auto& registry {PermanentRedirectCacheRegistry::instance()};
+    const auto cache {registry.getCache(PERMANENT_REDIRECT_CACHE_TEST_FILE)};
+    cache->insert("http://localhost/", "http://localhost/v1/");
+
+    EXPECT_EQ(cache, registry.getCache(PERMANENT_REDIRECT_CACHE_TEST_FILE));
+    EXPECT_EQ(registry.getCache()->resolve("http://localhost/"), "http://localhost/");
+    EXPECT_EQ(registry.getCache(PERMANENT_REDIRECT_CACHE_TEST_FILE_2)->resolve("http://localhost/"),
+              "http://localhost/");
+    EXPECT_FALSE(std::filesystem::exists(PERMANENT_REDIRECT_CACHE_TEST_FILE_2));
+}
+
+/**
+ * @brief Test that a corrupt persistence file is ignored, and that entries with an invalid target are not loaded.
+ */
+TEST_F(PermanentRedirectCacheTest, CorruptPersistenceFile)
+{
+    std::ofstream(PERMANENT_REDIRECT_CACHE_TEST_FILE) << "{not json";
+
+    std::unique_ptr<PermanentRedirectCache> cache;
+    EXPECT_NO_THROW(cache = std::make_unique<PermanentRedirectCache>(PERMANENT_REDIRECT_CACHE_TEST_FILE));
+    EXPECT_EQ(cache->resolve("http://localhost/"), "http://localhost/");
+
+    // The file is rewritten on the next change.
+    cache->insert("http://localhost/", "http://localhost/v1/");
+    EXPECT_EQ(PermanentRedirectCache(PERMANENT_REDIRECT_CACHE_TEST_FILE).resolve("http://localhost/"),
+              "http://localhost/v1/");
+
+    std::ofstream(PERMANENT_REDIRECT_CACHE_TEST_FILE) << R"({"http://localhost/": "not a url"})";
+    EXPECT_EQ(PermanentRedirectCache(PERMANENT_REDIRECT_CACHE_TEST_FILE).resolve("http://localhost/"),
+              "http://localhost/");
+}
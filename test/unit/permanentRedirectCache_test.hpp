@@ -0,0 +1,43 @@
+/*
+ * Wazuh PermanentRedirectCache unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PERMANENT_REDIRECT_CACHE_TEST_HPP
+#define _PERMANENT_REDIRECT_CACHE_TEST_HPP
+
+#include "permanentRedirectCache.hpp"
+#include "gtest/gtest.h"
+#include <filesystem>
+
+auto constexpr PERMANENT_REDIRECT_CACHE_TEST_FILE {"/tmp/urlrequest_permanent_redirect_cache_test.json"};
+auto constexpr PERMANENT_REDIRECT_CACHE_TEST_FILE_2 {"/tmp/urlrequest_permanent_redirect_cache_test_2.json"};
+
+/**
+ * @brief Runs unit tests for PermanentRedirectCache class
+ */
+class PermanentRedirectCacheTest : public ::testing::Test
+{
+protected:
+    PermanentRedirectCacheTest() = default;
+    ~PermanentRedirectCacheTest() override = default;
+
+    /**
+     * @brief Cleans the test environment
+     *
+     */
+    void TearDown() override
+    {
+        PermanentRedirectCacheRegistry::instance().clear();
+        std::filesystem::remove(PERMANENT_REDIRECT_CACHE_TEST_FILE);
+        std::filesystem::remove(PERMANENT_REDIRECT_CACHE_TEST_FILE_2);
+    }
+};
+
+#endif // _PERMANENT_REDIRECT_CACHE_TEST_HPP
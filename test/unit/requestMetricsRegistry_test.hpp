@@ -0,0 +1,37 @@
+/*
+ * Wazuh RequestMetricsRegistry unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _REQUEST_METRICS_REGISTRY_TEST_HPP
+#define _REQUEST_METRICS_REGISTRY_TEST_HPP
+
+#include "requestMetrics.hpp"
+#include "requestMetricsRegistry.hpp"
+#include "gtest/gtest.h"
+
+/**
+ * @brief Runs unit tests for RequestMetricsRegistry and RequestMetrics classes
+ */
+class RequestMetricsRegistryTest : public ::testing::Test
+{
+protected:
+    RequestMetricsRegistryTest() = default;
+    ~RequestMetricsRegistryTest() override = default;
+
+    /**
+     * @brief Starts each test with the metrics set to zero.
+     */
+    void SetUp() override
+    {
+        RequestMetrics::reset();
+    }
+};
+
+#endif // _REQUEST_METRICS_REGISTRY_TEST_HPP
@@ -0,0 +1,47 @@
+/*
+ * Wazuh IRequestObserver unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "requestObserver_test.hpp"
+#include <memory>
+
+/**
+ * @brief Test that the global observer is set and removed.
+ */
+TEST_F(RequestObserverTest, GlobalObserver)
+{
+    EXPECT_EQ(IRequestObserver::global(), nullptr);
+
+    const auto observer {std::make_shared<IRequestObserver>()};
+    IRequestObserver::setGlobal(observer);
+    EXPECT_EQ(IRequestObserver::global(), observer);
+
+    IRequestObserver::setGlobal(nullptr);
+    EXPECT_EQ(IRequestObserver::global(), nullptr);
+}
+
+/**
+ * @brief Test that the hooks of the observer do nothing by default.
+ */
+TEST_F(RequestObserverTest, HooksDoNothingByDefault)
+{
+    IRequestObserver observer;
+    const RequestEvent event {.id = 1, .method = "GET", .url = "http://localhost/"};
+
+    EXPECT_NO_THROW({
+        observer.onStart(event);
+        observer.onDnsDone(event);
+        observer.onConnected(event);
+        observer.onTlsDone(event);
+        observer.onFirstByte(event);
+        observer.onComplete(event, 200, {});
+        observer.onError(event, "Error", 0);
+    });
+}
@@ -0,0 +1,36 @@
+/*
+ * Wazuh TransferObserver unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _REQUEST_OBSERVER_TEST_HPP
+#define _REQUEST_OBSERVER_TEST_HPP
+
+#include "IURLRequest.hpp"
+#include "gtest/gtest.h"
+
+/**
+ * @brief Runs unit tests for IRequestObserver class
+ */
+class RequestObserverTest : public ::testing::Test
+{
+protected:
+    RequestObserverTest() = default;
+    ~RequestObserverTest() override = default;
+
+    /**
+     * @brief Removes the global observer set by the test.
+     */
+    void TearDown() override
+    {
+        IRequestObserver::setGlobal(nullptr);
+    }
+};
+
+#endif // _REQUEST_OBSERVER_TEST_HPP
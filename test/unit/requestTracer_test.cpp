@@ -0,0 +1,237 @@
+/*
+ * Wazuh RequestTracer unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "requestTracer_test.hpp"
+#include "requestTrace.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief Test that nothing is recorded while the tracer is disabled.
+ */
+TEST_F(RequestTracerTest, DisabledRecordsNothing)
+{
+    RequestTracer::instance().enable();
+    RequestTracer::instance().disable();
+    EXPECT_FALSE(RequestTracer::enabled());
+
+    {
+        const RequestTracer::TraceSpan span {"span", "test"};
+    }
+    RequestTracer::callback([]() {});
+
+    EXPECT_TRUE(names().empty());
+}
+
+/**
+ * @brief Test that a capacity of zero is rejected.
+ */
+TEST_F(RequestTracerTest, ZeroCapacity)
+{
+    EXPECT_THROW(RequestTracer::instance().enable(0), std::invalid_argument);
+}
+
+/**
+ * @brief Test that a span is recorded with its result.
+ */
+TEST_F(RequestTracerTest, TraceSpan)
+{
+    RequestTracer::instance().enable();
+    {
+        RequestTracer::TraceSpan span {"handler cache lookup", "handler cache"};
+        span.result("hit");
+    }
+
+    std::vector<TraceEvent> events;
+    std::vector<std::string> details;
+    RequestTracer::instance().read(
+        [&](const TraceEvent& event)
+        {
+            events.push_back(event);
+            details.emplace_back(event.detail);
+        });
+
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_STREQ(events[0].name, "handler cache lookup");
+    EXPECT_STREQ(events[0].category, "handler cache");
+    EXPECT_STREQ(events[0].detailName, "result");
+    EXPECT_EQ(details[0], "hit");
+    EXPECT_GT(events[0].threadId, 0);
+}
+
+/**
+ * @brief Test that the newest events are kept once the buffer is full.
+ */
+TEST_F(RequestTracerTest, KeepsTheNewestEvents)
+{
+    RequestTracer::instance().enable(2);
+    for (const auto name : {"first", "second", "third"})
+    {
+        RequestTracer::instance().record({.name = name, .category = "test"});
+    }
+
+    EXPECT_EQ(names(), std::vector<std::string>({"second", "third"}));
+}
+
+/**
+ * @brief Test that the events recorded are dropped.
+ */
+TEST_F(RequestTracerTest, Clear)
+{
+    RequestTracer::instance().enable();
+    RequestTracer::instance().record({.name = "first", .category = "test"});
+    RequestTracer::instance().clear();
+    RequestTracer::instance().record({.name = "second", .category = "test"});
+
+    EXPECT_EQ(names(), std::vector<std::string>({"second"}));
+}
+
+/**
+ * @brief Test that a transfer is recorded with the phases that happened.
+ */
+TEST_F(RequestTracerTest, RecordTransfer)
+{
+    RequestTracer::instance().enable();
+    const auto start {RequestTracer::now() - 1s};
+    TransferMetrics metrics;
+    metrics.nameLookupTime = 10us;
+    metrics.connectTime = 30us;
+    metrics.preTransferTime = 40us;
+    metrics.startTransferTime = 100us;
+    metrics.totalTime = 150us;
+    RequestTracer::instance().recordTransfer(start, "POST", "http://localhost:44441/", 201, metrics);
+
+    std::vector<TraceEvent> events;
+    RequestTracer::instance().read([&events](const TraceEvent& event) { events.push_back(event); });
+
+    ASSERT_EQ(events.size(), 5);
+    EXPECT_STREQ(events[0].name, "POST");
+    EXPECT_STREQ(events[0].category, "transfer");
+    EXPECT_EQ(events[0].status, 201);
+    EXPECT_EQ(events[0].start, start);
+    EXPECT_GE(events[0].duration, 1s);
+
+    const std::vector<std::tuple<std::string, std::chrono::microseconds, std::chrono::microseconds>> phases {
+        {"dns", 0us, 10us}, {"connect", 10us, 20us}, {"wait", 40us, 60us}, {"receive", 100us, 50us}};
+    for (size_t i = 0; i < phases.size(); ++i)
+    {
+        const auto& [name, offset, duration] {phases[i]};
+        EXPECT_EQ(events[i + 1].name, name);
+        EXPECT_STREQ(events[i + 1].category, "phase");
+        EXPECT_EQ(events[i + 1].start, start + offset);
+        EXPECT_EQ(events[i + 1].duration, duration);
+    }
+}
+
+/**
+ * @brief Test that the detail of an event keeps its first bytes.
+ */
+TEST_F(RequestTracerTest, LongDetail)
+{
+    RequestTracer::instance().enable();
+    const std::string url {"http://localhost:44441/" + std::string(100, 'a')};
+    RequestTracer::instance().recordTransfer(RequestTracer::now(), "GET", url, 200, {});
+
+    std::string detail;
+    RequestTracer::instance().read(
+        [&detail](const TraceEvent& event)
+        {
+            if (std::string_view(event.category) == "transfer")
+            {
+                detail = event.detail;
+            }
+        });
+
+    EXPECT_EQ(detail, url.substr(0, TRACE_DETAIL_WORDS * sizeof(uint64_t)));
+}
+
+/**
+ * @brief Test that the detail of an event isn't cut in the middle of a UTF-8 character.
+ */
+TEST_F(RequestTracerTest, LongDetailKeepsWholeCharacters)
+{
+    RequestTracer::instance().enable();
+    // The 3-byte character starts at the last 2 bytes of the detail.
+    const std::string prefix(TRACE_DETAIL_WORDS * sizeof(uint64_t) - 2, 'a');
+    RequestTracer::instance().recordTransfer(RequestTracer::now(), "GET", prefix + "\u20ac/path", 200, {});
+
+    std::string detail;
+    RequestTracer::instance().read(
+        [&detail](const TraceEvent& event)
+        {
+            if (std::string_view(event.category) == "transfer")
+            {
+                detail = event.detail;
+            }
+        });
+
+    EXPECT_EQ(detail, prefix);
+}
+
+/**
+ * @brief Test that a trace with details that aren't valid UTF-8 is written.
+ */
+TEST_F(RequestTracerTest, WriteInvalidUtf8)
+{
+    RequestTrace::enable();
+    RequestTracer::instance().record({.name = "GET",
+                                      .category = "transfer",
+                                      .detailName = "url",
+                                      .detail = "http://localhost:44441/\xff",
+                                      .start = 1000us,
+                                      .duration = 500us});
+
+    const auto path {std::filesystem::temp_directory_path() / "urlrequest_trace_test.json"};
+    ASSERT_NO_THROW(RequestTrace::write(path.string()));
+
+    std::ifstream file {path};
+    const auto trace = nlohmann::json::parse(file);
+    EXPECT_EQ(trace.at("traceEvents").at(0).at("args").at("url"), "http://localhost:44441/\ufffd");
+    std::filesystem::remove(path);
+}
+
+/**
+ * @brief Test that the trace is exported in the Chrome trace event format.
+ */
+TEST_F(RequestTracerTest, ExportJson)
+{
+    RequestTrace::enable();
+    EXPECT_TRUE(RequestTrace::enabled());
+    RequestTracer::instance().record({.name = "GET",
+                                      .category = "transfer",
+                                      .detailName = "url",
+                                      .detail = "http://localhost:44441/",
+                                      .start = 1000us,
+                                      .duration = 500us,
+                                      .status = 200});
+
+    const auto trace = RequestTrace::json();
+    ASSERT_EQ(trace.at("traceEvents").size(), 1);
+    const auto& event {trace.at("traceEvents").at(0)};
+    EXPECT_EQ(event.at("name"), "GET");
+    EXPECT_EQ(event.at("cat"), "transfer");
+    EXPECT_EQ(event.at("ph"), "X");
+    EXPECT_EQ(event.at("ts"), 1000);
+    EXPECT_EQ(event.at("dur"), 500);
+    EXPECT_EQ(event.at("args").at("url"), "http://localhost:44441/");
+    EXPECT_EQ(event.at("args").at("status"), 200);
+    EXPECT_TRUE(event.contains("pid"));
+    EXPECT_TRUE(event.contains("tid"));
+
+    RequestTrace::clear();
+    EXPECT_TRUE(RequestTrace::json().at("traceEvents").empty());
+}
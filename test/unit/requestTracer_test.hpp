@@ -0,0 +1,51 @@
+/*
+ * Wazuh RequestTracer unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _REQUEST_TRACER_TEST_HPP
+#define _REQUEST_TRACER_TEST_HPP
+
+#include "requestTracer.hpp"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Runs unit tests for RequestTracer class
+ */
+class RequestTracerTest : public ::testing::Test
+{
+protected:
+    RequestTracerTest() = default;
+    ~RequestTracerTest() override = default;
+
+    /**
+     * @brief Disables the tracer and drops the events recorded by the test.
+     */
+    void TearDown() override
+    {
+        RequestTracer::instance().disable();
+        RequestTracer::instance().clear();
+    }
+
+    /**
+     * @brief Returns the names of the events recorded.
+     *
+     * @return std::vector<std::string> Names, from the oldest event to the newest.
+     */
+    static std::vector<std::string> names()
+    {
+        std::vector<std::string> result;
+        RequestTracer::instance().read([&result](const TraceEvent& event) { result.emplace_back(event.name); });
+        return result;
+    }
+};
+
+#endif // _REQUEST_TRACER_TEST_HPP
@@ -0,0 +1,114 @@
+/*
+ * Wazuh ResponseHeaders unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "responseHeaders_test.hpp"
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+std::vector<char> headerLines(std::string_view lines)
+{
+    return {lines.begin(), lines.end()};
+}
+} // namespace
+
+/**
+ * @brief Test that the header lines are parsed and the status line is skipped.
+ */
+TEST_F(ResponseHeadersTest, ParsesTheHeaderLines)
+{
+    const ResponseHeaders headers {headerLines("HTTP/1.1 200 OK\r\n"
+                                               "Content-Type: text/plain\r\n"
+                                               "X-Empty:\r\n"
+                                               "Link:   <https://localhost/?page=2>; rel=\"next\"  \r\n"
+                                               "\r\n")};
+
+    EXPECT_EQ(headers.size(), 3);
+    EXPECT_EQ(headers.value("Content-Type"), "text/plain");
+    EXPECT_TRUE(headers.contains("X-Empty"));
+    EXPECT_EQ(headers.value("X-Empty"), "");
+    EXPECT_EQ(headers.value("Link"), "<https://localhost/?page=2>; rel=\"next\"");
+    EXPECT_FALSE(headers.contains("HTTP/1.1 200 OK"));
+}
+
+/**
+ * @brief Test that headers are looked up by name regardless of its case.
+ */
+TEST_F(ResponseHeadersTest, LookupIsCaseInsensitive)
+{
+    const ResponseHeaders headers {headerLines("x-ratelimit-remaining: 42\r\nETag: \"abc\"\r\n")};
+
+    EXPECT_EQ(headers.value("X-RateLimit-Remaining"), "42");
+    EXPECT_EQ(headers.value("etag"), "\"abc\"");
+    EXPECT_FALSE(headers.contains("X-RateLimit"));
+    EXPECT_EQ(headers.value("Missing"), "");
+}
+
+/**
+ * @brief Test that the values of a repeated header keep the order they were received in.
+ */
+TEST_F(ResponseHeadersTest, RepeatedHeaders)
+{
+    const ResponseHeaders headers {headerLines("Set-Cookie: a=1\r\nVary: Accept\r\nset-cookie: b=2\r\n")};
+
+    EXPECT_EQ(headers.value("Set-Cookie"), "a=1");
+    EXPECT_EQ(headers.values("Set-Cookie"), (std::vector<std::string_view> {"a=1", "b=2"}));
+    EXPECT_TRUE(headers.values("Missing").empty());
+}
+
+/**
+ * @brief Test that the headers are iterated sorted by name.
+ */
+TEST_F(ResponseHeadersTest, IteratesSortedByName)
+{
+    const ResponseHeaders headers {headerLines("b: 2\r\nC: 3\r\na: 1\r\n")};
+
+    std::vector<std::string_view> names;
+    for (const auto& [name, value] : headers)
+    {
+        names.push_back(name);
+    }
+
+    EXPECT_EQ(names, (std::vector<std::string_view> {"a", "b", "C"}));
+}
+
+/**
+ * @brief Test that the views of the headers are still valid after the response is moved.
+ */
+TEST_F(ResponseHeadersTest, ViewsSurviveAMove)
+{
+    Response response {
+        200, ResponseHeaders(headerLines("X-Cursor: abc\r\n")), "body", TransferMetrics {.bytesReceived = 4}};
+    const auto cursor {response.headers().value("X-Cursor")};
+
+    const auto moved {std::move(response)};
+
+    EXPECT_EQ(moved.status(), 200);
+    EXPECT_EQ(moved.headers().value("X-Cursor"), "abc");
+    EXPECT_EQ(moved.headers().value("X-Cursor").data(), cursor.data());
+    EXPECT_EQ(moved.body(), "body");
+    EXPECT_EQ(moved.metrics().bytesReceived, 4);
+}
+
+/**
+ * @brief Test an empty set of headers.
+ */
+TEST_F(ResponseHeadersTest, EmptyHeaders)
+{
+    const ResponseHeaders headers;
+
+    EXPECT_EQ(headers.size(), 0);
+    EXPECT_FALSE(headers.contains("Content-Type"));
+    EXPECT_EQ(headers.begin(), headers.end());
+}
@@ -0,0 +1,28 @@
+/*
+ * Wazuh ResponseHeaders unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _RESPONSE_HEADERS_TEST_HPP
+#define _RESPONSE_HEADERS_TEST_HPP
+
+#include "IURLRequest.hpp"
+#include "gtest/gtest.h"
+
+/**
+ * @brief Runs unit tests for ResponseHeaders and Response classes
+ */
+class ResponseHeadersTest : public ::testing::Test
+{
+protected:
+    ResponseHeadersTest() = default;
+    ~ResponseHeadersTest() override = default;
+};
+
+#endif // _RESPONSE_HEADERS_TEST_HPP
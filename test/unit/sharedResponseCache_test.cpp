@@ -0,0 +1,231 @@
+/*
+ * Wazuh SharedResponseCache unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "sharedResponseCache_test.hpp"
+#include "sharedResponseCache.hpp"
+#include <chrono>
+#include <fcntl.h>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief Test that a stored entry is returned by a lookup.
+ */
+TEST_F(SharedResponseCacheTest, PutAndGet)
+{
+    SharedResponseCache cache(SHARED_CACHE_TEST_FILE);
+
+    EXPECT_TRUE(cache.put("http://localhost/", "Hello World!", 10s));
+
+    const auto value {cache.get("http://localhost/")};
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(*value, "Hello World!");
+}
+
+/**
+ * @brief Test that unknown keys are a miss.
+ */
+TEST_F(SharedResponseCacheTest, Miss)
+{
+    SharedResponseCache cache(SHARED_CACHE_TEST_FILE);
+
+    EXPECT_TRUE(cache.put("http://localhost/", "Hello World!", 10s));
+    EXPECT_FALSE(cache.get("http://localhost/other").has_value());
+}
+
+/**
+ * @brief Test that expired entries are not returned.
+ */
+TEST_F(SharedResponseCacheTest, Expiration)
+{
+    SharedResponseCache cache(SHARED_CACHE_TEST_FILE);
+
+    EXPECT_TRUE(cache.put("http://localhost/", "Hello World!", 1ms));
+    std::this_thread::sleep_for(5ms);
+
+    EXPECT_FALSE(cache.get("http://localhost/").has_value());
+}
+
+/**
+ * @brief Test that an entry replaces the previous value of the same key.
+ */
+TEST_F(SharedResponseCacheTest, Overwrite)
+{
+    SharedResponseCache cache(SHARED_CACHE_TEST_FILE);
+
+    EXPECT_TRUE(cache.put("http://localhost/", "first", 10s));
+    EXPECT_TRUE(cache.put("http://localhost/", "second", 10s));
+
+    EXPECT_EQ(cache.get("http://localhost/").value_or(""), "second");
+}
+
+/**
+ * @brief Test that entries bigger than a slot are not stored.
+ */
+TEST_F(SharedResponseCacheTest, EntryTooBig)
+{
+    SharedResponseCache cache(SHARED_CACHE_TEST_FILE, 4, 1024);
+
+    EXPECT_FALSE(cache.put("http://localhost/", std::string(1024, 'x'), 10s));
+    EXPECT_FALSE(cache.get("http://localhost/").has_value());
+}
+
+/**
+ * @brief Test that two mappings of the same file share the entries, as two processes would do.
+ */
+TEST_F(SharedResponseCacheTest, SharedBetweenMappings)
+{
+    SharedResponseCache writer(SHARED_CACHE_TEST_FILE);
+    SharedResponseCache reader(SHARED_CACHE_TEST_FILE, 1, 128);
+
+    EXPECT_EQ(reader.slotCount(), SHARED_CACHE_DEFAULT_SLOT_COUNT);
+    EXPECT_TRUE(writer.put("http://localhost/", "Hello World!", 10s));
+    EXPECT_EQ(reader.get("http://localhost/").value_or(""), "Hello World!");
+}
+
+/**
+ * @brief Test that a file with another format is rejected and disables the cache.
+ */
+TEST_F(SharedResponseCacheTest, IncompatibleFile)
+{
+    {
+        std::ofstream file(SHARED_CACHE_TEST_FILE);
+        file << "not a cache file";
+    }
+
+    EXPECT_THROW(SharedResponseCache {SHARED_CACHE_TEST_FILE}, std::runtime_error);
+    EXPECT_EQ(SharedResponseCacheRegistry::instance().getCache(SHARED_CACHE_TEST_FILE), nullptr);
+}
+
+/**
+ * @brief Test that files other users could have planted or written are rejected.
+ */
+TEST_F(SharedResponseCacheTest, UnsafeFileRejected)
+{
+    {
+        SharedResponseCache cache(SHARED_CACHE_TEST_FILE);
+    }
+    std::filesystem::permissions(SHARED_CACHE_TEST_FILE,
+                                 std::filesystem::perms::group_write | std::filesystem::perms::others_write,
+                                 std::filesystem::perm_options::add);
+    EXPECT_THROW(SharedResponseCache {SHARED_CACHE_TEST_FILE}, std::runtime_error);
+
+    std::filesystem::remove(SHARED_CACHE_TEST_FILE);
+    std::filesystem::create_symlink("/tmp/urlrequest_shared_cache_test_target", SHARED_CACHE_TEST_FILE);
+    EXPECT_THROW(SharedResponseCache {SHARED_CACHE_TEST_FILE}, std::runtime_error);
+    EXPECT_FALSE(std::filesystem::exists("/tmp/urlrequest_shared_cache_test_target"));
+}
+
+/**
+ * @brief Test that a slot left owned by a dead writer is taken over once the writer timeout elapses, and not before.
+ */
+TEST_F(SharedResponseCacheTest, DeadWriterSlotRecovered)
+{
+    SharedResponseCache cache(SHARED_CACHE_TEST_FILE, 1, 256);
+
+    // Leave the only slot as a writer that died holding it would: odd sequence and an owner.
+    const auto fd {open(SHARED_CACHE_TEST_FILE, O_RDWR)};
+    ASSERT_GE(fd, 0);
+    const uint32_t sequence {1};
+    auto owner {std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch())
+                    .count()};
+    const auto ownerOffset {sizeof(SharedCacheHeader) + sizeof(SharedCacheSlot) - sizeof(owner)};
+    ASSERT_EQ(pwrite(fd, &sequence, sizeof(sequence), sizeof(SharedCacheHeader)),
+              static_cast<ssize_t>(sizeof(sequence)));
+    ASSERT_EQ(pwrite(fd, &owner, sizeof(owner), ownerOffset), static_cast<ssize_t>(sizeof(owner)));
+
+    EXPECT_FALSE(cache.put("http://localhost/", "Hello World!", 10s));
+    EXPECT_FALSE(cache.get("http://localhost/").has_value());
+
+    owner -= SHARED_CACHE_WRITER_TIMEOUT;
+    ASSERT_EQ(pwrite(fd, &owner, sizeof(owner), ownerOffset), static_cast<ssize_t>(sizeof(owner)));
+    close(fd);
+
+    EXPECT_TRUE(cache.put("http://localhost/", "Hello World!", 10s));
+    EXPECT_EQ(cache.get("http://localhost/").value_or(""), "Hello World!");
+
+    // The dead writer's odd sequence was replaced, so it can't publish the slot if it comes back.
+    uint32_t published {0};
+    const auto readFd {open(SHARED_CACHE_TEST_FILE, O_RDONLY)};
+    ASSERT_GE(readFd, 0);
+    ASSERT_EQ(pread(readFd, &published, sizeof(published), sizeof(SharedCacheHeader)),
+              static_cast<ssize_t>(sizeof(published)));
+    close(readFd);
+    EXPECT_EQ(published, sequence + 3);
+}
+
+/**
+ * @brief Test that a slot whose content was changed after it was published, as the late stores of a writer that lost
+ * the slot would, isn't returned.
+ */
+TEST_F(SharedResponseCacheTest, TornSlotRejected)
+{
+    SharedResponseCache cache(SHARED_CACHE_TEST_FILE, 1, 256);
+    ASSERT_TRUE(cache.put("http://localhost/", "Hello World!", 10s));
+
+    const auto fd {open(SHARED_CACHE_TEST_FILE, O_RDWR)};
+    ASSERT_GE(fd, 0);
+    const uint64_t word {0x6161616161616161ULL};
+    const auto valueOffset {sizeof(SharedCacheHeader) + sizeof(SharedCacheSlot) + 2 * sizeof(word)};
+    ASSERT_EQ(pwrite(fd, &word, sizeof(word), valueOffset), static_cast<ssize_t>(sizeof(word)));
+    close(fd);
+
+    EXPECT_FALSE(cache.get("http://localhost/").has_value());
+}
+
+/**
+ * @brief Test that the registry maps every file once.
+ */
+TEST_F(SharedResponseCacheTest, RegistryReusesMapping)
+{
+    const auto cache {SharedResponseCacheRegistry::instance().getCache(SHARED_CACHE_TEST_FILE)};
+
+    ASSERT_NE(cache, nullptr);
+    EXPECT_EQ(cache, SharedResponseCacheRegistry::instance().getCache(SHARED_CACHE_TEST_FILE));
+}
+
+/**
+ * @brief Test concurrent writers and readers on the same key. Readers must never see a torn value.
+ */
+TEST_F(SharedResponseCacheTest, ConcurrentAccess)
+{
+    SharedResponseCache cache(SHARED_CACHE_TEST_FILE);
+    const std::string first(4096, 'a');
+    const std::string second(4096, 'b');
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [&, i]()
+            {
+                for (int j = 0; j < 1000; ++j)
+                {
+                    cache.put("http://localhost/", i % 2 ? first : second, 10s);
+                    const auto value {cache.get("http://localhost/")};
+                    if (value)
+                    {
+                        EXPECT_TRUE(*value == first || *value == second);
+                    }
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
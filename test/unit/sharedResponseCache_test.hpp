@@ -0,0 +1,50 @@
+/*
+ * Wazuh SharedResponseCache unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _SHARED_RESPONSE_CACHE_TEST_HPP
+#define _SHARED_RESPONSE_CACHE_TEST_HPP
+
+#include "sharedResponseCache.hpp"
+#include "gtest/gtest.h"
+#include <filesystem>
+
+auto constexpr SHARED_CACHE_TEST_FILE {"/tmp/urlrequest_shared_cache_test"};
+
+/**
+ * @brief Runs unit tests for SharedResponseCache class
+ */
+class SharedResponseCacheTest : public ::testing::Test
+{
+protected:
+    SharedResponseCacheTest() = default;
+    ~SharedResponseCacheTest() override = default;
+
+    /**
+     * @brief Removes the cache file left by a previous execution.
+     *
+     */
+    void SetUp() override
+    {
+        std::filesystem::remove(SHARED_CACHE_TEST_FILE);
+    }
+
+    /**
+     * @brief Cleans the test environment
+     *
+     */
+    void TearDown() override
+    {
+        SharedResponseCacheRegistry::instance().clear();
+        std::filesystem::remove(SHARED_CACHE_TEST_FILE);
+    }
+};
+
+#endif // _SHARED_RESPONSE_CACHE_TEST_HPP
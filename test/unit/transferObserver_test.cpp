@@ -0,0 +1,65 @@
+/*
+ * Wazuh TransferObserver unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "transferObserver_test.hpp"
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Test that the observer receives the notified transfers.
+ */
+TEST_F(TransferObserverTest, ObserverIsNotified)
+{
+    std::string observedUrl;
+    long observedStatus {0};
+    std::chrono::microseconds observedTime {0};
+    TransferObserver::set(
+        [&](std::string_view url, const long status, const TransferMetrics& metrics)
+        {
+            observedUrl = url;
+            observedStatus = status;
+            observedTime = metrics.totalTime;
+        });
+
+    EXPECT_TRUE(TransferObserver::enabled());
+    TransferObserver::notify("http://localhost/", 204, TransferMetrics {.totalTime = std::chrono::microseconds(42)});
+
+    EXPECT_EQ(observedUrl, "http://localhost/");
+    EXPECT_EQ(observedStatus, 204);
+    EXPECT_EQ(observedTime.count(), 42);
+}
+
+/**
+ * @brief Test that a removed observer isn't called.
+ */
+TEST_F(TransferObserverTest, RemovedObserverIsntCalled)
+{
+    auto calls {0};
+    TransferObserver::set([&calls](std::string_view, long, const TransferMetrics&) { ++calls; });
+    TransferObserver::set({});
+
+    EXPECT_FALSE(TransferObserver::enabled());
+    TransferObserver::notify("http://localhost/", 200, {});
+
+    EXPECT_EQ(calls, 0);
+}
+
+/**
+ * @brief Test that the exceptions thrown by the observer don't reach the transfer.
+ */
+TEST_F(TransferObserverTest, ExceptionsAreIgnored)
+{
+    TransferObserver::set([](std::string_view, long, const TransferMetrics&)
+                          { throw std::runtime_error("Observer failure"); });
+
+    EXPECT_NO_THROW(TransferObserver::notify("http://localhost/", 200, {}));
+}
@@ -0,0 +1,36 @@
+/*
+ * Wazuh TransferObserver unit tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _TRANSFER_OBSERVER_TEST_HPP
+#define _TRANSFER_OBSERVER_TEST_HPP
+
+#include "IURLRequest.hpp"
+#include "gtest/gtest.h"
+
+/**
+ * @brief Runs unit tests for TransferObserver class
+ */
+class TransferObserverTest : public ::testing::Test
+{
+protected:
+    TransferObserverTest() = default;
+    ~TransferObserverTest() override = default;
+
+    /**
+     * @brief Removes the observer set by the test.
+     */
+    void TearDown() override
+    {
+        TransferObserver::set({});
+    }
+};
+
+#endif // _TRANSFER_OBSERVER_TEST_HPP
@@ -31,7 +31,13 @@ constexpr OPTION_REQUEST_TYPE optVerifyPeer {OPT_VERIFYPEER};
 constexpr OPTION_REQUEST_TYPE optSslCert {OPT_SSL_CERT};
 constexpr OPTION_REQUEST_TYPE optSslKey {OPT_SSL_KEY};
 constexpr OPTION_REQUEST_TYPE optBasicAuth {OPT_BASIC_AUTH};
-constexpr long zero {0};
+constexpr OPTION_REQUEST_TYPE optHsts {OPT_HSTS};
+constexpr OPTION_REQUEST_TYPE optAltSvc {OPT_ALTSVC};
+constexpr OPTION_REQUEST_TYPE optHttpVersion {OPT_HTTP_VERSION};
+constexpr OPTION_REQUEST_TYPE optCurlu {OPT_CURLU};
+constexpr OPTION_REQUEST_TYPE optNoBody {OPT_NOBODY};
+constexpr OPTION_REQUEST_TYPE optFailOnError {OPT_FAILONERROR};
+constexpr void* defaultWriteFunction {nullptr};
 
 /**
  * @brief This test checks the HTTP request.
@@ -43,13 +49,67 @@ TEST_F(UrlRequestUnitTest, GetFileHttp)
     EXPECT_CALL(*request, setOption(optUrl, "http://www.wazuh.com/")).Times(1);
     EXPECT_CALL(*request, setOption(optCustomRequest, "GET")).Times(1);
     EXPECT_CALL(*request, setOption(optWriteData, SafeMatcherCast<void*>(_))).Times(1);
-    EXPECT_CALL(*request, setOption(optWriteFunction, zero)).Times(1);
+    EXPECT_CALL(*request, setOption(optWriteFunction, defaultWriteFunction)).Times(1);
     EXPECT_CALL(*request, execute()).Times(1);
     EXPECT_CALL(*request, appendHeader(_)).Times(0);
 
     GetRequest::builder(request).url("http://www.wazuh.com/").outputFile("/tmp/hello_world.html").execute();
 }
 
+/**
+ * @brief This test checks that a compiled set of headers is given to the request implementator as is.
+ */
+TEST_F(UrlRequestUnitTest, GetWithAHeaderSet)
+{
+    auto request {std::make_shared<RequestWrapper>()};
+    const HeaderSet headers {"Accept: text/plain"};
+
+    EXPECT_CALL(*request, setOption(optUrl, "http://www.wazuh.com/")).Times(1);
+    EXPECT_CALL(*request, setOption(optCustomRequest, "GET")).Times(1);
+    EXPECT_CALL(*request, setHeaders(Property(&HeaderSet::list, headers.list()))).Times(1);
+    EXPECT_CALL(*request, appendHeader("X-Trace: 1")).Times(1);
+    EXPECT_CALL(*request, execute()).Times(1);
+
+    GetRequest::builder(request).url("http://www.wazuh.com/").headers(headers).appendHeader("X-Trace: 1").execute();
+}
+
+/**
+ * @brief This test checks that the whole response is moved out of the request implementator.
+ */
+TEST_F(UrlRequestUnitTest, GetTakingTheResponse)
+{
+    auto request {std::make_shared<RequestWrapper>()};
+
+    EXPECT_CALL(*request, setOption(optUrl, "http://www.wazuh.com/")).Times(1);
+    EXPECT_CALL(*request, setOption(optCustomRequest, "GET")).Times(1);
+    EXPECT_CALL(*request, execute()).Times(1);
+    EXPECT_CALL(*request, takeResponse())
+        .WillOnce(Return(ByMove(Response(204, ResponseHeaders(), "", TransferMetrics {.redirectCount = 1}))));
+
+    auto req {GetRequest::builder(request)};
+    req.url("http://www.wazuh.com/").execute();
+    const auto response {req.takeResponse()};
+
+    EXPECT_EQ(response.status(), 204);
+    EXPECT_EQ(response.metrics().redirectCount, 1);
+}
+
+/**
+ * @brief This test checks that the observer of the request is given to the request implementator.
+ */
+TEST_F(UrlRequestUnitTest, GetWithAnObserver)
+{
+    auto request {std::make_shared<RequestWrapper>()};
+    const auto observer {std::make_shared<IRequestObserver>()};
+
+    EXPECT_CALL(*request, setOption(optUrl, "http://www.wazuh.com/")).Times(1);
+    EXPECT_CALL(*request, setOption(optCustomRequest, "GET")).Times(1);
+    EXPECT_CALL(*request, setObserver(observer)).Times(1);
+    EXPECT_CALL(*request, execute()).Times(1);
+
+    GetRequest::builder(request).url("http://www.wazuh.com/").observer(observer).observer(nullptr).execute();
+}
+
 TEST_F(UrlRequestUnitTest, HttpSecureConnection)
 {
     auto request {std::make_shared<RequestWrapper>()};
@@ -65,6 +125,36 @@ TEST_F(UrlRequestUnitTest, HttpSecureConnection)
     GetRequest::builder(request).url("https://localhost:9200/", secureCommunication).execute();
 }
 
+TEST_F(UrlRequestUnitTest, HttpSecureConnectionUsingAParsedUrl)
+{
+    auto request {std::make_shared<RequestWrapper>()};
+    auto secureCommunication = SecureCommunication::builder();
+    secureCommunication.caRootCertificate("root-ca.pem");
+    const auto url {HttpURL::parse("https://localhost:9200/")};
+
+    EXPECT_CALL(*request, setOption(optUrl, An<const std::string&>())).Times(0);
+    EXPECT_CALL(*request, setOption(optCurlu, static_cast<void*>(url.parsedUrl()->handle()))).Times(1);
+    EXPECT_CALL(*request, setOption(optCustomRequest, "GET")).Times(1);
+    EXPECT_CALL(*request, setOption(optCainfo, "root-ca.pem")).Times(1);
+    EXPECT_CALL(*request, setOption(optVerifyPeer, 1L)).Times(1);
+    EXPECT_CALL(*request, execute()).Times(1);
+
+    GetRequest::builder(request).url(url, secureCommunication).execute();
+}
+
+TEST_F(UrlRequestUnitTest, HttpConnectionUsingAnUnparsedUrl)
+{
+    auto request {std::make_shared<RequestWrapper>()};
+    const HttpURL url {"localhost:9200/"};
+
+    EXPECT_CALL(*request, setOption(optUrl, "localhost:9200/")).Times(1);
+    EXPECT_CALL(*request, setOption(optCurlu, An<void*>())).Times(0);
+    EXPECT_CALL(*request, setOption(optCustomRequest, "GET")).Times(1);
+    EXPECT_CALL(*request, execute()).Times(1);
+
+    GetRequest::builder(request).url(url).execute();
+}
+
 TEST_F(UrlRequestUnitTest, HttpSecureConnectionBasicAuth)
 {
     auto request {std::make_shared<RequestWrapper>()};
@@ -130,7 +220,7 @@ TEST_F(UrlRequestUnitTest, GetFileWithUnixSocket)
     EXPECT_CALL(*request, setOption(optUrl, "http://www.wazuh.com/")).Times(1);
     EXPECT_CALL(*request, setOption(optCustomRequest, "GET")).Times(1);
     EXPECT_CALL(*request, setOption(optWriteData, SafeMatcherCast<void*>(_))).Times(1);
-    EXPECT_CALL(*request, setOption(optWriteFunction, zero)).Times(1);
+    EXPECT_CALL(*request, setOption(optWriteFunction, defaultWriteFunction)).Times(1);
     EXPECT_CALL(*request, execute()).Times(1);
     EXPECT_CALL(*request, appendHeader(_)).Times(0);
 
@@ -165,6 +255,106 @@ TEST_F(UrlRequestUnitTest, GetApiRequest)
         .execute();
 }
 
+/**
+ * @brief This test checks the GET request with the HSTS and Alt-Svc caches.
+ */
+TEST_F(UrlRequestUnitTest, GetApiRequestWithProtocolCaches)
+{
+    auto request {std::make_shared<RequestWrapper>()};
+
+    EXPECT_CALL(*request, setOption(optUrl, "http://www.wazuh.com/")).Times(1);
+    EXPECT_CALL(*request, setOption(optCustomRequest, "GET")).Times(1);
+    EXPECT_CALL(*request, setOption(optHsts, "/tmp/hsts.txt")).Times(1);
+    EXPECT_CALL(*request, setOption(optAltSvc, "/tmp/altsvc.txt")).Times(1);
+    EXPECT_CALL(*request, execute()).Times(1);
+
+    GetRequest::builder(request)
+        .url("http://www.wazuh.com/")
+        .hstsCache("/tmp/hsts.txt")
+        .altSvcCache("/tmp/altsvc.txt")
+        .execute();
+}
+
+/**
+ * @brief This test checks that the HSTS and Alt-Svc caches stay disabled without a file.
+ */
+TEST_F(UrlRequestUnitTest, GetApiRequestWithoutProtocolCaches)
+{
+    auto request {std::make_shared<RequestWrapper>()};
+
+    EXPECT_CALL(*request, setOption(optUrl, "http://www.wazuh.com/")).Times(1);
+    EXPECT_CALL(*request, setOption(optCustomRequest, "GET")).Times(1);
+    EXPECT_CALL(*request, setOption(optHsts, An<const std::string&>())).Times(0);
+    EXPECT_CALL(*request, setOption(optAltSvc, An<const std::string&>())).Times(0);
+    EXPECT_CALL(*request, execute()).Times(1);
+
+    GetRequest::builder(request).url("http://www.wazuh.com/").hstsCache("").altSvcCache("").execute();
+}
+
+/**
+ * @brief This test checks the GET request with a given HTTP version.
+ */
+TEST_F(UrlRequestUnitTest, GetApiRequestWithHttpVersion)
+{
+    auto request {std::make_shared<RequestWrapper>()};
+
+    EXPECT_CALL(*request, setOption(optUrl, "http://www.wazuh.com/")).Times(1);
+    EXPECT_CALL(*request, setOption(optCustomRequest, "GET")).Times(1);
+    EXPECT_CALL(*request, setOption(optHttpVersion, static_cast<long>(HttpVersionEnum::HTTP_2_PRIOR_KNOWLEDGE)))
+        .Times(1);
+    EXPECT_CALL(*request, execute()).Times(1);
+
+    GetRequest::builder(request)
+        .url("http://www.wazuh.com/")
+        .httpVersion(HttpVersionEnum::HTTP_2_PRIOR_KNOWLEDGE)
+        .execute();
+}
+
+/**
+ * @brief This test checks that the default HTTP version leaves the option unset.
+ */
+TEST_F(UrlRequestUnitTest, GetApiRequestWithDefaultHttpVersion)
+{
+    auto request {std::make_shared<RequestWrapper>()};
+
+    EXPECT_CALL(*request, setOption(optUrl, "http://www.wazuh.com/")).Times(1);
+    EXPECT_CALL(*request, setOption(optCustomRequest, "GET")).Times(1);
+    EXPECT_CALL(*request, setOption(optHttpVersion, An<long>())).Times(0);
+    EXPECT_CALL(*request, execute()).Times(1);
+
+    GetRequest::builder(request).url("http://www.wazuh.com/").httpVersion(HttpVersionEnum::DEFAULT).execute();
+}
+
+/**
+ * @brief This test checks that the configuration parameters of a request are set on the request implementator.
+ */
+TEST_F(UrlRequestUnitTest, GetApiRequestWithConfigurationParameters)
+{
+    auto request {std::make_shared<RequestWrapper>()};
+    const auto observer {std::make_shared<IRequestObserver>()};
+    const std::string userAgent {"Wazuh-Agent/1.0"};
+    const std::string hstsCachePath {"/tmp/hsts.txt"};
+
+    EXPECT_CALL(*request, setOption(optUrl, "http://www.wazuh.com/")).Times(1);
+    EXPECT_CALL(*request, setOption(optCustomRequest, "GET")).Times(1);
+    EXPECT_CALL(*request, setOption(optTimeout, 1000l)).Times(1);
+    EXPECT_CALL(*request, setOption(optUserAgent, userAgent)).Times(1);
+    EXPECT_CALL(*request, setOption(optHsts, hstsCachePath)).Times(1);
+    EXPECT_CALL(*request, setOption(optAltSvc, An<const std::string&>())).Times(0);
+    EXPECT_CALL(*request, setOption(optHttpVersion, static_cast<long>(HttpVersionEnum::HTTP_1_1))).Times(1);
+    EXPECT_CALL(*request, setObserver(observer)).Times(1);
+    EXPECT_CALL(*request, execute()).Times(1);
+
+    GetRequest::builder(request)
+        .url("http://www.wazuh.com/")
+        .configuration(ConfigurationParameters {.timeout = 1000,
+                                                .userAgent = userAgent,
+                                                .hstsCachePath = hstsCachePath,
+                                                .httpVersion = HttpVersionEnum::HTTP_1_1,
+                                                .observer = observer})
+        .execute();
+}
+
 /**
  * @brief This test checks the API POST request.
  */
@@ -293,6 +483,23 @@ TEST_F(UrlRequestUnitTest, DeleteApiRequest)
         .execute();
 }
 
+/**
+ * @brief This test checks the HEAD request, which has no body and doesn't fail on an error status.
+ */
+TEST_F(UrlRequestUnitTest, HeadRequest)
+{
+    auto request {std::make_shared<RequestWrapper>()};
+
+    EXPECT_CALL(*request, setOption(optUrl, "http://www.wazuh.com/")).Times(1);
+    EXPECT_CALL(*request, setOption(optCustomRequest, "HEAD")).Times(1);
+    EXPECT_CALL(*request, setOption(optNoBody, 1L)).Times(1);
+    EXPECT_CALL(*request, setOption(optFailOnError, TypedEq<long>(0))).Times(1);
+    EXPECT_CALL(*request, setOption(optTimeout, 10)).Times(1);
+    EXPECT_CALL(*request, execute()).Times(1);
+
+    HeadRequest::builder(request).url("http://www.wazuh.com/").timeout(10).execute();
+}
+
 /**
  * @brief This test checks the malformed API DELETE request.
  */